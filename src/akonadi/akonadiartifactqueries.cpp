@@ -26,10 +26,12 @@
 
 #include "akonadicollectionfetchjobinterface.h"
 #include "akonadiitemfetchjobinterface.h"
-#include "akonadimonitorimpl.h"
+#include "akonadilivequeryhelpers.h"
+#include "akonadimonitorinterface.h"
 #include "akonadiserializer.h"
 #include "akonadistorage.h"
 
+#include "utils/dependencymanager.h"
 #include "utils/jobhandler.h"
 
 using namespace Akonadi;
@@ -38,7 +40,7 @@ ArtifactQueries::ArtifactQueries(QObject *parent)
     : QObject(parent),
       m_storage(new Storage),
       m_serializer(new Serializer),
-      m_monitor(new MonitorImpl),
+      m_monitor(Utils::DependencyManager::globalInstance().create<MonitorInterface>()),
       m_fetchContentTypeFilter(StorageInterface::Tasks|StorageInterface::Notes),
       m_ownInterfaces(true)
 {
@@ -87,7 +89,7 @@ ArtifactQueries::ArtifactResult::Ptr ArtifactQueries::findInboxTopLevel() const
             self->m_findInbox = self->createArtifactQuery();
         }
 
-        m_findInbox->setFetchFunction([this] (const ArtifactQuery::AddFunction &add) {
+        m_findInbox->setRangeFetchFunction([this] (const ArtifactQuery::AddRangeFunction &add) {
             CollectionFetchJobInterface *job = m_storage->fetchCollections(Akonadi::Collection::root(),
                                                                            StorageInterface::Recursive,
                                                                            m_fetchContentTypeFilter);
@@ -100,15 +102,12 @@ ArtifactQueries::ArtifactResult::Ptr ArtifactQueries::findInboxTopLevel() const
                         continue;
 
                     ItemFetchJobInterface *job = m_storage->fetchItems(collection);
-                    Utils::JobHandler::install(job->kjob(), [this, job, add, collection] {
-                        if (job->kjob()->error() != KJob::NoError)
-                            return;
-
-                        for (auto item : job->items()) {
+                    job->installItemsReceivedHandler([add, collection] (Akonadi::Item::List items) {
+                        for (auto &item : items) {
                             //We have to set the parent to since we rely on attributes being available in isSelectedCollection
                             item.setParentCollection(collection);
-                            add(item);
                         }
+                        add(items);
                     });
                 }
             });
@@ -127,6 +126,9 @@ ArtifactQueries::ArtifactResult::Ptr ArtifactQueries::findInboxTopLevel() const
                 return Domain::Artifact::Ptr();
             }
         });
+        m_findInbox->setRangeConvertFunction([this] (const Akonadi::Item::List &items) {
+            return m_serializer->createArtifactsFromItems(items);
+        });
 
         m_findInbox->setUpdateFunction([this] (const Akonadi::Item &item, Domain::Artifact::Ptr &artifact) {
             if (auto task = artifact.dynamicCast<Domain::Task>()) {
@@ -149,6 +151,9 @@ ArtifactQueries::ArtifactResult::Ptr ArtifactQueries::findInboxTopLevel() const
         m_findInbox->setRepresentsFunction([this] (const Akonadi::Item &item, const Domain::Artifact::Ptr &artifact) {
             return m_serializer->representsItem(artifact, item);
         });
+        m_findInbox->setKeyFunction([] (const Akonadi::Item &item) {
+            return item.id();
+        });
     }
 
     return m_findInbox->result();
@@ -161,6 +166,8 @@ ArtifactQueries::TagResult::Ptr ArtifactQueries::findTags(Domain::Artifact::Ptr
     return TagResult::Ptr();
 }
 
+// The inbox is the only query here and any item of a selected collection
+// can end up in it, so it is deliberately kept as broadcast.
 void ArtifactQueries::onItemAdded(const Item &item)
 {
     foreach (const ArtifactQuery::Ptr &query, m_artifactQueries)
@@ -188,6 +195,8 @@ void ArtifactQueries::onCollectionSelectionChanged()
 ArtifactQueries::ArtifactQuery::Ptr ArtifactQueries::createArtifactQuery()
 {
     auto query = ArtifactQuery::Ptr::create();
+    LiveQueryHelpers::attachJobOwner(query);
+    query->setBatchingEnabled(true);
     m_artifactQueries << query;
     return query;
 }
@@ -0,0 +1,528 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+
+#include "akonadicache.h"
+
+#include <KJob>
+
+#include "akonadi/akonadiitemfetchjobinterface.h"
+#include "akonadi/akonadimonitorinterface.h"
+#include "utils/jobhandler.h"
+
+using namespace Akonadi;
+
+namespace Akonadi {
+
+class CollectionFetchWaiter;
+
+// A fetch of the items of a collection and the jobs waiting on it
+class SharedCollectionFetch : public QObject
+{
+    Q_OBJECT
+public:
+    SharedCollectionFetch(ItemFetchJobInterface *job, QObject *parent);
+
+    bool isFinished() const { return m_finished; }
+    Item::List receivedItems() const { return m_receivedItems; }
+
+    void addWaiter(CollectionFetchWaiter *waiter);
+    void removeWaiter(CollectionFetchWaiter *waiter);
+
+private slots:
+    void onResult(KJob *job);
+
+private:
+    QPointer<KJob> m_job;
+    QList<QPointer<CollectionFetchWaiter>> m_waiters;
+    Item::List m_receivedItems;
+    bool m_finished;
+};
+
+// What a caller gets when asking for the items of a collection, it
+// belongs to the scope of that caller
+class CollectionFetchWaiter : public KJob, public ItemFetchJobInterface
+{
+    Q_OBJECT
+public:
+    explicit CollectionFetchWaiter(SharedCollectionFetch *fetch)
+        : KJob(),
+          m_fetch(fetch),
+          m_items(fetch->receivedItems()),
+          m_owner(Utils::JobHandler::currentOwner()),
+          m_priority(Utils::JobHandler::currentPriority())
+    {
+        Utils::JobHandler::track(this);
+        m_fetch->addWaiter(this);
+    }
+
+    void start() {}
+
+    Item::List items() const { return m_items; }
+
+    void installItemsReceivedHandler(const ItemsReceivedHandler &handler)
+    {
+        m_handlers << handler;
+
+        // Joining late, the batches received so far come at once
+        if (m_fetch && !m_fetch->receivedItems().isEmpty()) {
+            Utils::JobHandler::Scope scope(m_owner, m_priority);
+            handler(m_fetch->receivedItems());
+        }
+    }
+
+    void deliver(const Item::List &items)
+    {
+        m_items += items;
+
+        // The batches arrive outside of any scope, the jobs they
+        // trigger still belong to the one which asked for the fetch
+        Utils::JobHandler::Scope scope(m_owner, m_priority);
+        for (auto handler : m_handlers)
+            handler(items);
+    }
+
+    void finish(KJob *job, const Item::List &items)
+    {
+        m_fetch = 0;
+        m_items = items;
+        setError(job->error());
+        setErrorText(job->errorText());
+        setProcessedAmount(KJob::Items, m_items.size());
+        emitResult();
+    }
+
+protected:
+    bool doKill()
+    {
+        if (m_fetch)
+            m_fetch->removeWaiter(this);
+        m_fetch = 0;
+        return true;
+    }
+
+private:
+    QPointer<SharedCollectionFetch> m_fetch;
+    QList<ItemsReceivedHandler> m_handlers;
+    Item::List m_items;
+    QPointer<QObject> m_owner;
+    Utils::JobHandler::Priority m_priority;
+};
+
+}
+
+SharedCollectionFetch::SharedCollectionFetch(ItemFetchJobInterface *job, QObject *parent)
+    : QObject(parent),
+      m_job(job->kjob()),
+      m_finished(false)
+{
+    QPointer<SharedCollectionFetch> handle(this);
+    job->installItemsReceivedHandler([handle] (const Item::List &items) {
+        if (!handle)
+            return;
+
+        handle->m_receivedItems += items;
+        const auto waiters = handle->m_waiters;
+        for (auto waiter : waiters) {
+            if (waiter)
+                waiter->deliver(items);
+        }
+    });
+    connect(m_job, SIGNAL(result(KJob*)), this, SLOT(onResult(KJob*)));
+}
+
+void SharedCollectionFetch::addWaiter(CollectionFetchWaiter *waiter)
+{
+    m_waiters << waiter;
+}
+
+void SharedCollectionFetch::removeWaiter(CollectionFetchWaiter *waiter)
+{
+    m_waiters.removeAll(waiter);
+    m_waiters.removeAll(QPointer<CollectionFetchWaiter>());
+
+    if (m_waiters.isEmpty() && m_job)
+        m_job->kill(KJob::EmitResult);
+}
+
+void SharedCollectionFetch::onResult(KJob *job)
+{
+    m_finished = true;
+
+    auto fetchJob = dynamic_cast<ItemFetchJobInterface*>(job);
+    const auto items = fetchJob ? fetchJob->items() : m_receivedItems;
+    const auto waiters = m_waiters;
+    m_waiters.clear();
+    for (auto waiter : waiters) {
+        if (waiter)
+            waiter->finish(job, items);
+    }
+
+    deleteLater();
+}
+
+static QString collectionTreeKey(const QStringList &mimeTypes, Cache::CollectionFilter filter)
+{
+    auto sortedMimeTypes = mimeTypes;
+    sortedMimeTypes.sort();
+    return sortedMimeTypes.join(",") + (filter == Cache::DisplayedCollections ? "|displayed" : "|all");
+}
+
+Cache::Cache(MonitorInterface *monitor, QObject *parent)
+    : QObject(parent)
+{
+    connect(monitor, SIGNAL(collectionAdded(Akonadi::Collection)), this, SLOT(onCollectionAdded(Akonadi::Collection)));
+    connect(monitor, SIGNAL(collectionRemoved(Akonadi::Collection)), this, SLOT(onCollectionRemoved(Akonadi::Collection)));
+    connect(monitor, SIGNAL(collectionChanged(Akonadi::Collection)), this, SLOT(onCollectionChanged(Akonadi::Collection)));
+
+    connect(monitor, SIGNAL(itemAdded(Akonadi::Item)), this, SLOT(onItemAdded(Akonadi::Item)));
+    connect(monitor, SIGNAL(itemRemoved(Akonadi::Item)), this, SLOT(onItemRemoved(Akonadi::Item)));
+    connect(monitor, SIGNAL(itemChanged(Akonadi::Item)), this, SLOT(onItemChanged(Akonadi::Item)));
+    connect(monitor, SIGNAL(itemMoved(Akonadi::Item)), this, SLOT(onItemMoved(Akonadi::Item)));
+}
+
+bool Cache::isCollectionTreePopulated(const QStringList &mimeTypes, CollectionFilter filter) const
+{
+    return m_populatedCollectionTrees.contains(collectionTreeKey(mimeTypes, filter));
+}
+
+Collection::List Cache::collections(const Collection &base, bool recursive,
+                                    const QStringList &mimeTypes, CollectionFilter filter) const
+{
+    const auto allowedMimeTypes = mimeTypes.toSet();
+
+    Collection::List result;
+    for (const auto &collection : m_collections) {
+        const bool inScope = recursive ? isDescendant(collection, base)
+                                       : collection.parentCollection().id() == base.id();
+        if (!inScope)
+            continue;
+
+        if (collection.contentMimeTypes().toSet().intersect(allowedMimeTypes).isEmpty())
+            continue;
+
+        if (filter == DisplayedCollections && !isDisplayed(collection))
+            continue;
+
+        result << withAncestors(collection, base);
+    }
+    return result;
+}
+
+void Cache::populateCollectionTree(const QStringList &mimeTypes, CollectionFilter filter,
+                                   const Collection::List &collections)
+{
+    for (const auto &collection : collections)
+        addCollection(collection);
+
+    m_populatedCollectionTrees.insert(collectionTreeKey(mimeTypes, filter));
+}
+
+bool Cache::isCollectionPopulated(Collection::Id id) const
+{
+    return m_collectionItems.contains(id);
+}
+
+Item::List Cache::items(const Collection &collection) const
+{
+    Item::List result;
+    const auto ids = m_collectionItems.value(collection.id());
+    for (auto id : ids) {
+        result << m_items.value(id);
+    }
+    return result;
+}
+
+void Cache::beginCollectionFetch(Collection::Id id)
+{
+    // Anything seen before is older than what the fetch will get
+    m_pendingChanges.insert(id, QList<PendingChange>());
+}
+
+void Cache::populateCollection(const Collection &collection, const Item::List &items)
+{
+    for (auto id : m_collectionItems.value(collection.id()))
+        m_items.remove(id);
+
+    QList<Item::Id> ids;
+    for (const auto &item : items) {
+        // The monitor already told us it lives somewhere else
+        if (m_items.contains(item.id()))
+            continue;
+
+        ids << item.id();
+        m_items.insert(item.id(), item);
+    }
+    m_collectionItems.insert(collection.id(), ids);
+
+    for (const auto &change : m_pendingChanges.take(collection.id())) {
+        const auto id = change.item.id();
+        if (!change.removed)
+            updateItem(change.item);
+        else if (m_items.value(id).parentCollection().id() == collection.id())
+            removeItem(id);
+    }
+}
+
+void Cache::abortCollectionFetch(Collection::Id id)
+{
+    m_pendingChanges.remove(id);
+}
+
+ItemFetchJobInterface *Cache::joinCollectionFetch(Collection::Id id, const FetchStarter &starter)
+{
+    auto fetch = m_runningFetches.value(id);
+    if (!fetch || fetch->isFinished()) {
+        // Nobody in particular owns the fetch, it lives as long as someone waits on it
+        Utils::JobHandler::Scope scope(0, Utils::JobHandler::currentPriority());
+        fetch = new SharedCollectionFetch(starter(), this);
+        m_runningFetches.insert(id, fetch);
+    }
+
+    return new CollectionFetchWaiter(fetch);
+}
+
+void Cache::watchCollection(Collection::Id id)
+{
+    m_watchedCollections.insert(id);
+}
+
+bool Cache::isCollectionWatched(Collection::Id id) const
+{
+    return m_watchedCollections.contains(id);
+}
+
+Cache::ItemFilter Cache::itemFilter()
+{
+    QPointer<Cache> self(this);
+    return [self] (const Akonadi::Item &item) {
+        // Without the cache we can't tell, let everything through
+        if (!self)
+            return true;
+
+        return !item.tags().isEmpty()
+            || self->isCollectionWatched(item.parentCollection().id());
+    };
+}
+
+void Cache::invalidateCollectionTrees()
+{
+    m_populatedCollectionTrees.clear();
+    m_collections.clear();
+}
+
+void Cache::onCollectionAdded(const Collection &collection)
+{
+    if (m_populatedCollectionTrees.isEmpty())
+        return;
+
+    followCollection(collection);
+}
+
+void Cache::onCollectionRemoved(const Collection &collection)
+{
+    for (auto id : m_collectionItems.take(collection.id()))
+        m_items.remove(id);
+
+    QList<Collection::Id> removedIds;
+    removedIds << collection.id();
+    for (const auto &candidate : m_collections) {
+        if (isDescendant(candidate, collection))
+            removedIds << candidate.id();
+    }
+
+    for (auto id : removedIds) {
+        m_collections.remove(id);
+        m_watchedCollections.remove(id);
+        m_pendingChanges.remove(id);
+    }
+}
+
+void Cache::onCollectionChanged(const Collection &collection)
+{
+    if (m_populatedCollectionTrees.isEmpty())
+        return;
+
+    followCollection(collection);
+}
+
+void Cache::onItemAdded(const Item &item)
+{
+    recordChange(item, false);
+    addItem(item);
+}
+
+void Cache::onItemRemoved(const Item &item)
+{
+    recordChange(item, true);
+    removeItem(item.id());
+}
+
+void Cache::onItemChanged(const Item &item)
+{
+    recordChange(item, false);
+    updateItem(item);
+}
+
+void Cache::onItemMoved(const Item &item)
+{
+    recordChange(item, false);
+    removeItem(item.id());
+    addItem(item);
+}
+
+void Cache::addCollection(const Collection &collection)
+{
+    // Collections are kept flat with only the id of their parent,
+    // the ancestor chains get rebuilt when serving them
+    auto flatCollection = collection;
+    flatCollection.setParentCollection(Collection(collection.parentCollection().id()));
+    m_collections.insert(flatCollection.id(), flatCollection);
+
+    // Ancestors might come with less data, so they only fill the gaps
+    auto ancestor = collection.parentCollection();
+    while (ancestor.isValid()
+        && ancestor != Collection::root()
+        && !m_collections.contains(ancestor.id())) {
+        auto flatAncestor = ancestor;
+        flatAncestor.setParentCollection(Collection(ancestor.parentCollection().id()));
+        m_collections.insert(flatAncestor.id(), flatAncestor);
+        ancestor = ancestor.parentCollection();
+    }
+}
+
+void Cache::followCollection(const Collection &collection)
+{
+    addCollection(collection);
+
+    // Without its whole chain it can't be placed in the trees,
+    // they'll have to be fetched again
+    if (!isDescendant(m_collections.value(collection.id()), Collection::root()))
+        invalidateCollectionTrees();
+}
+
+bool Cache::isDescendant(const Collection &collection, const Collection &base) const
+{
+    auto parentId = collection.parentCollection().id();
+    while (parentId != base.id()) {
+        if (!m_collections.contains(parentId))
+            return false;
+        parentId = m_collections.value(parentId).parentCollection().id();
+    }
+    return true;
+}
+
+bool Cache::isDisplayed(const Collection &collection) const
+{
+    // Same rules as the Display list filter on the server side,
+    // hidden collections hide their whole subtree
+    auto current = collection;
+    forever {
+        switch (current.localListPreference(Collection::ListDisplay)) {
+        case Collection::ListEnabled:
+            break;
+        case Collection::ListDisabled:
+            return false;
+        default:
+            if (!current.enabled() && !current.referenced())
+                return false;
+            break;
+        }
+
+        const auto parentId = current.parentCollection().id();
+        if (!m_collections.contains(parentId))
+            return true;
+        current = m_collections.value(parentId);
+    }
+}
+
+Collection Cache::withAncestors(const Collection &collection, const Collection &base) const
+{
+    auto result = collection;
+
+    const auto parentId = collection.parentCollection().id();
+    if (parentId == base.id())
+        result.setParentCollection(base);
+    else if (m_collections.contains(parentId))
+        result.setParentCollection(withAncestors(m_collections.value(parentId), base));
+    else if (parentId == Collection::root().id())
+        result.setParentCollection(Collection::root());
+
+    return result;
+}
+
+void Cache::addItem(const Item &item)
+{
+    const auto collectionId = item.parentCollection().id();
+    if (!m_collectionItems.contains(collectionId))
+        return;
+
+    if (!m_items.contains(item.id()))
+        m_collectionItems[collectionId] << item.id();
+    m_items.insert(item.id(), item);
+}
+
+void Cache::updateItem(const Item &item)
+{
+    if (!m_items.contains(item.id())) {
+        addItem(item);
+        return;
+    }
+
+    const auto oldItem = m_items.value(item.id());
+    if (oldItem.parentCollection().id() != item.parentCollection().id()) {
+        removeItem(item.id());
+        addItem(item);
+    } else {
+        m_items.insert(item.id(), item);
+    }
+}
+
+void Cache::removeItem(Item::Id id)
+{
+    if (!m_items.contains(id))
+        return;
+
+    const auto item = m_items.take(id);
+    const auto collectionId = item.parentCollection().id();
+    if (m_collectionItems.contains(collectionId))
+        m_collectionItems[collectionId].removeOne(id);
+}
+
+void Cache::recordChange(const Item &item, bool removed)
+{
+    // An item leaving a collection being fetched doesn't tell where it
+    // came from, so removals and moves are recorded for all of them
+    const auto collectionId = item.parentCollection().id();
+    for (auto it = m_pendingChanges.begin(); it != m_pendingChanges.end(); ++it) {
+        if (it.key() == collectionId) {
+            it.value() << PendingChange{item, removed};
+        } else {
+            auto removal = Item(item.id());
+            it.value() << PendingChange{removal, true};
+        }
+    }
+}
+
+#include "akonadicache.moc"
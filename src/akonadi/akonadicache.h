@@ -0,0 +1,139 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+
+#ifndef AKONADI_CACHE_H
+#define AKONADI_CACHE_H
+
+#include <functional>
+
+#include <QHash>
+#include <QMap>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QStringList>
+
+#include <Akonadi/Collection>
+#include <Akonadi/Item>
+
+namespace Akonadi {
+
+class ItemFetchJobInterface;
+class MonitorInterface;
+class SharedCollectionFetch;
+
+// Keeps the collection tree and the items of the collections fetched
+// so far in memory and up to date using the monitor, so that fetching
+// them again doesn't need to go through the server. Items are kept as
+// the lists fetch them, full fetches go to the server.
+// It is shared, the application registers it as an unique instance in
+// Utils::DependencyManager
+class Cache : public QObject
+{
+    Q_OBJECT
+public:
+    enum CollectionFilter {
+        AllCollections,
+        DisplayedCollections
+    };
+
+    typedef std::function<ItemFetchJobInterface*()> FetchStarter;
+    typedef std::function<bool(const Akonadi::Item &)> ItemFilter;
+
+    explicit Cache(MonitorInterface *monitor, QObject *parent = 0);
+
+    bool isCollectionTreePopulated(const QStringList &mimeTypes, CollectionFilter filter) const;
+    Collection::List collections(const Collection &base, bool recursive,
+                                 const QStringList &mimeTypes, CollectionFilter filter) const;
+
+    void populateCollectionTree(const QStringList &mimeTypes, CollectionFilter filter,
+                                const Collection::List &collections);
+    // For changes which can't be followed, the trees get fetched again
+    void invalidateCollectionTrees();
+
+    bool isCollectionPopulated(Collection::Id id) const;
+    Item::List items(const Collection &collection) const;
+
+    // The changes notified between those two calls get replayed over
+    // the fetched items, they can be more recent than what got fetched
+    void beginCollectionFetch(Collection::Id id);
+    void populateCollection(const Collection &collection, const Item::List &items);
+    void abortCollectionFetch(Collection::Id id);
+
+    // Only one fetch of the items of a collection runs at a time, the
+    // callers asking for them meanwhile get a job joining it. The starter
+    // is only called when none is running, outside of any job scope. The
+    // fetch gets cancelled once all the jobs waiting on it are.
+    ItemFetchJobInterface *joinCollectionFetch(Collection::Id id, const FetchStarter &starter);
+
+    // Collections the queries asked the items of, fetched already or not
+    void watchCollection(Collection::Id id);
+    bool isCollectionWatched(Collection::Id id) const;
+
+    // Tells which item notifications might matter to the queries, to be
+    // installed on the monitor: the items of the watched collections and
+    // the tagged ones, which the queries fetch by tag
+    ItemFilter itemFilter();
+
+private slots:
+    void onCollectionAdded(const Akonadi::Collection &collection);
+    void onCollectionRemoved(const Akonadi::Collection &collection);
+    void onCollectionChanged(const Akonadi::Collection &collection);
+
+    void onItemAdded(const Akonadi::Item &item);
+    void onItemRemoved(const Akonadi::Item &item);
+    void onItemChanged(const Akonadi::Item &item);
+    void onItemMoved(const Akonadi::Item &item);
+
+private:
+    void addCollection(const Collection &collection);
+    void followCollection(const Collection &collection);
+    bool isDescendant(const Collection &collection, const Collection &base) const;
+    bool isDisplayed(const Collection &collection) const;
+    Collection withAncestors(const Collection &collection, const Collection &base) const;
+
+    void addItem(const Item &item);
+    void updateItem(const Item &item);
+    void removeItem(Item::Id id);
+    void recordChange(const Item &item, bool removed);
+
+    struct PendingChange {
+        Item item;
+        bool removed;
+    };
+
+    QSet<QString> m_populatedCollectionTrees;
+    QMap<Collection::Id, Collection> m_collections;
+
+    QHash<Collection::Id, QList<Item::Id>> m_collectionItems;
+    QHash<Item::Id, Item> m_items;
+    QSet<Collection::Id> m_watchedCollections;
+    QHash<Collection::Id, QList<PendingChange>> m_pendingChanges;
+    QHash<Collection::Id, QPointer<SharedCollectionFetch>> m_runningFetches;
+};
+
+}
+
+#endif // AKONADI_CACHE_H
@@ -26,11 +26,13 @@
 
 #include "akonadicollectionfetchjobinterface.h"
 #include "akonadiitemfetchjobinterface.h"
+#include "akonadilivequeryhelpers.h"
 #include "akonaditagfetchjobinterface.h"
-#include "akonadimonitorimpl.h"
+#include "akonadimonitorinterface.h"
 #include "akonadiserializer.h"
 #include "akonadistorage.h"
 
+#include "utils/dependencymanager.h"
 #include "utils/jobhandler.h"
 #include <QByteArray>
 #include <QDebug>
@@ -41,7 +43,7 @@ ContextQueries::ContextQueries(QObject *parent)
     : QObject(parent),
       m_storage(new Storage),
       m_serializer(new Serializer),
-      m_monitor(new MonitorImpl),
+      m_monitor(Utils::DependencyManager::globalInstance().create<MonitorInterface>()),
       m_ownInterfaces(true)
 {
     connect(m_monitor, SIGNAL(tagAdded(Akonadi::Tag)), this, SLOT(onTagAdded(Akonadi::Tag)));
@@ -106,6 +108,9 @@ ContextQueries::ContextResult::Ptr ContextQueries::findAll() const
         m_findAll->setRepresentsFunction([this] (const Akonadi::Tag &tag, const Domain::Context::Ptr &context) {
             return m_serializer->isContextTag(context, tag);
         });
+        m_findAll->setKeyFunction([] (const Akonadi::Tag &tag) {
+            return tag.id();
+        });
     }
 
     return m_findAll->result();
@@ -123,20 +128,16 @@ ContextQueries::TaskResult::Ptr ContextQueries::findTopLevelTasks(Domain::Contex
             self->m_findToplevel.insert(tag.id(), query);
         }
 
-        query->setFetchFunction([this, tag] (const TaskQuery::AddFunction &add) {
+        query->setRangeFetchFunction([this, tag] (const TaskQuery::AddRangeFunction &add) {
             ItemFetchJobInterface *job = m_storage->fetchTagItems(tag);
-            Utils::JobHandler::install(job->kjob(), [this, job, add] {
-                if (job->kjob()->error() != KJob::NoError)
-                    return;
-
-                for (auto item : job->items())
-                    add(item);
-            });
-
+            job->installItemsReceivedHandler(add);
         });
         query->setConvertFunction([this] (const Akonadi::Item &item) {
             return m_serializer->createTaskFromItem(item);
         });
+        query->setRangeConvertFunction([this] (const Akonadi::Item::List &items) {
+            return m_serializer->createTasksFromItems(items);
+        });
         query->setUpdateFunction([this] (const Akonadi::Item &item, Domain::Task::Ptr &task) {
             m_serializer->updateTaskFromItem(task, item);
         });
@@ -146,6 +147,9 @@ ContextQueries::TaskResult::Ptr ContextQueries::findTopLevelTasks(Domain::Contex
         query->setRepresentsFunction([this] (const Akonadi::Item &item, const Domain::Task::Ptr &task) {
             return m_serializer->representsItem(task, item);
         });
+        query->setKeyFunction([] (const Akonadi::Item &item) {
+            return item.id();
+        });
     }
 
     return m_findToplevel.value(tag.id())->result();
@@ -169,6 +173,8 @@ void ContextQueries::onTagChanged(const Tag &tag)
         query->onChanged(tag);
 }
 
+// The per context task queries stay broadcast: an item can carry several
+// context tags and the router only knows a single route per input.
 void ContextQueries::onItemAdded(const Item &item)
 {
     foreach (const TaskQuery::Ptr &query, m_taskQueries)
@@ -190,6 +196,8 @@ void ContextQueries::onItemChanged(const Item &item)
 ContextQueries::ContextQuery::Ptr ContextQueries::createContextQuery()
 {
     auto query = ContextQuery::Ptr::create();
+    LiveQueryHelpers::attachJobOwner(query);
+    query->setBatchingEnabled(true);
     m_contextQueries << query;
     return query;
 }
@@ -197,6 +205,8 @@ ContextQueries::ContextQuery::Ptr ContextQueries::createContextQuery()
 ContextQueries::TaskQuery::Ptr ContextQueries::createTaskQuery()
 {
     auto query = TaskQuery::Ptr::create();
+    LiveQueryHelpers::attachJobOwner(query);
+    query->setBatchingEnabled(true);
     m_taskQueries << query;
     return query;
 }
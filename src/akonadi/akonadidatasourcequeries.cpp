@@ -27,11 +27,13 @@
 #include "akonadicollectionfetchjobinterface.h"
 #include "akonadicollectionsearchjobinterface.h"
 #include "akonadiitemfetchjobinterface.h"
-#include "akonadimonitorimpl.h"
+#include "akonadilivequeryhelpers.h"
+#include "akonadimonitorinterface.h"
 #include "akonadiserializer.h"
 #include "akonadistorage.h"
 #include "domain/mergedqueryresultprovider.h"
 
+#include "utils/dependencymanager.h"
 #include "utils/jobhandler.h"
 #include "utils/compositejob.h"
 
@@ -259,6 +261,7 @@ DataSourceQueries::DataSourceResult::Ptr TreeQuery::findChildren(Domain::DataSou
     const Collection root = source ? m_serializer->createCollectionFromDataSource(source) : Collection::root();
     if (!m_findChildren.contains(root.id())) {
         auto query = DataSourceQuery::Ptr::create();
+        LiveQueryHelpers::attachJobOwner(query);
         m_findChildren.insert(root.id(), query);
         setupFunction(query, root);
     }
@@ -294,7 +297,7 @@ DataSourceQueries::DataSourceQueries(QObject *parent)
     : QObject(parent),
       m_storage(new Storage),
       m_serializer(new Serializer),
-      m_monitor(new MonitorImpl),
+      m_monitor(Utils::DependencyManager::globalInstance().create<MonitorInterface>()),
       m_ownInterfaces(true),
       m_fetchContentTypeFilter(StorageInterface::Tasks | StorageInterface::Notes)
 {
@@ -532,12 +535,13 @@ DataSourceQueries::DataSourceResult::Ptr DataSourceQueries::findTasks() const
             self->m_findTasks = self->createDataSourceQuery();
         }
 
-        m_findTasks->setFetchFunction([this] (const DataSourceQuery::AddFunction &add) {
+        m_findTasks->setRangeFetchFunction([this] (const DataSourceQuery::AddRangeFunction &add) {
             CollectionFetchJobInterface *job = m_storage->fetchCollections(Akonadi::Collection::root(), StorageInterface::Recursive, StorageInterface::Tasks);
             Utils::JobHandler::install(job->kjob(), [this, job, add] {
-                for (auto collection : job->collections()) {
-                    add(collection);
-                }
+                if (job->kjob()->error() != KJob::NoError)
+                    return;
+
+                add(job->collections());
             });
         });
 
@@ -553,6 +557,9 @@ DataSourceQueries::DataSourceResult::Ptr DataSourceQueries::findTasks() const
         m_findTasks->setRepresentsFunction([this] (const Akonadi::Collection &collection, const Domain::DataSource::Ptr &source) {
             return m_serializer->representsCollection(source, collection);
         });
+        m_findTasks->setKeyFunction([] (const Akonadi::Collection &collection) {
+            return collection.id();
+        });
     }
 
     return m_findTasks->result();
@@ -566,11 +573,13 @@ DataSourceQueries::DataSourceResult::Ptr DataSourceQueries::findNotes() const
             self->m_findNotes = self->createDataSourceQuery();
         }
 
-        m_findNotes->setFetchFunction([this] (const DataSourceQuery::AddFunction &add) {
+        m_findNotes->setRangeFetchFunction([this] (const DataSourceQuery::AddRangeFunction &add) {
             CollectionFetchJobInterface *job = m_storage->fetchCollections(Akonadi::Collection::root(), StorageInterface::Recursive, StorageInterface::Notes);
             Utils::JobHandler::install(job->kjob(), [this, job, add] {
-                for (auto collection : job->collections())
-                    add(collection);
+                if (job->kjob()->error() != KJob::NoError)
+                    return;
+
+                add(job->collections());
             });
         });
 
@@ -586,6 +595,9 @@ DataSourceQueries::DataSourceResult::Ptr DataSourceQueries::findNotes() const
         m_findNotes->setRepresentsFunction([this] (const Akonadi::Collection &collection, const Domain::DataSource::Ptr &source) {
             return m_serializer->representsCollection(source, collection);
         });
+        m_findNotes->setKeyFunction([] (const Akonadi::Collection &collection) {
+            return collection.id();
+        });
     }
 
     return m_findNotes->result();
@@ -620,9 +632,11 @@ DataSourceQueries::DataSourceResult::Ptr DataSourceQueries::findChildrenRecursiv
 
     auto job = m_storage->fetchCollections(col, StorageInterface::Recursive, m_fetchContentTypeFilter, StorageInterface::NoFilter);
     Utils::JobHandler::install(job->kjob(), [this, job, query] {
-        for (auto collection : job->collections()) {
-            auto source =  m_serializer->createDataSourceFromCollection(collection, SerializerInterface::FullPath);
-            query->append(source);
+        if (job->kjob()->error() == KJob::NoError) {
+            for (auto collection : job->collections()) {
+                auto source =  m_serializer->createDataSourceFromCollection(collection, SerializerInterface::FullPath);
+                query->append(source);
+            }
         }
         query->done();
     });
@@ -669,6 +683,9 @@ DataSourceQueries::DataSourceResult::Ptr DataSourceQueries::findSearchChildrenQu
         query->setRepresentsFunction([this] (const Akonadi::Collection &collection, const Domain::DataSource::Ptr &source) {
             return m_serializer->representsCollection(source, collection);
         });
+        query->setKeyFunction([] (const Akonadi::Collection &collection) {
+            return collection.id();
+        });
     });
 }
 
@@ -695,6 +712,8 @@ DataSourceQueries::DataSourceResult::Ptr DataSourceQueries::findSearchChildren(D
     return findSearchChildrenQuery(source, treeQuery);
 }
 
+// Only the flat findTasks() and findNotes() queries get the notifications
+// here, the children queries are dispatched by parent through TreeQuery.
 void DataSourceQueries::onCollectionAdded(const Collection &collection)
 {
     foreach (const DataSourceQuery::Ptr &query, m_dataSourceQueries)
@@ -716,6 +735,8 @@ void DataSourceQueries::onCollectionChanged(const Collection &collection)
 DataSourceQueries::DataSourceQuery::Ptr DataSourceQueries::createDataSourceQuery()
 {
     auto query = DataSourceQuery::Ptr::create();
+    LiveQueryHelpers::attachJobOwner(query);
+    query->setBatchingEnabled(true);
     m_dataSourceQueries << query;
     return query;
 }
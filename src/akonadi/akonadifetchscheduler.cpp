@@ -0,0 +1,178 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+
+#include "akonadifetchscheduler.h"
+
+#include <algorithm>
+
+#include <KJob>
+
+#include "utils/dependencymanager.h"
+
+using namespace Akonadi;
+
+FetchScheduler *FetchScheduler::sharedScheduler()
+{
+    // The application registers it, so can the tests to replace it,
+    // the others get the default one
+    auto &deps = Utils::DependencyManager::globalInstance();
+    if (!deps.contains<FetchScheduler>())
+        deps.add<FetchScheduler, FetchScheduler>(Utils::DependencyManager::UniqueInstance);
+    return deps.create<FetchScheduler>();
+}
+
+FetchScheduler::FetchScheduler(int maximumRunningJobs, QObject *parent)
+    : QObject(parent),
+      m_maximumRunningJobs(qMax(1, maximumRunningJobs)),
+      m_finishedJobs(0),
+      m_totalJobs(0)
+{
+}
+
+int FetchScheduler::maximumRunningJobs() const
+{
+    return m_maximumRunningJobs;
+}
+
+void FetchScheduler::setMaximumRunningJobs(int count)
+{
+    m_maximumRunningJobs = qMax(1, count);
+    startPendingJobs();
+}
+
+int FetchScheduler::runningJobs() const
+{
+    return m_runningJobs.size();
+}
+
+int FetchScheduler::pendingJobs() const
+{
+    return m_pendingJobs.size();
+}
+
+void FetchScheduler::schedule(const Collection &collection, const JobStarter &starter)
+{
+    const auto priority = Utils::JobHandler::currentPriority();
+    const auto id = collection.id();
+
+    auto it = std::find_if(m_pendingJobs.begin(), m_pendingJobs.end(),
+                           [id] (const PendingJob &other) {
+                               return other.collectionId == id;
+                           });
+    if (it != m_pendingJobs.end()) {
+        if (priority < it->priority) {
+            // Moves up in the line to where the new request would have gone
+            auto pending = *it;
+            m_pendingJobs.erase(it);
+            pending.priority = priority;
+            pending.starters << starter;
+            enqueue(pending);
+        } else {
+            it->starters << starter;
+        }
+        return;
+    }
+
+    PendingJob pending;
+    pending.collectionId = id;
+    pending.priority = priority;
+    pending.starters << starter;
+    enqueue(pending);
+    m_totalJobs++;
+
+    reportProgress();
+    startPendingJobs();
+}
+
+void FetchScheduler::prioritize(const Collection &collection)
+{
+    QList<PendingJob> prioritized;
+    auto it = m_pendingJobs.begin();
+    while (it != m_pendingJobs.end()) {
+        if (it->collectionId == collection.id()) {
+            it->priority = Utils::JobHandler::VisiblePriority;
+            prioritized << *it;
+            it = m_pendingJobs.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    m_pendingJobs = prioritized + m_pendingJobs;
+}
+
+void FetchScheduler::onJobFinished(KJob *job)
+{
+    if (!m_runningJobs.remove(job))
+        return;
+
+    m_finishedJobs++;
+    reportProgress();
+    startPendingJobs();
+}
+
+void FetchScheduler::enqueue(const PendingJob &pending)
+{
+    const auto priority = pending.priority;
+    auto it = std::find_if(m_pendingJobs.begin(), m_pendingJobs.end(),
+                           [priority] (const PendingJob &other) {
+                               return other.priority > priority;
+                           });
+    m_pendingJobs.insert(it, pending);
+}
+
+void FetchScheduler::startPendingJobs()
+{
+    while (m_runningJobs.size() < m_maximumRunningJobs && !m_pendingJobs.isEmpty()) {
+        const auto starters = m_pendingJobs.takeFirst().starters;
+        KJob *job = 0;
+        for (const auto &starter : starters) {
+            auto started = starter(job);
+            if (!job)
+                job = started;
+        }
+
+        if (!job) {
+            // Nobody waits for it anymore
+            m_finishedJobs++;
+            reportProgress();
+            continue;
+        }
+
+        m_runningJobs.insert(job);
+        connect(job, SIGNAL(finished(KJob*)), this, SLOT(onJobFinished(KJob*)));
+    }
+}
+
+void FetchScheduler::reportProgress()
+{
+    emit progress(m_finishedJobs, m_totalJobs);
+
+    // Start counting again from the next burst of fetches
+    if (m_finishedJobs == m_totalJobs) {
+        m_finishedJobs = 0;
+        m_totalJobs = 0;
+    }
+}
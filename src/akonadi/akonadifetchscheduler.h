@@ -0,0 +1,104 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+
+#ifndef AKONADI_FETCHSCHEDULER_H
+#define AKONADI_FETCHSCHEDULER_H
+
+#include <functional>
+
+#include <QList>
+#include <QObject>
+#include <QSet>
+
+#include <Akonadi/Collection>
+
+#include "utils/jobhandler.h"
+
+class KJob;
+
+namespace Akonadi {
+
+// Keeps the number of collection fetches running against the server
+// bounded, the other ones wait in line for a free slot. The line is
+// ordered by the priority of the job scope they got scheduled from.
+// Fetches of a collection scheduled while one is waiting share its slot.
+class FetchScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    // Gets the job already started for the same slot or 0 if none was
+    typedef std::function<KJob*(KJob *runningJob)> JobStarter;
+
+    // The process wide scheduler, it is the FetchScheduler unique
+    // instance of Utils::DependencyManager
+    static FetchScheduler *sharedScheduler();
+
+    explicit FetchScheduler(int maximumRunningJobs = 4, QObject *parent = 0);
+
+    int maximumRunningJobs() const;
+    void setMaximumRunningJobs(int count);
+
+    int runningJobs() const;
+    int pendingJobs() const;
+
+    // The starter is called once a slot is free, it returns the job it
+    // launched or 0 if the fetch isn't wanted anymore. The fetch goes
+    // after the pending ones of the same or higher priority. If a fetch
+    // of that collection is already waiting, the starter gets called
+    // right after that fetch's one and is given the job it started
+    // to wait on it instead of starting its own.
+    void schedule(const Collection &collection, const JobStarter &starter);
+
+    // Moves the pending fetches of that collection to the front of the line
+    void prioritize(const Collection &collection);
+
+signals:
+    void progress(int finished, int total);
+
+private slots:
+    void onJobFinished(KJob *job);
+
+private:
+    struct PendingJob
+    {
+        Collection::Id collectionId;
+        Utils::JobHandler::Priority priority;
+        QList<JobStarter> starters;
+    };
+
+    void enqueue(const PendingJob &pending);
+    void startPendingJobs();
+    void reportProgress();
+
+    int m_maximumRunningJobs;
+    QList<PendingJob> m_pendingJobs;
+    QSet<KJob*> m_runningJobs;
+    int m_finishedJobs;
+    int m_totalJobs;
+};
+
+}
+
+#endif // AKONADI_FETCHSCHEDULER_H
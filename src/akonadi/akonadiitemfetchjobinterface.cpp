@@ -26,6 +26,8 @@
 
 #include <KJob>
 
+#include "utils/jobhandler.h"
+
 using namespace Akonadi;
 
 ItemFetchJobInterface::ItemFetchJobInterface()
@@ -42,3 +44,13 @@ KJob *ItemFetchJobInterface::kjob()
     Q_ASSERT(job);
     return job;
 }
+
+void ItemFetchJobInterface::installItemsReceivedHandler(const ItemsReceivedHandler &handler)
+{
+    Utils::JobHandler::install(kjob(), [this, handler] {
+        if (kjob()->error() != KJob::NoError)
+            return;
+
+        handler(items());
+    });
+}
@@ -24,6 +24,8 @@
 #ifndef AKONADI_ITEMFETCHJOBINTERFACE_H
 #define AKONADI_ITEMFETCHJOBINTERFACE_H
 
+#include <functional>
+
 #include <Akonadi/Item>
 
 class KJob;
@@ -33,12 +35,18 @@ namespace Akonadi {
 class ItemFetchJobInterface
 {
 public:
+    typedef std::function<void(const Item::List &)> ItemsReceivedHandler;
+
     ItemFetchJobInterface();
     virtual ~ItemFetchJobInterface();
 
     KJob *kjob();
 
     virtual Item::List items() const = 0;
+
+    // Hands the items over in batches while they arrive. By default they
+    // all come in one batch once the job is done, and none on error.
+    virtual void installItemsReceivedHandler(const ItemsReceivedHandler &handler);
 };
 
 }
@@ -0,0 +1,65 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#ifndef AKONADI_LIVEQUERYHELPERS_H
+#define AKONADI_LIVEQUERYHELPERS_H
+
+#include <QObject>
+#include <QSharedPointer>
+
+#include "domain/livequery.h"
+
+#include "utils/delayedcall.h"
+#include "utils/jobhandler.h"
+
+namespace Akonadi {
+
+namespace LiveQueryHelpers
+{
+    // Gives the query a job owner of its own, living as long as the query.
+    // Its fetches run in that owner's scope and the callers asking for a
+    // result hold it, so the fetches only get cancelled once none of them
+    // is left. Batched notifications go through DelayedCall with the owner
+    // as context, so they are dropped along with the query.
+    template<typename InputType, typename OutputType>
+    void attachJobOwner(const QSharedPointer<Domain::LiveQuery<InputType, OutputType>> &query)
+    {
+        QSharedPointer<QObject> owner(new QObject);
+
+        query->setHoldFunction([owner] {
+            Utils::JobHandler::hold(owner.data());
+        });
+        query->setScopeFunction([owner] (const std::function<void()> &fetch) {
+            Utils::JobHandler::Scope scope(owner.data(), Utils::JobHandler::currentPriority());
+            fetch();
+        });
+        query->setPostFunction([owner] (const std::function<void()> &callback) {
+            Utils::DelayedCall::post(owner.data(), callback);
+        });
+    }
+}
+
+}
+
+#endif // AKONADI_LIVEQUERYHELPERS_H
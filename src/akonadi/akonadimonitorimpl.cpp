@@ -24,23 +24,31 @@
 
 #include "akonadimonitorimpl.h"
 
+#include <algorithm>
+
 #include <KCalCore/Todo>
 
 #include <Akonadi/AttributeFactory>
 #include <Akonadi/CollectionFetchScope>
+#include <Akonadi/ItemFetchJob>
 #include <Akonadi/ItemFetchScope>
 #include <Akonadi/Monitor>
 #include <Akonadi/Notes/NoteUtils>
 #include <Akonadi/TagFetchScope>
 
+#include <QTimer>
+
 #include "akonadi/akonadiapplicationselectedattribute.h"
+#include "akonadi/akonadistorage.h"
 #include "akonadi/akonaditimestampattribute.h"
 #include "akonadi/collectionidentificationattribute.h"
 
 using namespace Akonadi;
 
 MonitorImpl::MonitorImpl()
-    : m_monitor(new Akonadi::Monitor)
+    : m_monitor(new Akonadi::Monitor),
+      m_nextSerial(0),
+      m_payloadFetchScheduled(false)
 {
     AttributeFactory::registerAttribute<ApplicationSelectedAttribute>();
     AttributeFactory::registerAttribute<TimestampAttribute>();
@@ -63,19 +71,23 @@ MonitorImpl::MonitorImpl()
     connect(m_monitor, SIGNAL(collectionAdded(Akonadi::Collection,Akonadi::Collection)), this, SIGNAL(collectionAdded(Akonadi::Collection)));
     connect(m_monitor, SIGNAL(collectionRemoved(Akonadi::Collection)), this, SIGNAL(collectionRemoved(Akonadi::Collection)));
     connect(m_monitor, SIGNAL(collectionChanged(Akonadi::Collection,QSet<QByteArray>)), this, SLOT(onCollectionChanged(Akonadi::Collection,QSet<QByteArray>)));
+    connect(m_monitor, SIGNAL(collectionMoved(Akonadi::Collection,Akonadi::Collection,Akonadi::Collection)),
+            this, SLOT(onCollectionMoved(Akonadi::Collection,Akonadi::Collection,Akonadi::Collection)));
 
+    // Only what's needed to decide if a notification is of interest,
+    // the payload gets fetched afterwards for the items we keep
     auto itemScope = m_monitor->itemFetchScope();
-    itemScope.fetchFullPayload();
-    itemScope.fetchAllAttributes();
+    itemScope.fetchFullPayload(false);
+    itemScope.fetchAllAttributes(false);
     itemScope.setFetchTags(true);
-    itemScope.tagFetchScope().setFetchIdOnly(false);
-    itemScope.setAncestorRetrieval(ItemFetchScope::All);
+    itemScope.setAncestorRetrieval(ItemFetchScope::Parent);
     m_monitor->setItemFetchScope(itemScope);
 
-    connect(m_monitor, SIGNAL(itemAdded(Akonadi::Item, Akonadi::Collection)), this, SIGNAL(itemAdded(Akonadi::Item)));
-    connect(m_monitor, SIGNAL(itemRemoved(Akonadi::Item)), this, SIGNAL(itemRemoved(Akonadi::Item)));
-    connect(m_monitor, SIGNAL(itemChanged(Akonadi::Item,QSet<QByteArray>)), this, SIGNAL(itemChanged(Akonadi::Item)));
-    connect(m_monitor, SIGNAL(itemMoved(Akonadi::Item,Akonadi::Collection,Akonadi::Collection)), this, SIGNAL(itemMoved(Akonadi::Item)));
+    connect(m_monitor, SIGNAL(itemAdded(Akonadi::Item, Akonadi::Collection)), this, SLOT(onItemAdded(Akonadi::Item)));
+    connect(m_monitor, SIGNAL(itemRemoved(Akonadi::Item)), this, SLOT(onItemRemoved(Akonadi::Item)));
+    connect(m_monitor, SIGNAL(itemChanged(Akonadi::Item,QSet<QByteArray>)), this, SLOT(onItemChanged(Akonadi::Item,QSet<QByteArray>)));
+    connect(m_monitor, SIGNAL(itemMoved(Akonadi::Item,Akonadi::Collection,Akonadi::Collection)),
+            this, SLOT(onItemMoved(Akonadi::Item,Akonadi::Collection,Akonadi::Collection)));
 
     connect(m_monitor, SIGNAL(tagAdded(Akonadi::Tag)), this, SIGNAL(tagAdded(Akonadi::Tag)));
     connect(m_monitor, SIGNAL(tagRemoved(Akonadi::Tag)), this, SIGNAL(tagRemoved(Akonadi::Tag)));
@@ -86,6 +98,11 @@ MonitorImpl::~MonitorImpl()
 {
 }
 
+void MonitorImpl::setItemFilter(const ItemFilter &filter)
+{
+    m_itemFilter = filter;
+}
+
 void MonitorImpl::onCollectionChanged(const Collection &collection, const QSet<QByteArray> &parts)
 {
     // Will probably need to be expanded and to also fetch the full parent chain before emitting in some cases
@@ -95,7 +112,12 @@ void MonitorImpl::onCollectionChanged(const Collection &collection, const QSet<Q
                                                                     << "ENTITYDISPLAY"
                                                                     << "ZanshinSelected"
                                                                     << "ZanshinTimestamp"
-                                                                    << "REFERENCED";
+                                                                    << "ENABLED"
+                                                                    << "REFERENCED"
+                                                                    << "MIMETYPE"
+                                                                    << "DISPLAY"
+                                                                    << "SYNC"
+                                                                    << "INDEX";
 
     QSet<QByteArray> partsIntersection = parts;
     partsIntersection.intersect(allowedParts);
@@ -108,6 +130,207 @@ void MonitorImpl::onCollectionChanged(const Collection &collection, const QSet<Q
     }
 }
 
+void MonitorImpl::onCollectionMoved(const Collection &collection, const Collection &source, const Collection &destination)
+{
+    Q_UNUSED(source);
+
+    // A move is only a change of parent for our users
+    auto movedCollection = collection;
+    if (movedCollection.parentCollection().id() != destination.id())
+        movedCollection.setParentCollection(destination);
+    emit collectionChanged(movedCollection);
+}
+
+void MonitorImpl::onItemAdded(const Item &item)
+{
+    if (isItemShown(item))
+        enqueue(ItemAdded, item, item.parentCollection().id(), true);
+}
+
+void MonitorImpl::onItemRemoved(const Item &item)
+{
+    enqueue(ItemRemoved, item, item.parentCollection().id(), false);
+}
+
+void MonitorImpl::onItemChanged(const Item &item, const QSet<QByteArray> &parts)
+{
+    // Flags and attributes matter to the users as much as the payload,
+    // and they replace the whole item so it needs its payload either way.
+    // An item which isn't shown only matters if it lost its last tag,
+    // it might be shown by tag: it gets notified without its payload
+    // since nobody will show it anymore.
+    if (isItemShown(item))
+        enqueue(ItemChanged, item, item.parentCollection().id(), true);
+    else if (parts.isEmpty() || std::any_of(parts.constBegin(), parts.constEnd(),
+                                            [] (const QByteArray &part) { return part.startsWith("TAG"); }))
+        enqueue(ItemChanged, item, item.parentCollection().id(), false);
+}
+
+void MonitorImpl::onItemMoved(const Item &item, const Collection &source, const Collection &destination)
+{
+    // Also needed when moving away from a shown collection, otherwise
+    // the item would stay where it was. The payload is only needed if
+    // it ends up shown. It is queued behind the earlier notifications
+    // of the source collection.
+    auto sourceItem = item;
+    sourceItem.setParentCollection(source);
+    auto destinationItem = item;
+    destinationItem.setParentCollection(destination);
+
+    const bool shownAfter = isItemShown(destinationItem);
+    if (shownAfter || isItemShown(sourceItem))
+        enqueue(ItemMoved, destinationItem, source.id(), shownAfter);
+}
+
+void MonitorImpl::fetchPayloads()
+{
+    m_payloadFetchScheduled = false;
+
+    // One fetch per mime type since notes and todos don't
+    // need the same parts, with each item fetched only once
+    QHash<QString, PayloadFetch> fetches;
+    for (const auto &notification : m_payloadsToFetch) {
+        const auto mimeType = notification.item.mimeType();
+        auto &fetch = fetches[mimeType];
+        fetch.mimeType = mimeType;
+        fetch.serials[notification.item.id()] << notification.serial;
+        fetch.queues.insert(notification.queue);
+    }
+    m_payloadsToFetch.clear();
+
+    for (const auto &fetch : fetches)
+        startPayloadFetch(fetch);
+}
+
+void MonitorImpl::onPayloadsFetched(KJob *job)
+{
+    const auto fetch = m_payloadFetches.take(job);
+
+    // An item removed in the meantime fails the whole batch,
+    // fetch them one by one to find out which one it was
+    if (job->error() && fetch.serials.size() > 1) {
+        for (auto it = fetch.serials.constBegin(); it != fetch.serials.constEnd(); ++it) {
+            PayloadFetch single;
+            single.mimeType = fetch.mimeType;
+            single.serials.insert(it.key(), it.value());
+            single.queues = fetch.queues;
+            startPayloadFetch(single);
+        }
+        return;
+    }
+
+    QHash<Item::Id, Item> fetchedItems;
+    if (!job->error()) {
+        for (const auto &item : static_cast<ItemFetchJob*>(job)->items())
+            fetchedItems.insert(item.id(), item);
+    }
+
+    QHash<quint64, Item::Id> fetchedSerials;
+    for (auto it = fetch.serials.constBegin(); it != fetch.serials.constEnd(); ++it) {
+        for (auto serial : it.value())
+            fetchedSerials.insert(serial, it.key());
+    }
+
+    for (auto queue = fetch.queues.constBegin(); queue != fetch.queues.constEnd(); ++queue) {
+        auto &notifications = m_notifications[*queue];
+
+        auto it = notifications.begin();
+        while (it != notifications.end()) {
+            if (!it->waitsForPayload || !fetchedSerials.contains(it->serial)) {
+                ++it;
+                continue;
+            }
+
+            const auto id = fetchedSerials.value(it->serial);
+            if (fetchedItems.contains(id)) {
+                it->item = fetchedItems.value(id);
+                it->waitsForPayload = false;
+                ++it;
+            } else {
+                // Most likely removed in the meantime, its removal is queued behind
+                it = notifications.erase(it);
+            }
+        }
+
+        emitReadyNotifications(*queue);
+    }
+}
+
+bool MonitorImpl::isItemShown(const Item &item) const
+{
+    return !m_itemFilter || m_itemFilter(item);
+}
+
+void MonitorImpl::enqueue(NotificationType type, const Item &item, Collection::Id queue, bool fetchPayload)
+{
+    Notification notification = { type, item, m_nextSerial++, queue, fetchPayload };
+
+    // The payloads of the items notified during an event loop
+    // turn get fetched together on the next one
+    if (fetchPayload) {
+        m_payloadsToFetch << notification;
+        if (!m_payloadFetchScheduled) {
+            m_payloadFetchScheduled = true;
+            QTimer::singleShot(0, this, SLOT(fetchPayloads()));
+        }
+    }
+
+    // Notifications are queued so that they keep their order even though
+    // some wait for a payload and some don't. There is one queue per
+    // collection, a slow fetch only holds back the ones of its collection.
+    m_notifications[queue] << notification;
+    emitReadyNotifications(queue);
+}
+
+void MonitorImpl::startPayloadFetch(const PayloadFetch &fetch)
+{
+    Item::List items;
+    for (auto id : fetch.serials.keys())
+        items << Item(id);
+
+    // Same scope as the lists, the items end up next to theirs
+    auto job = new ItemFetchJob(items, this);
+    job->setFetchScope(Storage::listFetchScope(QStringList() << fetch.mimeType));
+    connect(job, SIGNAL(result(KJob*)), this, SLOT(onPayloadsFetched(KJob*)));
+    m_payloadFetches.insert(job, fetch);
+}
+
+void MonitorImpl::emitReadyNotifications(Collection::Id queue)
+{
+    // Emitting might lead to more notifications, the queue is
+    // looked up again each time since the hash might have changed
+    forever {
+        auto it = m_notifications.find(queue);
+        if (it == m_notifications.end())
+            return;
+
+        if (it->isEmpty()) {
+            m_notifications.erase(it);
+            return;
+        }
+
+        if (it->first().waitsForPayload)
+            return;
+
+        const auto notification = it->takeFirst();
+
+        switch (notification.type) {
+        case ItemAdded:
+            emit itemAdded(notification.item);
+            break;
+        case ItemRemoved:
+            emit itemRemoved(notification.item);
+            break;
+        case ItemChanged:
+            emit itemChanged(notification.item);
+            break;
+        case ItemMoved:
+            emit itemMoved(notification.item);
+            break;
+        }
+    }
+}
+
 bool MonitorImpl::hasSupportedMimeTypes(const Collection &collection)
 {
     QSet<QString> mimeIntersection = m_monitor->mimeTypesMonitored().toSet();
@@ -24,8 +24,19 @@
 #ifndef AKONADI_MONITORIMPL_H
 #define AKONADI_MONITORIMPL_H
 
+#include <functional>
+
+#include <QHash>
+#include <QList>
+#include <QSet>
+
+#include <Akonadi/Collection>
+#include <Akonadi/Item>
+
 #include "akonadimonitorinterface.h"
 
+class KJob;
+
 namespace Akonadi {
 
 class Monitor;
@@ -34,15 +45,62 @@ class MonitorImpl : public MonitorInterface
 {
     Q_OBJECT
 public:
+    // Tells if an item might be shown somewhere, only those get their
+    // payload fetched and get notified as added, changed or moved
+    typedef std::function<bool(const Akonadi::Item &)> ItemFilter;
+
     MonitorImpl();
     virtual ~MonitorImpl();
 
+    void setItemFilter(const ItemFilter &filter);
+
 private slots:
     void onCollectionChanged(const Akonadi::Collection &collection, const QSet<QByteArray> &parts);
+    void onCollectionMoved(const Akonadi::Collection &collection, const Akonadi::Collection &source, const Akonadi::Collection &destination);
+
+    void onItemAdded(const Akonadi::Item &item);
+    void onItemRemoved(const Akonadi::Item &item);
+    void onItemChanged(const Akonadi::Item &item, const QSet<QByteArray> &parts);
+    void onItemMoved(const Akonadi::Item &item, const Akonadi::Collection &source, const Akonadi::Collection &destination);
+    void fetchPayloads();
+    void onPayloadsFetched(KJob *job);
 
 private:
+    enum NotificationType {
+        ItemAdded,
+        ItemRemoved,
+        ItemChanged,
+        ItemMoved
+    };
+
+    struct Notification {
+        NotificationType type;
+        Item item;
+        quint64 serial;
+        Collection::Id queue;
+        bool waitsForPayload;
+    };
+
+    struct PayloadFetch {
+        QString mimeType;
+        QHash<Item::Id, QList<quint64>> serials;
+        QSet<Collection::Id> queues;
+    };
+
     bool hasSupportedMimeTypes(const Collection &collection);
+    bool isItemShown(const Item &item) const;
+    void enqueue(NotificationType type, const Item &item, Collection::Id queue, bool fetchPayload);
+    void startPayloadFetch(const PayloadFetch &fetch);
+    void emitReadyNotifications(Collection::Id queue);
+
     Akonadi::Monitor *m_monitor;
+    ItemFilter m_itemFilter;
+    QHash<Collection::Id, QList<Notification>> m_notifications;
+    quint64 m_nextSerial;
+
+    QList<Notification> m_payloadsToFetch;
+    bool m_payloadFetchScheduled;
+    QHash<KJob *, PayloadFetch> m_payloadFetches;
 };
 
 }
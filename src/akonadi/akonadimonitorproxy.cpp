@@ -0,0 +1,67 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#include "akonadimonitorproxy.h"
+
+#include "akonadimonitorimpl.h"
+
+#include "utils/dependencymanager.h"
+
+using namespace Akonadi;
+
+MonitorProxy::MonitorProxy(MonitorInterface *source)
+    : m_source(source)
+{
+    connect(m_source, SIGNAL(collectionAdded(Akonadi::Collection)), this, SIGNAL(collectionAdded(Akonadi::Collection)));
+    connect(m_source, SIGNAL(collectionRemoved(Akonadi::Collection)), this, SIGNAL(collectionRemoved(Akonadi::Collection)));
+    connect(m_source, SIGNAL(collectionChanged(Akonadi::Collection)), this, SIGNAL(collectionChanged(Akonadi::Collection)));
+    connect(m_source, SIGNAL(collectionSelectionChanged(Akonadi::Collection)), this, SIGNAL(collectionSelectionChanged(Akonadi::Collection)));
+
+    connect(m_source, SIGNAL(itemAdded(Akonadi::Item)), this, SIGNAL(itemAdded(Akonadi::Item)));
+    connect(m_source, SIGNAL(itemRemoved(Akonadi::Item)), this, SIGNAL(itemRemoved(Akonadi::Item)));
+    connect(m_source, SIGNAL(itemChanged(Akonadi::Item)), this, SIGNAL(itemChanged(Akonadi::Item)));
+    connect(m_source, SIGNAL(itemMoved(Akonadi::Item)), this, SIGNAL(itemMoved(Akonadi::Item)));
+
+    connect(m_source, SIGNAL(tagAdded(Akonadi::Tag)), this, SIGNAL(tagAdded(Akonadi::Tag)));
+    connect(m_source, SIGNAL(tagRemoved(Akonadi::Tag)), this, SIGNAL(tagRemoved(Akonadi::Tag)));
+    connect(m_source, SIGNAL(tagChanged(Akonadi::Tag)), this, SIGNAL(tagChanged(Akonadi::Tag)));
+}
+
+MonitorProxy::~MonitorProxy()
+{
+}
+
+MonitorInterface *MonitorProxy::source() const
+{
+    return m_source;
+}
+
+MonitorInterface *MonitorProxy::sharedMonitor()
+{
+    // The application registers it, so can the tests to replace it,
+    // the others get the default one
+    auto &deps = Utils::DependencyManager::globalInstance();
+    if (!deps.contains<MonitorImpl>())
+        deps.add<MonitorImpl, MonitorImpl>(Utils::DependencyManager::UniqueInstance);
+    return deps.create<MonitorImpl>();
+}
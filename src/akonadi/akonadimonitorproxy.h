@@ -0,0 +1,50 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#ifndef AKONADI_MONITORPROXY_H
+#define AKONADI_MONITORPROXY_H
+
+#include "akonadimonitorinterface.h"
+
+namespace Akonadi {
+
+class MonitorProxy : public MonitorInterface
+{
+    Q_OBJECT
+public:
+    explicit MonitorProxy(MonitorInterface *source = sharedMonitor());
+    virtual ~MonitorProxy();
+
+    MonitorInterface *source() const;
+
+    // The process wide monitor, notifications are fetched there only once.
+    // It is the MonitorImpl unique instance of Utils::DependencyManager.
+    static MonitorInterface *sharedMonitor();
+
+private:
+    MonitorInterface *m_source;
+};
+
+}
+
+#endif // AKONADI_MONITORPROXY_H
@@ -26,10 +26,12 @@
 
 #include "akonadicollectionfetchjobinterface.h"
 #include "akonadiitemfetchjobinterface.h"
-#include "akonadimonitorimpl.h"
+#include "akonadilivequeryhelpers.h"
+#include "akonadimonitorinterface.h"
 #include "akonadiserializer.h"
 #include "akonadistorage.h"
 
+#include "utils/dependencymanager.h"
 #include "utils/jobhandler.h"
 
 using namespace Akonadi;
@@ -37,7 +39,7 @@ using namespace Akonadi;
 NoteQueries::NoteQueries()
     : m_storage(new Storage),
       m_serializer(new Serializer),
-      m_monitor(new MonitorImpl),
+      m_monitor(Utils::DependencyManager::globalInstance().create<MonitorInterface>()),
       m_ownInterfaces(true)
 {
     connect(m_monitor, SIGNAL(itemAdded(Akonadi::Item)), this, SLOT(onItemAdded(Akonadi::Item)));
@@ -73,7 +75,7 @@ NoteQueries::NoteResult::Ptr NoteQueries::findAll() const
             self->m_findAll = self->createNoteQuery();
         }
 
-        m_findAll->setFetchFunction([this] (const NoteQuery::AddFunction &add) {
+        m_findAll->setRangeFetchFunction([this] (const NoteQuery::AddRangeFunction &add) {
             CollectionFetchJobInterface *job = m_storage->fetchCollections(Akonadi::Collection::root(),
                                                                            StorageInterface::Recursive,
                                                                            StorageInterface::Notes);
@@ -83,14 +85,7 @@ NoteQueries::NoteResult::Ptr NoteQueries::findAll() const
 
                 for (auto collection : job->collections()) {
                     ItemFetchJobInterface *job = m_storage->fetchItems(collection);
-                    Utils::JobHandler::install(job->kjob(), [this, job, add] {
-                        if (job->kjob()->error() != KJob::NoError)
-                            return;
-
-                        for (auto item : job->items()) {
-                            add(item);
-                        }
-                    });
+                    job->installItemsReceivedHandler(add);
                 }
             });
         });
@@ -98,6 +93,9 @@ NoteQueries::NoteResult::Ptr NoteQueries::findAll() const
         m_findAll->setConvertFunction([this] (const Akonadi::Item &item) {
             return m_serializer->createNoteFromItem(item);
         });
+        m_findAll->setRangeConvertFunction([this] (const Akonadi::Item::List &items) {
+            return m_serializer->createNotesFromItems(items);
+        });
         m_findAll->setUpdateFunction([this] (const Akonadi::Item &item, Domain::Note::Ptr &note) {
             m_serializer->updateNoteFromItem(note, item);
         });
@@ -107,11 +105,15 @@ NoteQueries::NoteResult::Ptr NoteQueries::findAll() const
         m_findAll->setRepresentsFunction([this] (const Akonadi::Item &item, const Domain::Note::Ptr &note) {
             return m_serializer->representsItem(note, item);
         });
+        m_findAll->setKeyFunction([] (const Akonadi::Item &item) {
+            return item.id();
+        });
     }
 
     return m_findAll->result();
 }
 
+// findAll() is the only note query, nothing to route.
 void NoteQueries::onItemAdded(const Item &item)
 {
     foreach (const NoteQuery::Ptr &query, m_noteQueries)
@@ -133,6 +135,8 @@ void NoteQueries::onItemChanged(const Item &item)
 NoteQueries::NoteQuery::Ptr NoteQueries::createNoteQuery()
 {
     auto query = NoteQueries::NoteQuery::Ptr::create();
+    LiveQueryHelpers::attachJobOwner(query);
+    query->setBatchingEnabled(true);
     m_noteQueries << query;
     return query;
 }
@@ -31,7 +31,10 @@
 #include "akonadistorage.h"
 #include "akonadistoragesettings.h"
 
+#include "utils/compositejob.h"
+
 using namespace Akonadi;
+using namespace Utils;
 
 NoteRepository::NoteRepository(QObject *parent)
     : QObject(parent),
@@ -92,6 +95,28 @@ KJob *NoteRepository::createInTag(Domain::Note::Ptr note, Domain::Tag::Ptr tag)
 
 KJob *NoteRepository::save(Domain::Note::Ptr note)
 {
+    if (note->backendIdentity().isPartial()) {
+        // Writing the item as is would lose the body we never loaded,
+        // so load the note first and put back what the caller changed.
+        // An empty text only means the body wasn't there yet.
+        auto job = new CompositeJob();
+        auto loadJob = load(note);
+        const auto title = note->title();
+        const auto text = note->text();
+        job->install(loadJob, [loadJob, note, title, text, job, this] {
+            if (loadJob->error() != KJob::NoError)
+                return;
+
+            note->setTitle(title);
+            if (!text.isEmpty())
+                note->setText(text);
+            auto updateJob = m_storage->updateItem(m_serializer->createItemFromNote(note));
+            job->addSubjob(updateJob);
+            updateJob->start();
+        });
+        return job;
+    }
+
     auto item = m_serializer->createItemFromNote(note);
 
     if (item.isValid()) {
@@ -106,3 +131,21 @@ KJob *NoteRepository::remove(Domain::Note::Ptr note)
     auto item = m_serializer->createItemFromNote(note);
     return m_storage->removeItem(item);
 }
+
+KJob *NoteRepository::load(Domain::Note::Ptr note)
+{
+    auto item = m_serializer->createItemFromNote(note);
+    Q_ASSERT(item.isValid());
+
+    auto job = new CompositeJob();
+    ItemFetchJobInterface *fetchItemJob = m_storage->fetchItem(item);
+    job->install(fetchItemJob->kjob(), [fetchItemJob, note, this] {
+        if (fetchItemJob->kjob()->error() != KJob::NoError)
+            return;
+
+        Q_ASSERT(fetchItemJob->items().size() == 1);
+        m_serializer->updateNoteFromItem(note, fetchItemJob->items().first());
+    });
+
+    return job;
+}
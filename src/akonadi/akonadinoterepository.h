@@ -49,6 +49,8 @@ public:
     KJob *save(Domain::Note::Ptr note) Q_DECL_OVERRIDE;
     KJob *remove(Domain::Note::Ptr note) Q_DECL_OVERRIDE;
 
+    KJob *load(Domain::Note::Ptr note) Q_DECL_OVERRIDE;
+
 private:
     StorageInterface *m_storage;
     SerializerInterface *m_serializer;
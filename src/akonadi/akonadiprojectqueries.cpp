@@ -26,10 +26,12 @@
 
 #include "akonadicollectionfetchjobinterface.h"
 #include "akonadiitemfetchjobinterface.h"
-#include "akonadimonitorimpl.h"
+#include "akonadilivequeryhelpers.h"
+#include "akonadimonitorinterface.h"
 #include "akonadiserializer.h"
 #include "akonadistorage.h"
 
+#include "utils/dependencymanager.h"
 #include "utils/jobhandler.h"
 
 using namespace Akonadi;
@@ -38,13 +40,20 @@ ProjectQueries::ProjectQueries(QObject *parent)
     : QObject(parent),
       m_storage(new Storage),
       m_serializer(new Serializer),
-      m_monitor(new MonitorImpl),
+      m_monitor(Utils::DependencyManager::globalInstance().create<MonitorInterface>()),
       m_ownInterfaces(true)
 {
     connect(m_monitor, SIGNAL(itemAdded(Akonadi::Item)), this, SLOT(onItemAdded(Akonadi::Item)));
     connect(m_monitor, SIGNAL(itemRemoved(Akonadi::Item)), this, SLOT(onItemRemoved(Akonadi::Item)));
     connect(m_monitor, SIGNAL(itemChanged(Akonadi::Item)), this, SLOT(onItemChanged(Akonadi::Item)));
     connect(m_monitor, SIGNAL(collectionSelectionChanged(Akonadi::Collection)), this, SLOT(onCollectionSelectionChanged()));
+
+    m_artifactRouter.setRouteFunction([this] (const Akonadi::Item &item) {
+        return m_serializer->relatedUidFromItem(item);
+    });
+    m_artifactRouter.setKeyFunction([] (const Akonadi::Item &item) {
+        return item.id();
+    });
 }
 
 ProjectQueries::ProjectQueries(StorageInterface *storage, SerializerInterface *serializer, MonitorInterface *monitor)
@@ -57,6 +66,13 @@ ProjectQueries::ProjectQueries(StorageInterface *storage, SerializerInterface *s
     connect(monitor, SIGNAL(itemRemoved(Akonadi::Item)), this, SLOT(onItemRemoved(Akonadi::Item)));
     connect(monitor, SIGNAL(itemChanged(Akonadi::Item)), this, SLOT(onItemChanged(Akonadi::Item)));
     connect(m_monitor, SIGNAL(collectionSelectionChanged(Akonadi::Collection)), this, SLOT(onCollectionSelectionChanged()));
+
+    m_artifactRouter.setRouteFunction([this] (const Akonadi::Item &item) {
+        return m_serializer->relatedUidFromItem(item);
+    });
+    m_artifactRouter.setKeyFunction([] (const Akonadi::Item &item) {
+        return item.id();
+    });
 }
 
 ProjectQueries::~ProjectQueries()
@@ -76,7 +92,7 @@ ProjectQueries::ProjectResult::Ptr ProjectQueries::findAll() const
             self->m_findAll = self->createProjectQuery();
         }
 
-        m_findAll->setFetchFunction([this] (const ProjectQuery::AddFunction &add) {
+        m_findAll->setRangeFetchFunction([this] (const ProjectQuery::AddRangeFunction &add) {
             CollectionFetchJobInterface *job = m_storage->fetchCollections(Akonadi::Collection::root(),
                                                                            StorageInterface::Recursive,
                                                                            StorageInterface::Tasks);
@@ -89,14 +105,7 @@ ProjectQueries::ProjectResult::Ptr ProjectQueries::findAll() const
                         continue;
 
                     ItemFetchJobInterface *job = m_storage->fetchItems(collection);
-                    Utils::JobHandler::install(job->kjob(), [this, job, add] {
-                        if (job->kjob()->error() != KJob::NoError)
-                            return;
-
-                        for (auto item : job->items()) {
-                            add(item);
-                        }
-                    });
+                    job->installItemsReceivedHandler(add);
                 }
             });
         });
@@ -113,6 +122,9 @@ ProjectQueries::ProjectResult::Ptr ProjectQueries::findAll() const
         m_findAll->setRepresentsFunction([this] (const Akonadi::Item &item, const Domain::Project::Ptr &project) {
             return m_serializer->representsItem(project, item);
         });
+        m_findAll->setKeyFunction([] (const Akonadi::Item &item) {
+            return item.id();
+        });
     }
 
     return m_findAll->result();
@@ -126,11 +138,11 @@ ProjectQueries::ArtifactResult::Ptr ProjectQueries::findTopLevelArtifacts(Domain
 
         {
             ProjectQueries *self = const_cast<ProjectQueries*>(this);
-            query = self->createArtifactQuery();
+            query = self->createArtifactQuery(project->backendIdentity().uid());
             self->m_findTopLevel.insert(item.id(), query);
         }
 
-        query->setFetchFunction([this, item] (const ArtifactQuery::AddFunction &add) {
+        query->setRangeFetchFunction([this, item] (const ArtifactQuery::AddRangeFunction &add) {
             CollectionFetchJobInterface *job = m_storage->fetchCollections(Akonadi::Collection::root(),
                                                                            StorageInterface::Recursive,
                                                                            StorageInterface::Tasks | StorageInterface::Notes);
@@ -142,12 +154,12 @@ ProjectQueries::ArtifactResult::Ptr ProjectQueries::findTopLevelArtifacts(Domain
                     if (!m_serializer->isSelectedCollection(collection))
                         continue;
                     ItemFetchJobInterface *job = m_storage->fetchItems(collection);
-                    Utils::JobHandler::install(job->kjob(), [this, job, add] {
-                        if (job->kjob()->error() != KJob::NoError)
-                            return;
-
-                        for (auto item : job->items())
-                            add(item);
+                    job->installItemsReceivedHandler([this, add] (const Akonadi::Item::List &items) {
+                        // Remember where the fetched items live so that moving
+                        // them out of the project still reaches this query
+                        ProjectQueries *self = const_cast<ProjectQueries*>(this);
+                        self->m_artifactRouter.track(items);
+                        add(items);
                     });
                 }
             });
@@ -165,6 +177,9 @@ ProjectQueries::ArtifactResult::Ptr ProjectQueries::findTopLevelArtifacts(Domain
                 return Domain::Artifact::Ptr();
             }
         });
+        query->setRangeConvertFunction([this] (const Akonadi::Item::List &items) {
+            return m_serializer->createArtifactsFromItems(items);
+        });
         query->setUpdateFunction([this] (const Akonadi::Item &item, Domain::Artifact::Ptr &artifact) {
             if (auto task = artifact.dynamicCast<Domain::Task>()) {
                 m_serializer->updateTaskFromItem(task, item);
@@ -178,18 +193,22 @@ ProjectQueries::ArtifactResult::Ptr ProjectQueries::findTopLevelArtifacts(Domain
         query->setRepresentsFunction([this] (const Akonadi::Item &item, const Domain::Artifact::Ptr &artifact) {
             return m_serializer->representsItem(artifact, item);
         });
+        query->setKeyFunction([] (const Akonadi::Item &item) {
+            return item.id();
+        });
     }
 
     return m_findTopLevel.value(item.id())->result();
 }
 
+// findAll() spans every project so it is kept as broadcast, the top level
+// artifacts queries are routed by project uid.
 void ProjectQueries::onItemAdded(const Item &item)
 {
     foreach (const ProjectQuery::Ptr &query, m_projectQueries)
         query->onAdded(item);
 
-    foreach (const ArtifactQuery::Ptr &query, m_artifactQueries)
-        query->onAdded(item);
+    m_artifactRouter.onAdded(item);
 }
 
 void ProjectQueries::onItemRemoved(const Item &item)
@@ -197,8 +216,7 @@ void ProjectQueries::onItemRemoved(const Item &item)
     foreach (const ProjectQuery::Ptr &query, m_projectQueries)
         query->onRemoved(item);
 
-    foreach (const ArtifactQuery::Ptr &query, m_artifactQueries)
-        query->onRemoved(item);
+    m_artifactRouter.onRemoved(item);
 }
 
 void ProjectQueries::onItemChanged(const Item &item)
@@ -206,8 +224,7 @@ void ProjectQueries::onItemChanged(const Item &item)
     foreach (const ProjectQuery::Ptr &query, m_projectQueries)
         query->onChanged(item);
 
-    foreach (const ArtifactQuery::Ptr &query, m_artifactQueries)
-        query->onChanged(item);
+    m_artifactRouter.onChanged(item);
 }
 
 void ProjectQueries::onCollectionSelectionChanged()
@@ -219,13 +236,20 @@ void ProjectQueries::onCollectionSelectionChanged()
 ProjectQueries::ProjectQuery::Ptr ProjectQueries::createProjectQuery()
 {
     auto query = ProjectQueries::ProjectQuery::Ptr::create();
+    LiveQueryHelpers::attachJobOwner(query);
+    query->setBatchingEnabled(true);
     m_projectQueries << query;
     return query;
 }
 
-ProjectQueries::ArtifactQuery::Ptr ProjectQueries::createArtifactQuery()
+ProjectQueries::ArtifactQuery::Ptr ProjectQueries::createArtifactQuery(const QString &projectUid)
 {
     auto query = ProjectQueries::ArtifactQuery::Ptr::create();
-    m_artifactQueries << query;
+    LiveQueryHelpers::attachJobOwner(query);
+    query->setBatchingEnabled(true);
+    if (projectUid.isEmpty())
+        m_artifactRouter.addQuery(query);
+    else
+        m_artifactRouter.addQuery(projectUid, query);
     return query;
 }
@@ -27,6 +27,7 @@
 #include <KDE/Akonadi/Item>
 
 #include "domain/livequery.h"
+#include "domain/livequeryrouter.h"
 #include "domain/projectqueries.h"
 
 namespace Akonadi {
@@ -46,6 +47,7 @@ public:
     typedef Domain::LiveQuery<Akonadi::Item, Domain::Artifact::Ptr> ArtifactQuery;
     typedef Domain::QueryResultProvider<Domain::Artifact::Ptr> ArtifactProvider;
     typedef Domain::QueryResult<Domain::Artifact::Ptr> ArtifactResult;
+    typedef Domain::LiveQueryRouter<Akonadi::Item, Domain::Artifact::Ptr, QString> ArtifactRouter;
 
     explicit ProjectQueries(QObject *parent = 0);
     ProjectQueries(StorageInterface *storage, SerializerInterface *serializer, MonitorInterface *monitor);
@@ -62,7 +64,7 @@ private slots:
 
 private:
     ProjectQuery::Ptr createProjectQuery();
-    ArtifactQuery::Ptr createArtifactQuery();
+    ArtifactQuery::Ptr createArtifactQuery(const QString &projectUid);
 
     StorageInterface *m_storage;
     SerializerInterface *m_serializer;
@@ -73,7 +75,7 @@ private:
     ProjectQuery::List m_projectQueries;
 
     QHash<Akonadi::Entity::Id, ArtifactQuery::Ptr> m_findTopLevel;
-    ArtifactQuery::List m_artifactQueries;
+    ArtifactRouter m_artifactRouter;
 };
 
 }
@@ -25,6 +25,7 @@
 
 #include "akonadicollectionfetchjobinterface.h"
 #include "akonadiitemfetchjobinterface.h"
+#include "akonadilivequeryhelpers.h"
 #include "akonaditagfetchjobinterface.h"
 #include "akonadirelationfetchjobinterface.h"
 
@@ -63,6 +64,7 @@ RelationQueries::~RelationQueries()
 RelationQueries::RelationResult::Ptr RelationQueries::findRelations(Domain::Artifact::Ptr artifact) const
 {
     auto query =  RelationQueries::RelationQuery::Ptr::create();
+    LiveQueryHelpers::attachJobOwner(query);
     auto item = m_serializer->createItemFromArtifact(artifact);
     qDebug() << "looking for relations " << item.url();
 
@@ -28,6 +28,7 @@
 #include <Akonadi/Collection>
 #include <Akonadi/EntityDisplayAttribute>
 #include <Akonadi/Item>
+#include <Akonadi/KMime/MessageParts>
 #include <Akonadi/Notes/NoteUtils>
 #include <akonadi/collectionidentificationattribute.h>
 #include <KCalCore/Todo>
@@ -37,9 +38,27 @@
 #include "akonadi/akonaditimestampattribute.h"
 
 #include <QBitArray>
+#include <QQueue>
+#include <QtConcurrentMap>
 
 using namespace Akonadi;
 
+static const Domain::BackendIdentity *backendIdentity(QObject *object)
+{
+    if (auto artifact = qobject_cast<Domain::Artifact*>(object))
+        return &artifact->backendIdentity();
+    else if (auto project = qobject_cast<Domain::Project*>(object))
+        return &project->backendIdentity();
+    else if (auto dataSource = qobject_cast<Domain::DataSource*>(object))
+        return &dataSource->backendIdentity();
+    else if (auto context = qobject_cast<Domain::Context*>(object))
+        return &context->backendIdentity();
+    else if (auto tag = qobject_cast<Domain::Tag*>(object))
+        return &tag->backendIdentity();
+    else
+        return 0;
+}
+
 Serializer::Serializer()
 {
 }
@@ -50,22 +69,26 @@ Serializer::~Serializer()
 
 bool Serializer::representsCollection(SerializerInterface::QObjectPtr object, Collection collection)
 {
-    return object->property("collectionId").toLongLong() == collection.id();
+    const auto identity = backendIdentity(object.data());
+    return identity && identity->hasId() && identity->id() == collection.id();
 }
 
 bool Serializer::representsItem(QObjectPtr object, Item item)
 {
-    return object->property("itemId").toLongLong() == item.id();
+    const auto identity = backendIdentity(object.data());
+    return identity && identity->hasId() && identity->id() == item.id();
 }
 
 bool Serializer::representsAkonadiTag(Domain::Tag::Ptr tag, Tag akonadiTag) const
 {
-    return tag->property("tagId").toLongLong() == akonadiTag.id();
+    const auto &identity = tag->backendIdentity();
+    return identity.hasId() && identity.id() == akonadiTag.id();
 }
 
 QString Serializer::objectUid(SerializerInterface::QObjectPtr object)
 {
-    return object->property("todoUid").toString();
+    const auto identity = backendIdentity(object.data());
+    return identity ? identity->uid() : QString();
 }
 
 Domain::DataSource::Ptr Serializer::createDataSourceFromCollection(Collection collection, DataSourceNameScheme naming)
@@ -122,7 +145,7 @@ void Serializer::updateDataSourceFromCollection(Domain::DataSource::Ptr dataSour
     else
         dataSource->setListStatus(Domain::DataSource::Unlisted);
 
-    dataSource->setProperty("collectionId", collection.id());
+    dataSource->backendIdentity().setId(collection.id());
     dataSource->setProperty("collection", QVariant::fromValue(collection));
     dataSource->setPerson(isPersonCollection(collection));
     if (isPersonCollection(collection)) {
@@ -355,87 +378,205 @@ Domain::Recurrence::Frequency fromRecurrenceType(KCalCore::RecurrenceRule::Perio
     return Domain::Recurrence::Frequency::None;
 }
 
-Domain::Recurrence::Ptr fromKCalRecurrence(const KCalCore::Recurrence *rec)
+namespace {
+
+// Plain copies of the payload fields, they can be filled outside of the GUI thread
+struct RecurrenceRecord
 {
-    Domain::Recurrence recurrence;
+    RecurrenceRecord()
+        : allDay(false), interval(0), hasRule(false), duration(0),
+          weekStart(Domain::Recurrence::Monday),
+          frequency(Domain::Recurrence::None),
+          byDayPosition(Domain::Recurrence::All)
+    {
+    }
+
+    bool allDay;
+    int interval;
+    QList<QDateTime> recurrenceDates;
+    QList<QDateTime> exceptionDates;
+
+    bool hasRule;
+    int duration;
+    QDateTime end;
+    Domain::Recurrence::Weekday weekStart;
+    Domain::Recurrence::Frequency frequency;
+    QList<int> bysecond;
+    QList<int> byminute;
+    QList<int> byhour;
+    QList<int> bymonthday;
+    QList<int> byyearday;
+    QList<int> byweekno;
+    QList<int> bymonth;
+    Domain::Recurrence::WeekPosition byDayPosition;
+    QList<Domain::Recurrence::Weekday> byday;
+};
+
+struct TaskRecord
+{
+    TaskRecord()
+        : id(-1), parentId(-1), progress(0), status(Domain::Task::None),
+          hasDelegate(false), recurs(false)
+    {
+    }
+
+    KCalCore::Todo::Ptr todo;
+    Akonadi::Item::Id id;
+    Akonadi::Collection::Id parentId;
+
+    QString title;
+    QString text;
+    QDateTime startDate;
+    QDateTime dueDate;
+    QString uid;
+    QString relatedUid;
+    int progress;
+    Domain::Task::Status status;
+    bool hasDelegate;
+    Domain::Task::Delegate delegate;
+    bool recurs;
+    RecurrenceRecord recurrence;
+};
+
+struct NoteRecord
+{
+    NoteRecord()
+        : id(-1),
+          partial(false)
+    {
+    }
+
+    KMime::Message::Ptr message;
+    Akonadi::Item::Id id;
+    bool partial;
 
-    recurrence.setAllDay(rec->allDay());
-    recurrence.setInterval(rec->frequency());
+    QString title;
+    QString text;
+    QString relatedUid;
+};
+
+}
+
+// Below that size spreading the work over the thread pool costs more than it saves
+static const int parallelExtractionThreshold = 64;
+
+template<typename Record, typename Function>
+static void extractRecords(QList<Record> &records, Function extract)
+{
+    if (records.size() < parallelExtractionThreshold) {
+        for (auto &record : records)
+            extract(record);
+    } else {
+        QtConcurrent::blockingMap(records, extract);
+    }
+}
+
+static void extractRecurrenceRecord(const KCalCore::Recurrence *rec, RecurrenceRecord &record)
+{
+    record.allDay = rec->allDay();
+    record.interval = rec->frequency();
 
-    QList<QDateTime> rdates;
     foreach (const KDateTime &dt, rec->rDateTimes()) {
-        rdates.append(dt.dateTime());
+        record.recurrenceDates.append(dt.dateTime());
     }
     foreach (const QDate &dt, rec->rDates()) {
-        rdates.append(QDateTime(dt));
+        record.recurrenceDates.append(QDateTime(dt));
     }
-    recurrence.setRecurrenceDates(rdates);
 
-    QList<QDateTime> exdates;
     foreach (const KDateTime &dt, rec->exDateTimes()) {
-        exdates.append(dt.dateTime());
+        record.exceptionDates.append(dt.dateTime());
     }
     foreach (const QDate &dt, rec->exDates()) {
-        exdates.append(QDateTime(dt));
+        record.exceptionDates.append(QDateTime(dt));
     }
-    recurrence.setExceptionDates(exdates);
 
     const KCalCore::RecurrenceRule *defaultRR = rec->defaultRRuleConst();
 
     if (defaultRR) {
-        if (defaultRR->duration() != 0) { //Inidcates if end date is set or not
-            if (defaultRR->duration() > 0) {
-                recurrence.setCount(defaultRR->duration());
-            } else if (defaultRR->duration() == -1) { //infinite duration
-                recurrence.setCount(-1);
-            }
-        } else {
-            recurrence.setEnd(defaultRR->endDt().dateTime());
-        }
-        recurrence.setWeekStart(fromWeekDay(defaultRR->weekStart()));
-        recurrence.setFrequency(fromRecurrenceType(defaultRR->recurrenceType()));
-
-        recurrence.setBysecond(defaultRR->bySeconds());
-        recurrence.setByminute(defaultRR->byMinutes());
-        recurrence.setByhour(defaultRR->byHours());
-        recurrence.setBymonthday(defaultRR->byMonthDays());
-        recurrence.setByyearday(defaultRR->byYearDays());
-        recurrence.setByweekno(defaultRR->byWeekNumbers());
-        recurrence.setBymonth(defaultRR->byMonths());
-
-        QList<Domain::Recurrence::Weekday> daypos;
+        record.hasRule = true;
+        record.duration = defaultRR->duration();
+        if (record.duration == 0) //Inidcates if end date is set or not
+            record.end = defaultRR->endDt().dateTime();
+        record.weekStart = fromWeekDay(defaultRR->weekStart());
+        record.frequency = fromRecurrenceType(defaultRR->recurrenceType());
+
+        record.bysecond = defaultRR->bySeconds();
+        record.byminute = defaultRR->byMinutes();
+        record.byhour = defaultRR->byHours();
+        record.bymonthday = defaultRR->byMonthDays();
+        record.byyearday = defaultRR->byYearDays();
+        record.byweekno = defaultRR->byWeekNumbers();
+        record.bymonth = defaultRR->byMonths();
+
         const auto positions = rec->monthPositions();
         if (!positions.isEmpty()) {
-            recurrence.setByDayPosition((Domain::Recurrence::WeekPosition) positions.at(0).pos());
+            record.byDayPosition = (Domain::Recurrence::WeekPosition) positions.at(0).pos();
             for (int i = positions.size()-1; i > -1; i--) {
-                if (positions.at(i).pos() == recurrence.byDayPosition()) {
-                    daypos.append((Domain::Recurrence::Weekday) (Domain::Recurrence::Monday + positions.at(i).day() - 1));
+                if (positions.at(i).pos() == record.byDayPosition) {
+                    record.byday.append((Domain::Recurrence::Weekday) (Domain::Recurrence::Monday + positions.at(i).day() - 1));
                 }
             }
         }
-        recurrence.setByday(daypos);
+    }
+}
+
+// Being a QObject, the recurrence is only created in the thread using it
+static Domain::Recurrence::Ptr createRecurrence(const RecurrenceRecord &record)
+{
+    auto recurrence = Domain::Recurrence::Ptr::create();
+
+    recurrence->setAllDay(record.allDay);
+    recurrence->setInterval(record.interval);
+    recurrence->setRecurrenceDates(record.recurrenceDates);
+    recurrence->setExceptionDates(record.exceptionDates);
+
+    if (record.hasRule) {
+        if (record.duration > 0) {
+            recurrence->setCount(record.duration);
+        } else if (record.duration == -1) { //infinite duration
+            recurrence->setCount(-1);
+        } else if (record.duration == 0) {
+            recurrence->setEnd(record.end);
+        }
+        recurrence->setWeekStart(record.weekStart);
+        recurrence->setFrequency(record.frequency);
+
+        recurrence->setBysecond(record.bysecond);
+        recurrence->setByminute(record.byminute);
+        recurrence->setByhour(record.byhour);
+        recurrence->setBymonthday(record.bymonthday);
+        recurrence->setByyearday(record.byyearday);
+        recurrence->setByweekno(record.byweekno);
+        recurrence->setBymonth(record.bymonth);
+
+        recurrence->setByDayPosition(record.byDayPosition);
+        recurrence->setByday(record.byday);
     }
 
-    return Domain::Recurrence::Ptr(new Domain::Recurrence(recurrence));
+    return recurrence;
 }
 
-void Serializer::updateTaskFromItem(Domain::Task::Ptr task, Item item)
+static TaskRecord taskRecordFromItem(const Item &item)
 {
-    if (!isTaskItem(item))
-        return;
+    TaskRecord record;
+    record.todo = item.payload<KCalCore::Todo::Ptr>();
+    record.id = item.id();
+    record.parentId = item.parentCollection().id();
+    return record;
+}
 
-    auto todo = item.payload<KCalCore::Todo::Ptr>();
+static void extractTaskRecord(TaskRecord &record)
+{
+    const auto todo = record.todo;
 
-    task->setTitle(todo->summary());
-    task->setText(todo->description());
-    task->setStartDate(todo->dtStart().dateTime());
-    task->setDueDate(todo->dtDue().dateTime());
-    task->setProperty("itemId", item.id());
-    task->setProperty("parentCollectionId", item.parentCollection().id());
-    task->setProperty("todoUid", todo->uid());
-    task->setProperty("relatedUid", todo->relatedTo());
-    task->setProgress(todo->percentComplete());
-    task->setStatus(fromKCalStatus(todo->status()));
+    record.title = todo->summary();
+    record.text = todo->description();
+    record.startDate = todo->dtStart().dateTime();
+    record.dueDate = todo->dtDue().dateTime();
+    record.uid = todo->uid();
+    record.relatedUid = todo->relatedTo();
+    record.progress = todo->percentComplete();
+    record.status = fromKCalStatus(todo->status());
 
     if (todo->attendeeCount() > 0) {
         const auto attendees = todo->attendees();
@@ -444,27 +585,161 @@ void Serializer::updateTaskFromItem(Domain::Task::Ptr task, Item item)
                                                return attendee->status() == KCalCore::Attendee::Delegated;
                                            });
         if (delegate != attendees.end()) {
-            task->setDelegate(Domain::Task::Delegate((*delegate)->name(), (*delegate)->email()));
+            record.hasDelegate = true;
+            record.delegate = Domain::Task::Delegate((*delegate)->name(), (*delegate)->email());
         }
     }
     if (todo->recurs()) {
-        Domain::Recurrence::Ptr recurrence(fromKCalRecurrence(todo->recurrence()));
-        task->setRecurrence(recurrence);
-        if (task->status() == Domain::Task::Complete) {
-            task->setStatus(Domain::Task::FullComplete);
+        record.recurs = true;
+        extractRecurrenceRecord(todo->recurrence(), record.recurrence);
+        if (record.status == Domain::Task::Complete) {
+            record.status = Domain::Task::FullComplete;
         }
-    } else {
-        task->setRecurrence(Domain::Recurrence::Ptr(0));
     }
 }
 
+static void applyTaskRecord(const Domain::Task::Ptr &task, const TaskRecord &record)
+{
+    task->setTitle(record.title);
+    task->setText(record.text);
+    task->setStartDate(record.startDate);
+    task->setDueDate(record.dueDate);
+    auto &identity = task->backendIdentity();
+    identity.setId(record.id);
+    identity.setParentId(record.parentId);
+    identity.setUid(record.uid);
+    identity.setRelatedUid(record.relatedUid);
+    task->setProgress(record.progress);
+    task->setStatus(record.status);
+    if (record.hasDelegate)
+        task->setDelegate(record.delegate);
+    task->setRecurrence(record.recurs ? createRecurrence(record.recurrence) : Domain::Recurrence::Ptr());
+}
+
+static NoteRecord noteRecordFromItem(const Item &item)
+{
+    NoteRecord record;
+    record.message = item.payload<KMime::Message::Ptr>();
+    record.id = item.id();
+
+    // Lists only fetch the headers of the notes
+    const auto parts = item.loadedPayloadParts();
+    record.partial = !parts.contains(Item::FullPayload) && !parts.contains(MessagePart::Body);
+    return record;
+}
+
+static void extractNoteRecord(NoteRecord &record)
+{
+    NoteUtils::NoteMessageWrapper wrappedNote(record.message);
+
+    record.title = wrappedNote.title();
+    record.text = wrappedNote.text();
+
+    if (auto relatedHeader = record.message->headerByType("X-Zanshin-RelatedProjectUid")) {
+        record.relatedUid = relatedHeader->asUnicodeString();
+    }
+}
+
+static void applyNoteRecord(const Domain::Note::Ptr &note, const NoteRecord &record)
+{
+    note->setTitle(record.title);
+    note->setText(record.text);
+    auto &identity = note->backendIdentity();
+    identity.setId(record.id);
+    identity.setRelatedUid(record.relatedUid);
+    identity.setPartial(record.partial);
+}
+
+void Serializer::updateTaskFromItem(Domain::Task::Ptr task, Item item)
+{
+    if (!isTaskItem(item))
+        return;
+
+    auto record = taskRecordFromItem(item);
+    extractTaskRecord(record);
+    applyTaskRecord(task, record);
+}
+
+Domain::Task::List Serializer::createTasksFromItems(const Item::List &items)
+{
+    // Payloads are only touched from this thread, the field extraction
+    // happens in the thread pool and the tasks are built back here
+    QList<TaskRecord> records;
+    QVector<int> recordForItem(items.size(), -1);
+    for (int i = 0; i < items.size(); i++) {
+        if (!isTaskItem(items.at(i)))
+            continue;
+
+        recordForItem[i] = records.size();
+        records << taskRecordFromItem(items.at(i));
+    }
+
+    extractRecords(records, extractTaskRecord);
+
+    Domain::Task::List tasks;
+    tasks.reserve(items.size());
+    for (int recordIndex : recordForItem) {
+        if (recordIndex < 0) {
+            tasks << Domain::Task::Ptr();
+            continue;
+        }
+
+        auto task = Domain::Task::Ptr::create();
+        applyTaskRecord(task, records.at(recordIndex));
+        tasks << task;
+    }
+    return tasks;
+}
+
+Domain::Artifact::List Serializer::createArtifactsFromItems(const Item::List &items)
+{
+    QList<TaskRecord> taskRecords;
+    QList<NoteRecord> noteRecords;
+    QVector<int> taskRecordForItem(items.size(), -1);
+    QVector<int> noteRecordForItem(items.size(), -1);
+    for (int i = 0; i < items.size(); i++) {
+        const auto &item = items.at(i);
+        if (isTaskItem(item)) {
+            taskRecordForItem[i] = taskRecords.size();
+            taskRecords << taskRecordFromItem(item);
+        } else if (isNoteItem(item)) {
+            noteRecordForItem[i] = noteRecords.size();
+            noteRecords << noteRecordFromItem(item);
+        }
+    }
+
+    extractRecords(taskRecords, extractTaskRecord);
+    extractRecords(noteRecords, extractNoteRecord);
+
+    Domain::Artifact::List artifacts;
+    artifacts.reserve(items.size());
+    for (int i = 0; i < items.size(); i++) {
+        if (taskRecordForItem.at(i) >= 0) {
+            auto task = Domain::Task::Ptr::create();
+            applyTaskRecord(task, taskRecords.at(taskRecordForItem.at(i)));
+            artifacts << task;
+        } else if (noteRecordForItem.at(i) >= 0) {
+            auto note = Domain::Note::Ptr::create();
+            applyNoteRecord(note, noteRecords.at(noteRecordForItem.at(i)));
+            artifacts << note;
+        } else {
+            artifacts << Domain::Artifact::Ptr();
+        }
+    }
+    return artifacts;
+}
+
 bool Serializer::isTaskChild(Domain::Task::Ptr task, Akonadi::Item item)
 {
     if (!isTaskItem(item))
         return false;
 
+    const QString todoUid = task->backendIdentity().uid();
+    if (todoUid.isNull())
+        return false;
+
     auto todo = item.payload<KCalCore::Todo::Ptr>();
-    if (todo->relatedTo() == task->property("todoUid"))
+    if (todo->relatedTo() == todoUid)
         return true;
 
     return false;
@@ -549,12 +824,13 @@ Akonadi::Item Serializer::createItemFromTask(Domain::Task::Ptr task)
         updateKCalRecurrence(task->recurrence(), todo->recurrence());
     }
 
-    if (task->property("todoUid").isValid()) {
-        todo->setUid(task->property("todoUid").toString());
+    const auto &identity = task->backendIdentity();
+    if (!identity.uid().isNull()) {
+        todo->setUid(identity.uid());
     }
 
-    if (task->property("relatedUid").isValid()) {
-        todo->setRelatedTo(task->property("relatedUid").toString());
+    if (!identity.relatedUid().isNull()) {
+        todo->setRelatedTo(identity.relatedUid());
     }
 
     if (task->delegate().isValid()) {
@@ -566,12 +842,13 @@ Akonadi::Item Serializer::createItemFromTask(Domain::Task::Ptr task)
     }
 
     Akonadi::Item item;
-    if (task->property("itemId").isValid()) {
-        item.setId(task->property("itemId").value<Akonadi::Item::Id>());
+    if (identity.hasId()) {
+        item.setId(identity.id());
     }
     item.setMimeType(KCalCore::Todo::todoMimeType());
     item.setPayload(todo);
-    item.setParentCollection(Akonadi::Collection(task->property("parentCollectionId").value<Akonadi::Collection::Id>()));
+    // Tasks not stored yet go below the root
+    item.setParentCollection(Akonadi::Collection(identity.hasParentId() ? identity.parentId() : 0));
     return item;
 }
 
@@ -597,19 +874,19 @@ void Serializer::updateItemParent(Akonadi::Item item, Domain::Task::Ptr parent)
         return;
 
     auto todo = item.payload<KCalCore::Todo::Ptr>();
-    todo->setRelatedTo(parent->property("todoUid").toString());
+    todo->setRelatedTo(parent->backendIdentity().uid());
 }
 
 void Serializer::updateItemProject(Item item, Domain::Project::Ptr project)
 {
     if (isTaskItem(item)) {
         auto todo = item.payload<KCalCore::Todo::Ptr>();
-        todo->setRelatedTo(project->property("todoUid").toString());
+        todo->setRelatedTo(project->backendIdentity().uid());
 
     } else if (isNoteItem(item)) {
         auto note = item.payload<KMime::Message::Ptr>();
         note->removeHeader("X-Zanshin-RelatedProjectUid");
-        const QByteArray parentUid = project->property("todoUid").toString().toUtf8();
+        const QByteArray parentUid = project->backendIdentity().uid().toUtf8();
         if (!parentUid.isEmpty()) {
             auto relatedHeader = new KMime::Headers::Generic("X-Zanshin-RelatedProjectUid");
             relatedHeader->from7BitString(parentUid);
@@ -633,26 +910,40 @@ Akonadi::Item::List Serializer::filterDescendantItems(const Akonadi::Item::List
     if (potentialChildren.isEmpty())
         return Akonadi::Item::List();
 
-    Akonadi::Item::List itemsToProcess = potentialChildren;
     Q_ASSERT(ancestorItem.isValid() && ancestorItem.hasPayload<KCalCore::Todo::Ptr>());
     KCalCore::Todo::Ptr todo = ancestorItem.payload<KCalCore::Todo::Ptr>();
 
-    const auto bound = std::partition(itemsToProcess.begin(), itemsToProcess.end(),
-                                      [ancestorItem, todo](Akonadi::Item currentItem) {
-                                          return (!currentItem.hasPayload<KCalCore::Todo::Ptr>()
-                                               || currentItem == ancestorItem
-                                               || currentItem.payload<KCalCore::Todo::Ptr>()->relatedTo() != todo->uid());
-                                      });
-
-    Akonadi::Item::List itemsRemoved;
-    std::copy(itemsToProcess.begin(), bound, std::back_inserter(itemsRemoved));
-    itemsToProcess.erase(itemsToProcess.begin(), bound);
+    // Index the candidates by the uid of their parent in one pass, then walk
+    // down from the ancestor breadth first
+    typedef QPair<Akonadi::Item, QString> ItemWithUid;
+    QHash<QString, QList<ItemWithUid>> childrenForUid;
+    childrenForUid.reserve(potentialChildren.size());
+    for (const auto &item : potentialChildren) {
+        if (item == ancestorItem || !item.hasPayload<KCalCore::Todo::Ptr>())
+            continue;
+
+        auto childTodo = item.payload<KCalCore::Todo::Ptr>();
+        childrenForUid[childTodo->relatedTo()] << ItemWithUid(item, childTodo->uid());
+    }
 
-    auto result = std::accumulate(itemsToProcess.begin(), itemsToProcess.end(), Akonadi::Item::List(),
-                                 [this, itemsRemoved](Akonadi::Item::List result, Akonadi::Item currentItem) {
-                                     result << currentItem;
-                                     return result += filterDescendantItems(itemsRemoved, currentItem);
-                                 });
+    Akonadi::Item::List result;
+    QSet<QString> visitedUids;
+    QQueue<QString> uidsToProcess;
+    visitedUids.insert(todo->uid());
+    uidsToProcess.enqueue(todo->uid());
+
+    while (!uidsToProcess.isEmpty()) {
+        const auto children = childrenForUid.take(uidsToProcess.dequeue());
+        for (const auto &child : children) {
+            result << child.first;
+
+            const auto &childUid = child.second;
+            if (!visitedUids.contains(childUid)) {
+                visitedUids.insert(childUid);
+                uidsToProcess.enqueue(childUid);
+            }
+        }
+    }
 
     return result;
 }
@@ -667,29 +958,61 @@ Domain::Note::Ptr Serializer::createNoteFromItem(Akonadi::Item item)
     if (!isNoteItem(item))
         return Domain::Note::Ptr();
 
+    auto record = noteRecordFromItem(item);
+    extractNoteRecord(record);
+
     Domain::Note::Ptr note = Domain::Note::Ptr::create();
-    updateNoteFromItem(note, item);
+    applyNoteRecord(note, record);
 
     return note;
 }
 
+Domain::Note::List Serializer::createNotesFromItems(const Item::List &items)
+{
+    QList<NoteRecord> records;
+    QVector<int> recordForItem(items.size(), -1);
+    for (int i = 0; i < items.size(); i++) {
+        if (!isNoteItem(items.at(i)))
+            continue;
+
+        recordForItem[i] = records.size();
+        records << noteRecordFromItem(items.at(i));
+    }
+
+    extractRecords(records, extractNoteRecord);
+
+    Domain::Note::List notes;
+    notes.reserve(items.size());
+    for (int recordIndex : recordForItem) {
+        if (recordIndex < 0) {
+            notes << Domain::Note::Ptr();
+            continue;
+        }
+
+        auto note = Domain::Note::Ptr::create();
+        applyNoteRecord(note, records.at(recordIndex));
+        notes << note;
+    }
+    return notes;
+}
+
 void Serializer::updateNoteFromItem(Domain::Note::Ptr note, Item item)
 {
     if (!isNoteItem(item))
         return;
 
-    auto message = item.payload<KMime::Message::Ptr>();
-    NoteUtils::NoteMessageWrapper wrappedNote(message);
+    auto record = noteRecordFromItem(item);
+    extractNoteRecord(record);
 
-    note->setTitle(wrappedNote.title());
-    note->setText(wrappedNote.text());
-    note->setProperty("itemId", item.id());
-
-    if (auto relatedHeader = message->headerByType("X-Zanshin-RelatedProjectUid")) {
-        note->setProperty("relatedUid", relatedHeader->asUnicodeString());
-    } else {
-        note->setProperty("relatedUid", QVariant());
+    // Notifications only bring the headers, a body loaded in the
+    // meantime (e.g. for the editor) stays until a full item comes in
+    const auto &identity = note->backendIdentity();
+    if (record.partial && !identity.isPartial() && identity.id() == record.id) {
+        record.text = note->text();
+        record.partial = false;
     }
+
+    applyNoteRecord(note, record);
 }
 
 Item Serializer::createItemFromNote(Domain::Note::Ptr note)
@@ -700,15 +1023,16 @@ Item Serializer::createItemFromNote(Domain::Note::Ptr note)
 
     KMime::Message::Ptr message = builder.message();
 
-    if (!note->property("relatedUid").toString().isEmpty()) {
+    const auto &identity = note->backendIdentity();
+    if (!identity.relatedUid().isEmpty()) {
         auto relatedHeader = new KMime::Headers::Generic("X-Zanshin-RelatedProjectUid");
-        relatedHeader->from7BitString(note->property("relatedUid").toString().toUtf8());
+        relatedHeader->from7BitString(identity.relatedUid().toUtf8());
         message->appendHeader(relatedHeader);
     }
 
     Akonadi::Item item;
-    if (note->property("itemId").isValid()) {
-        item.setId(note->property("itemId").value<Akonadi::Item::Id>());
+    if (identity.hasId()) {
+        item.setId(identity.id());
     }
     item.setMimeType(Akonadi::NoteUtils::noteMimeType());
     item.setPayload(message);
@@ -741,9 +1065,10 @@ void Serializer::updateProjectFromItem(Domain::Project::Ptr project, Item item)
     auto todo = item.payload<KCalCore::Todo::Ptr>();
 
     project->setName(todo->summary());
-    project->setProperty("itemId", item.id());
-    project->setProperty("parentCollectionId", item.parentCollection().id());
-    project->setProperty("todoUid", todo->uid());
+    auto &identity = project->backendIdentity();
+    identity.setId(item.id());
+    identity.setParentId(item.parentCollection().id());
+    identity.setUid(todo->uid());
 }
 
 Item Serializer::createItemFromProject(Domain::Project::Ptr project)
@@ -753,17 +1078,17 @@ Item Serializer::createItemFromProject(Domain::Project::Ptr project)
     todo->setSummary(project->name());
     todo->setCustomProperty("Zanshin", "Project", "1");
 
-    if (project->property("todoUid").isValid()) {
-        todo->setUid(project->property("todoUid").toString());
+    const auto &identity = project->backendIdentity();
+    if (!identity.uid().isNull()) {
+        todo->setUid(identity.uid());
     }
 
     Akonadi::Item item;
-    if (project->property("itemId").isValid()) {
-        item.setId(project->property("itemId").value<Akonadi::Item::Id>());
+    if (identity.hasId()) {
+        item.setId(identity.id());
     }
-    if (project->property("parentCollectionId").isValid()) {
-        auto parentId = project->property("parentCollectionId").value<Akonadi::Collection::Id>();
-        item.setParentCollection(Akonadi::Collection(parentId));
+    if (identity.hasParentId()) {
+        item.setParentCollection(Akonadi::Collection(identity.parentId()));
     }
     item.setMimeType(KCalCore::Todo::todoMimeType());
     item.setPayload(todo);
@@ -772,7 +1097,7 @@ Item Serializer::createItemFromProject(Domain::Project::Ptr project)
 
 bool Serializer::isProjectChild(Domain::Project::Ptr project, Item item)
 {
-    const QString todoUid = project->property("todoUid").toString();
+    const QString todoUid = project->backendIdentity().uid();
     const QString relatedUid = relatedUidFromItem(item);
 
     return !todoUid.isEmpty()
@@ -797,8 +1122,8 @@ Akonadi::Tag Serializer::createTagFromContext(Domain::Context::Ptr context)
     tag.setType(Akonadi::SerializerInterface::contextTagType());
     tag.setGid(QByteArray(context->name().toLatin1()));
 
-    if (context->property("tagId").isValid())
-        tag.setId(context->property("tagId").value<Akonadi::Tag::Id>());
+    if (context->backendIdentity().hasId())
+        tag.setId(context->backendIdentity().id());
 
     return tag;
 }
@@ -808,7 +1133,7 @@ void Serializer::updateContextFromTag(Domain::Context::Ptr context, Akonadi::Tag
     if (!isContext(tag))
         return;
 
-    context->setProperty("tagId", tag.id());
+    context->backendIdentity().setId(tag.id());
     context->setName(tag.name());
 }
 
@@ -840,16 +1165,16 @@ bool Serializer::isAkonadiTag(const Tag &tag) const
 
 bool Serializer::isContextTag(const Domain::Context::Ptr &context, const Akonadi::Tag &tag) const
 {
-    return (context->property("tagId").value<Akonadi::Tag::Id>() == tag.id());
+    const auto &identity = context->backendIdentity();
+    return identity.hasId() && identity.id() == tag.id();
 }
 
 bool Serializer::isContextChild(Domain::Context::Ptr context, Item item) const
 {
-    if (!context->property("tagId").isValid())
+    if (!context->backendIdentity().hasId())
         return false;
 
-    auto tagId = context->property("tagId").value<Akonadi::Tag::Id>();
-    Akonadi::Tag tag(tagId);
+    Akonadi::Tag tag(context->backendIdentity().id());
 
     return item.hasTag(tag);
 }
@@ -869,33 +1194,32 @@ void Serializer::updateTagFromAkonadiTag(Domain::Tag::Ptr tag, Akonadi::Tag akon
     if (!isAkonadiTag(akonadiTag))
         return;
 
-    tag->setProperty("tagId", akonadiTag.id());
-    tag->setProperty("uid", akonadiTag.gid());
+    auto &identity = tag->backendIdentity();
+    identity.setId(akonadiTag.id());
+    identity.setUid(QString::fromUtf8(akonadiTag.gid()));
     tag->setName(akonadiTag.name());
 }
 
 Akonadi::Tag Serializer::createAkonadiTagFromTag(Domain::Tag::Ptr tag)
 {
     auto akonadiTag = Akonadi::Tag::genericTag(tag->name());
-    const auto tagUidProperty = tag->property("uid");
-    if (tagUidProperty.isValid()) {
-        akonadiTag.setGid(tagUidProperty.toByteArray());
+    const auto &identity = tag->backendIdentity();
+    if (!identity.uid().isNull()) {
+        akonadiTag.setGid(identity.uid().toUtf8());
     }
 
-    const auto tagProperty = tag->property("tagId");
-    if (tagProperty.isValid())
-        akonadiTag.setId(tagProperty.value<Akonadi::Tag::Id>());
+    if (identity.hasId())
+        akonadiTag.setId(identity.id());
 
     return akonadiTag;
 }
 
 bool Serializer::isTagChild(Domain::Tag::Ptr tag, Akonadi::Item item)
 {
-    if (!tag->property("tagId").isValid())
+    if (!tag->backendIdentity().hasId())
         return false;
 
-    auto tagId = tag->property("tagId").value<Akonadi::Tag::Id>();
-    Akonadi::Tag akonadiTag(tagId);
+    Akonadi::Tag akonadiTag(tag->backendIdentity().id());
 
     return item.hasTag(akonadiTag);
 }
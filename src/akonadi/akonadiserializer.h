@@ -57,6 +57,7 @@ public:
     Domain::Task::Ptr createTaskFromItem(Akonadi::Item item) Q_DECL_OVERRIDE;
     void updateTaskFromItem(Domain::Task::Ptr task, Akonadi::Item item) Q_DECL_OVERRIDE;
     Akonadi::Item createItemFromTask(Domain::Task::Ptr task) Q_DECL_OVERRIDE;
+    Domain::Task::List createTasksFromItems(const Akonadi::Item::List &items) Q_DECL_OVERRIDE;
     bool isTaskChild(Domain::Task::Ptr task, Akonadi::Item item) Q_DECL_OVERRIDE;
     QString relatedUidFromItem(Akonadi::Item item) Q_DECL_OVERRIDE;
     void updateItemParent(Akonadi::Item item, Domain::Task::Ptr parent) Q_DECL_OVERRIDE;
@@ -64,9 +65,11 @@ public:
     void removeItemParent(Akonadi::Item item) Q_DECL_OVERRIDE;
     Akonadi::Item::List filterDescendantItems(const Akonadi::Item::List &potentialChildren, const Akonadi::Item &ancestorItem) Q_DECL_OVERRIDE;
     Akonadi::Item createItemFromArtifact(Domain::Artifact::Ptr artifact) Q_DECL_OVERRIDE;
+    Domain::Artifact::List createArtifactsFromItems(const Akonadi::Item::List &items) Q_DECL_OVERRIDE;
 
     bool isNoteItem(Akonadi::Item item) Q_DECL_OVERRIDE;
     Domain::Note::Ptr createNoteFromItem(Akonadi::Item item) Q_DECL_OVERRIDE;
+    Domain::Note::List createNotesFromItems(const Akonadi::Item::List &items) Q_DECL_OVERRIDE;
     void updateNoteFromItem(Domain::Note::Ptr note, Akonadi::Item item) Q_DECL_OVERRIDE;
     Akonadi::Item createItemFromNote(Domain::Note::Ptr note) Q_DECL_OVERRIDE;
 
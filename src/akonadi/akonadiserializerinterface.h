@@ -72,6 +72,7 @@ public:
     virtual Domain::Task::Ptr createTaskFromItem(Akonadi::Item item) = 0;
     virtual void updateTaskFromItem(Domain::Task::Ptr task, Akonadi::Item item) = 0;
     virtual Akonadi::Item createItemFromTask(Domain::Task::Ptr task) = 0;
+    virtual Domain::Task::List createTasksFromItems(const Akonadi::Item::List &items) = 0;
 
     virtual bool isTaskChild(Domain::Task::Ptr task, Akonadi::Item item) = 0;
     virtual QString relatedUidFromItem(Akonadi::Item item) = 0;
@@ -82,6 +83,7 @@ public:
 
     virtual bool isNoteItem(Akonadi::Item item) = 0;
     virtual Domain::Note::Ptr createNoteFromItem(Akonadi::Item item) = 0;
+    virtual Domain::Note::List createNotesFromItems(const Akonadi::Item::List &items) = 0;
     virtual void updateNoteFromItem(Domain::Note::Ptr note, Akonadi::Item item) = 0;
 
     virtual Akonadi::Item createItemFromNote(Domain::Note::Ptr note) = 0;
@@ -113,6 +115,7 @@ public:
     static QByteArray contextTagType();
 
     virtual Akonadi::Item createItemFromArtifact(Domain::Artifact::Ptr artifact) = 0;
+    virtual Domain::Artifact::List createArtifactsFromItems(const Akonadi::Item::List &items) = 0;
 
     virtual bool isAkonadiTag(const Akonadi::Tag &tag) const = 0;
 };
@@ -26,6 +26,10 @@
 
 #include <algorithm>
 
+#include <QHash>
+#include <QPointer>
+#include <QVector>
+
 #include <KCalCore/Todo>
 
 #include <Akonadi/CollectionFetchScope>
@@ -36,6 +40,7 @@
 #include <Akonadi/ItemFetchScope>
 #include <Akonadi/ItemModifyJob>
 #include <Akonadi/ItemMoveJob>
+#include <Akonadi/KMime/MessageParts>
 #include <Akonadi/Notes/NoteUtils>
 #include <Akonadi/TransactionSequence>
 #include <Akonadi/TagCreateJob>
@@ -48,74 +53,81 @@
 #include <Akonadi/AttributeFactory>
 #include <pimcommon/acl/imapaclattribute.h>
 #include <akonadi/collectionidentificationattribute.h>
+#include "akonadi/akonadicache.h"
 #include "akonadi/akonadicollectionfetchjobinterface.h"
 #include "akonadi/akonadicollectionsearchjobinterface.h"
+#include "akonadi/akonadifetchscheduler.h"
 #include "akonadi/akonadiitemfetchjobinterface.h"
 #include "akonadi/akonaditagfetchjobinterface.h"
 #include "akonadi/akonadirelationfetchjobinterface.h"
 #include "akonadi/akonadistoragesettings.h"
 #include "akonadi/collectionsearchjob.h"
 #include "akonadi/personsearchjob.h"
+#include "utils/delayedcall.h"
+#include "utils/dependencymanager.h"
 #include "utils/jobhandler.h"
 
 using namespace Akonadi;
 
 class CollectionJob : public CollectionFetchJob, public CollectionFetchJobInterface
 {
+    Q_OBJECT
 public:
     CollectionJob (const Collection &collection, Type type=FirstLevel, QObject *parent=0)
         : CollectionFetchJob(collection, type, parent),
-          m_collection(collection)
+          m_collection(collection),
+          m_resolved(false)
     {
+        connect(this, SIGNAL(result(KJob*)), this, SLOT(onResult()));
     }
 
     Collection::List collections() const
     {
-        auto collections = CollectionFetchJob::collections();
-
-        // Memorize them to reconstruct the ancestor chain later
-        QMap<Collection::Id, Collection> collectionsMap;
-        collectionsMap[m_collection.id()] = m_collection;
-        for (auto collection : collections) {
-            collectionsMap[collection.id()] = collection;
+        // Callers tend to ask more than once, resolve only the first time
+        if (!m_resolved) {
+            // Why the hell isn't fetchScope() const and returning a reference???
+            auto self = const_cast<CollectionJob*>(this);
+            m_collections = Storage::resolveAncestors(m_collection,
+                                                      CollectionFetchJob::collections(),
+                                                      self->fetchScope().contentMimeTypes());
+            m_resolved = true;
         }
 
-        // Why the hell isn't fetchScope() const and returning a reference???
-        auto self = const_cast<CollectionJob*>(this);
-        const auto allowedMimeTypes = self->fetchScope().contentMimeTypes().toSet();
-
-        collections.erase(std::remove_if(collections.begin(), collections.end(),
-                                         [allowedMimeTypes] (const Collection &collection) {
-                                            auto mimeTypes = collection.contentMimeTypes().toSet();
-                                            return mimeTypes.intersect(allowedMimeTypes).isEmpty();
-                                         }),
-                          collections.end());
+        return m_collections;
+    }
 
-        // Replace the dummy parents in the ancestor chain with proper ones
-        // full of juicy data
-        std::function<Collection(const Collection&)> reconstructAncestors =
-        [collectionsMap, &reconstructAncestors, this] (const Collection &collection) {
-            Q_ASSERT(collection.isValid());
+private slots:
+    void onResult()
+    {
+        // Reported for the job statistics
+        setProcessedAmount(KJob::Items, CollectionFetchJob::collections().size());
+    }
 
-            if (collection == m_collection)
-                return collection;
+private:
+    const Collection m_collection;
+    mutable bool m_resolved;
+    mutable Collection::List m_collections;
+};
 
-            auto parent = collection.parentCollection();
-            auto reconstructedParent = reconstructAncestors(collectionsMap[parent.id()]);
+class CachedCollectionJob : public KJob, public CollectionFetchJobInterface
+{
+    Q_OBJECT
+public:
+    CachedCollectionJob(const Collection::List &collections)
+        : KJob(), m_collections(collections)
+    {
+        setProcessedAmount(KJob::Items, m_collections.size());
 
-            auto result = collection;
-            result.setParentCollection(reconstructedParent);
-            return result;
-        };
+        // Like the Akonadi jobs, we're started automatically
+        Utils::DelayedCall::post(this, [this] { emitResult(); });
+    }
 
-        std::transform(collections.begin(), collections.end(),
-                       collections.begin(), reconstructAncestors);
+    void start() {}
 
-        return collections;
-    }
+    Collection::List collections() const { return m_collections; }
 
 private:
-    const Collection m_collection;
+    const Collection::List m_collections;
 };
 
 class CollectionSearchJobAdaptor : public CollectionSearchJob, public CollectionSearchJobInterface
@@ -180,12 +192,168 @@ public:
 
 class ItemJob : public ItemFetchJob, public ItemFetchJobInterface
 {
+    Q_OBJECT
 public:
-    ItemJob(const Akonadi::Collection &col) : ItemFetchJob(col) {}
-    ItemJob(const Akonadi::Item &item) : ItemFetchJob(item) {}
-    ItemJob(const Akonadi::Tag &tag) : ItemFetchJob(tag) {}
+    ItemJob(const Akonadi::Collection &col) : ItemFetchJob(col), m_batchSize(0), m_waiters(0) { init(); }
+    ItemJob(const Akonadi::Item &item) : ItemFetchJob(item), m_batchSize(0), m_waiters(0) { init(); }
+    ItemJob(const Akonadi::Tag &tag) : ItemFetchJob(tag), m_batchSize(0), m_waiters(0) { init(); }
 
     Item::List items() const { return ItemFetchJob::items(); }
+
+    void setBatchSize(int size) { m_batchSize = size; }
+
+    // The scheduled jobs sharing the fetch, it only gets killed once
+    // none of them waits on it anymore
+    void addWaiter() { m_waiters++; }
+    bool removeWaiter() { return --m_waiters <= 0; }
+
+    void installItemsReceivedHandler(const ItemsReceivedHandler &handler)
+    {
+        if (m_handlers.isEmpty()) {
+            // Keep the items around at the end as well, the cache wants them
+            setDeliveryOptions(ItemGetter | EmitItemsInBatches);
+            connect(this, SIGNAL(itemsReceived(Akonadi::Item::List)),
+                    this, SLOT(onItemsReceived(Akonadi::Item::List)));
+            Utils::JobHandler::track(this);
+        }
+        m_handlers << handler;
+    }
+
+private slots:
+    void onItemsReceived(const Akonadi::Item::List &items)
+    {
+        if (m_batchSize <= 0 || items.size() <= m_batchSize) {
+            for (auto handler : m_handlers)
+                handler(items);
+            return;
+        }
+
+        for (int i = 0; i < items.size(); i += m_batchSize) {
+            const auto batch = items.mid(i, m_batchSize);
+            for (auto handler : m_handlers)
+                handler(batch);
+        }
+    }
+
+    void onResult()
+    {
+        // Reported for the job statistics
+        setProcessedAmount(KJob::Items, ItemFetchJob::items().size());
+    }
+
+private:
+    void init()
+    {
+        connect(this, SIGNAL(result(KJob*)), this, SLOT(onResult()));
+    }
+
+    QList<ItemsReceivedHandler> m_handlers;
+    int m_batchSize;
+    int m_waiters;
+};
+
+class ScheduledItemJob : public KJob, public ItemFetchJobInterface
+{
+    Q_OBJECT
+public:
+    ScheduledItemJob()
+        : KJob(),
+          m_owner(Utils::JobHandler::currentOwner()),
+          m_priority(Utils::JobHandler::currentPriority()),
+          m_cancelled(false)
+    {
+        Utils::JobHandler::track(this);
+    }
+
+    void start() {}
+
+    bool isCancelled() const { return m_cancelled; }
+
+    Item::List items() const { return m_job ? m_job->items() : Item::List(); }
+
+    void installItemsReceivedHandler(const ItemsReceivedHandler &handler)
+    {
+        m_handlers << handler;
+        if (m_job)
+            m_job->installItemsReceivedHandler(scoped(handler));
+    }
+
+    void setFetchJob(ItemJob *job)
+    {
+        Utils::JobHandler::notifyStarted(this);
+
+        m_job = job;
+        m_job->addWaiter();
+        for (auto handler : m_handlers)
+            m_job->installItemsReceivedHandler(scoped(handler));
+        connect(m_job, SIGNAL(result(KJob*)), this, SLOT(onFetchDone(KJob*)));
+    }
+
+protected:
+    bool doKill()
+    {
+        m_cancelled = true;
+        if (m_job) {
+            disconnect(m_job, 0, this, 0);
+            if (m_job->removeWaiter())
+                m_job->kill(KJob::EmitResult);
+        }
+        return true;
+    }
+
+private slots:
+    void onFetchDone(KJob *job)
+    {
+        setError(job->error());
+        setErrorText(job->errorText());
+        setProcessedAmount(KJob::Items, job->processedAmount(KJob::Items));
+        emitResult();
+    }
+
+private:
+    // The batches arrive outside of any job handler, the jobs they
+    // trigger still belong to the scope which asked for the fetch
+    ItemsReceivedHandler scoped(const ItemsReceivedHandler &handler)
+    {
+        QPointer<ScheduledItemJob> self(this);
+        auto owner = m_owner;
+        auto priority = m_priority;
+        return [self, owner, priority, handler] (const Item::List &items) {
+            // The fetch can be shared, those who stopped waiting don't get its items
+            if (!self || self->isCancelled())
+                return;
+
+            Utils::JobHandler::Scope scope(owner, priority);
+            handler(items);
+        };
+    }
+
+    QPointer<ItemJob> m_job;
+    QList<ItemsReceivedHandler> m_handlers;
+    QPointer<QObject> m_owner;
+    Utils::JobHandler::Priority m_priority;
+    bool m_cancelled;
+};
+
+class CachedItemJob : public KJob, public ItemFetchJobInterface
+{
+    Q_OBJECT
+public:
+    CachedItemJob(const Item::List &items)
+        : KJob(), m_items(items)
+    {
+        setProcessedAmount(KJob::Items, m_items.size());
+
+        // Like the Akonadi jobs, we're started automatically
+        Utils::DelayedCall::post(this, [this] { emitResult(); });
+    }
+
+    void start() {}
+
+    Item::List items() const { return m_items; }
+
+private:
+    const Item::List m_items;
 };
 
 class TagJob : public TagFetchJob, public TagFetchJobInterface
@@ -254,15 +422,32 @@ public:
 };
 
 Storage::Storage()
+    : m_cache(0),
+      m_itemBatchSize(0)
 {
     AttributeFactory::registerAttribute<CollectionIdentificationAttribute>();
     Akonadi::AttributeFactory::registerAttribute<PimCommon::ImapAclAttribute>();
+
+    // Without a cache everything goes to the server
+    auto &deps = Utils::DependencyManager::globalInstance();
+    if (deps.contains<Cache>())
+        m_cache = deps.create<Cache>();
 }
 
 Storage::~Storage()
 {
 }
 
+int Storage::itemBatchSize() const
+{
+    return m_itemBatchSize;
+}
+
+void Storage::setItemBatchSize(int size)
+{
+    m_itemBatchSize = size;
+}
+
 Collection Storage::defaultTaskCollection()
 {
     return StorageSettings::instance().defaultTaskCollection();
@@ -305,6 +490,11 @@ KJob *Storage::moveItems(Item::List items, Collection collection, QObject *paren
 
 KJob *Storage::updateCollection(Collection collection, QObject *parent)
 {
+    // Until the monitor reports the change, the cached trees would
+    // still show the collection as it was, so they get fetched again
+    if (m_cache)
+        m_cache->invalidateCollectionTrees();
+
     return new CollectionModifyJob(collection, parent);
 }
 
@@ -349,6 +539,12 @@ CollectionFetchJobInterface *Storage::fetchCollections(Collection collection, St
 
     Q_ASSERT(!contentMimeTypes.isEmpty());
 
+    auto cache = m_cache;
+    const auto cacheFilter = (filter == Display) ? Cache::DisplayedCollections : Cache::AllCollections;
+    if (cache && depth != Base && cache->isCollectionTreePopulated(contentMimeTypes, cacheFilter))
+        return new CachedCollectionJob(cache->collections(collection, depth == Recursive,
+                                                          contentMimeTypes, cacheFilter));
+
     auto job = new CollectionJob(collection, jobTypeFromDepth(depth));
 
     auto scope = job->fetchScope();
@@ -365,6 +561,14 @@ CollectionFetchJobInterface *Storage::fetchCollections(Collection collection, St
     }
     job->setFetchScope(scope);
 
+    // Only a whole tree can answer later requests for any of its parts
+    if (cache && collection == Collection::root() && depth == Recursive) {
+        Utils::JobHandler::install(job, [cache, job, contentMimeTypes, cacheFilter] {
+            if (job->error() == KJob::NoError)
+                cache->populateCollectionTree(contentMimeTypes, cacheFilter, job->collections());
+        });
+    }
+
     return job;
 }
 
@@ -406,9 +610,69 @@ CollectionSearchJobInterface *Storage::searchPersons(QString personName)
 
 ItemFetchJobInterface *Storage::fetchItems(Collection collection)
 {
+    auto cache = m_cache;
+    if (cache) {
+        cache->watchCollection(collection.id());
+        if (cache->isCollectionPopulated(collection.id()))
+            return new CachedItemJob(cache->items(collection));
+    }
+
+    // The actual fetch waits for its turn in the scheduler, there are
+    // way too many collections on some accounts to fetch them all at once.
+    // A visible page needing a collection which is already waiting for
+    // a prefetch or background one gets it first.
+    auto scheduler = FetchScheduler::sharedScheduler();
+    if (Utils::JobHandler::currentPriority() == Utils::JobHandler::VisiblePriority)
+        scheduler->prioritize(collection);
+
+    const int batchSize = m_itemBatchSize;
+    auto startFetch = [scheduler, cache, collection, batchSize] () -> ItemFetchJobInterface* {
+        auto job = new ScheduledItemJob;
+        QPointer<ScheduledItemJob> handle(job);
+        scheduler->schedule(collection, [cache, collection, handle, batchSize] (KJob *runningJob) -> KJob* {
+            if (!handle || handle->isCancelled())
+                return 0;
+
+            // Another fetch of that collection got started for the same slot
+            if (auto running = qobject_cast<ItemJob*>(runningJob)) {
+                handle->setFetchJob(running);
+                return running;
+            }
+
+            auto fetch = new ItemJob(collection);
+            configureItemFetchJob(fetch, ListScope, collection);
+            fetch->setBatchSize(batchSize);
+
+            if (cache) {
+                cache->beginCollectionFetch(collection.id());
+                Utils::JobHandler::install(fetch, [cache, fetch, collection] {
+                    if (fetch->error() == KJob::NoError)
+                        cache->populateCollection(collection, fetch->items());
+                    else
+                        cache->abortCollectionFetch(collection.id());
+                });
+            }
+
+            handle->setFetchJob(fetch);
+            return fetch;
+        });
+        return job;
+    };
+
+    // The queries starting together all wait on the same fetch
+    if (cache)
+        return cache->joinCollectionFetch(collection.id(), startFetch);
+    else
+        return startFetch();
+}
+
+ItemFetchJobInterface *Storage::fetchFullItems(Collection collection)
+{
+    // The cache only holds what the lists need, so it's bypassed here
     auto job = new ItemJob(collection);
 
-    configureItemFetchJob(job);
+    configureItemFetchJob(job, FullScope);
+    job->setBatchSize(m_itemBatchSize);
 
     return job;
 }
@@ -417,7 +681,8 @@ ItemFetchJobInterface *Storage::fetchItem(Akonadi::Item item)
 {
     auto job = new ItemJob(item);
 
-    configureItemFetchJob(job);
+    configureItemFetchJob(job, FullScope);
+    job->setBatchSize(m_itemBatchSize);
 
     return job;
 }
@@ -426,7 +691,8 @@ ItemFetchJobInterface *Storage::fetchTagItems(Tag tag)
 {
     auto job = new ItemJob(tag);
 
-    configureItemFetchJob(job);
+    configureItemFetchJob(job, ListScope);
+    job->setBatchSize(m_itemBatchSize);
 
     return job;
 }
@@ -436,6 +702,80 @@ TagFetchJobInterface *Storage::fetchTags()
     return new TagJob;
 }
 
+Collection::List Storage::resolveAncestors(const Collection &base,
+                                           const Collection::List &collections,
+                                           const QStringList &mimeTypes)
+{
+    const auto allowedMimeTypes = mimeTypes.toSet();
+
+    QHash<Collection::Id, Collection> fetched;
+    fetched.reserve(collections.size());
+    for (const auto &collection : collections)
+        fetched.insert(collection.id(), collection);
+
+    // Each collection gets its chain rebuilt only once, the collections
+    // below it then share it as parent
+    QHash<Collection::Id, Collection> resolved;
+    resolved.reserve(collections.size() + 1);
+    resolved.insert(base.id(), base);
+
+    QVector<Collection> chain;
+    auto resolve = [&] (const Collection &collection) -> Collection {
+        auto it = resolved.constFind(collection.id());
+        if (it != resolved.constEnd())
+            return *it;
+
+        // Climb until an already resolved ancestor, or one we know nothing
+        // better about than the dummy parent we've been given
+        Collection parent;
+        chain.clear();
+        auto current = collection;
+        forever {
+            chain << current;
+            const auto parentId = current.parentCollection().id();
+
+            auto resolvedParent = resolved.constFind(parentId);
+            if (resolvedParent != resolved.constEnd()) {
+                parent = *resolvedParent;
+                break;
+            }
+
+            auto fetchedParent = fetched.constFind(parentId);
+            if (fetchedParent == fetched.constEnd()) {
+                parent = current.parentCollection();
+                break;
+            }
+
+            current = *fetchedParent;
+        }
+
+        for (int i = chain.size() - 1; i >= 0; i--) {
+            auto ancestor = chain.at(i);
+            ancestor.setParentCollection(parent);
+            resolved.insert(ancestor.id(), ancestor);
+            parent = ancestor;
+        }
+
+        return parent;
+    };
+
+    Collection::List result;
+    result.reserve(collections.size());
+    for (const auto &collection : collections) {
+        const auto contentMimeTypes = collection.contentMimeTypes();
+        if (std::none_of(contentMimeTypes.constBegin(), contentMimeTypes.constEnd(),
+                         [&allowedMimeTypes] (const QString &mimeType) {
+                             return allowedMimeTypes.contains(mimeType);
+                         })) {
+            continue;
+        }
+
+        result << resolve(collection);
+    }
+
+    return result;
+}
+
 CollectionFetchJob::Type Storage::jobTypeFromDepth(StorageInterface::FetchDepth depth)
 {
     auto jobType = CollectionJob::Base;
@@ -458,13 +798,41 @@ CollectionFetchJob::Type Storage::jobTypeFromDepth(StorageInterface::FetchDepth
     return jobType;
 }
 
-void Storage::configureItemFetchJob(ItemJob *job)
+ItemFetchScope Storage::listFetchScope(const QStringList &mimeTypes)
 {
-    auto scope = job->fetchScope();
-    scope.fetchFullPayload();
+    ItemFetchScope scope;
+    scope.setFetchTags(true);
+    scope.tagFetchScope().setFetchIdOnly(false);
+    // Attributes are small and the tag and context queries read them
     scope.fetchAllAttributes();
+
+    // The headers hold everything the lists show about a note, the body
+    // gets fetched when the note is opened. Todos are left out on purpose:
+    // an iCal todo is a single payload part holding the title, dates and
+    // status the lists show, there's no lighter part to ask for.
+    if (mimeTypes.contains(NoteUtils::noteMimeType())
+     && !mimeTypes.contains(KCalCore::Todo::todoMimeType())) {
+        scope.fetchPayloadPart(MessagePart::Header);
+    } else {
+        scope.fetchFullPayload();
+    }
+    scope.setAncestorRetrieval(ItemFetchScope::Parent);
+
+    return scope;
+}
+
+void Storage::configureItemFetchJob(ItemJob *job, FetchScope fetchScope, const Collection &collection)
+{
+    if (fetchScope == ListScope) {
+        job->setFetchScope(listFetchScope(collection.contentMimeTypes()));
+        return;
+    }
+
+    auto scope = job->fetchScope();
     scope.setFetchTags(true);
     scope.tagFetchScope().setFetchIdOnly(false);
+    scope.fetchFullPayload();
+    scope.fetchAllAttributes();
     scope.setAncestorRetrieval(ItemFetchScope::All);
     job->setFetchScope(scope);
 }
@@ -473,3 +841,5 @@ RelationFetchJobInterface *Storage::fetchRelations(Akonadi::Item item)
 {
     return new RelationJob(item);
 }
+
+#include "akonadistorage.moc"
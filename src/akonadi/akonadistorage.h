@@ -26,17 +26,27 @@
 
 #include "akonadistorageinterface.h"
 
+#include <QStringList>
+
 #include <Akonadi/CollectionFetchJob>
+#include <Akonadi/ItemFetchScope>
 
 class ItemJob;
 namespace Akonadi {
 
+class Cache;
+
 class Storage : public StorageInterface
 {
 public:
     Storage();
     virtual ~Storage();
 
+    // Largest batch of fetched items handed over at once, 0 keeps the
+    // batches the way Akonadi delivers them
+    int itemBatchSize() const;
+    void setItemBatchSize(int size);
+
     Akonadi::Collection defaultTaskCollection() Q_DECL_OVERRIDE;
     Akonadi::Collection defaultNoteCollection() Q_DECL_OVERRIDE;
 
@@ -64,14 +74,33 @@ public:
     CollectionSearchJobInterface *searchCollections(QString collectionName, FetchContentTypes types) Q_DECL_OVERRIDE;
     CollectionSearchJobInterface *searchPersons(QString collectionName) Q_DECL_OVERRIDE;
     ItemFetchJobInterface *fetchItems(Akonadi::Collection collection) Q_DECL_OVERRIDE;
+    ItemFetchJobInterface *fetchFullItems(Akonadi::Collection collection) Q_DECL_OVERRIDE;
     ItemFetchJobInterface *fetchItem(Akonadi::Item item) Q_DECL_OVERRIDE;
     ItemFetchJobInterface *fetchTagItems(Akonadi::Tag tag) Q_DECL_OVERRIDE;
     TagFetchJobInterface *fetchTags() Q_DECL_OVERRIDE;
     RelationFetchJobInterface *fetchRelations(Akonadi::Item item) Q_DECL_OVERRIDE;
 
+    // Keeps the collections having one of the mime types, with their
+    // ancestor chain up to base rebuilt out of the other collections
+    static Collection::List resolveAncestors(const Collection &base,
+                                             const Collection::List &collections,
+                                             const QStringList &mimeTypes);
+
+    // What the lists need of the items having those content mime types,
+    // only notes get a lighter payload, todos still come in full
+    static ItemFetchScope listFetchScope(const QStringList &mimeTypes);
+
 private:
+    enum FetchScope {
+        ListScope,
+        FullScope
+    };
+
     CollectionFetchJob::Type jobTypeFromDepth(StorageInterface::FetchDepth depth);
-    void configureItemFetchJob(ItemJob *job);
+    static void configureItemFetchJob(ItemJob *job, FetchScope scope, const Collection &collection = Collection());
+
+    Cache *m_cache;
+    int m_itemBatchSize;
 };
 
 }
@@ -91,7 +91,11 @@ public:
     virtual CollectionSearchJobInterface *searchCollections(QString collectionName) = 0;
     virtual CollectionSearchJobInterface *searchCollections(QString collectionName, FetchContentTypes types) = 0;
     virtual CollectionSearchJobInterface *searchPersons(QString collectionName) = 0;
+    // fetchItems() and fetchTagItems() only retrieve what is needed to
+    // display the items in lists, fetchFullItems() and fetchItem() retrieve
+    // everything and are the ones to use before modifying an item
     virtual ItemFetchJobInterface *fetchItems(Akonadi::Collection collection) = 0;
+    virtual ItemFetchJobInterface *fetchFullItems(Akonadi::Collection collection) = 0;
     virtual ItemFetchJobInterface *fetchItem(Akonadi::Item item) = 0;
     virtual ItemFetchJobInterface *fetchTagItems(Akonadi::Tag tag) = 0;
     virtual TagFetchJobInterface *fetchTags() = 0;
@@ -26,12 +26,15 @@
 
 #include "akonadicollectionfetchjobinterface.h"
 #include "akonadiitemfetchjobinterface.h"
+#include "akonadilivequeryhelpers.h"
 #include "akonaditagfetchjobinterface.h"
 
-#include "akonadimonitorimpl.h"
+#include "akonadimonitorinterface.h"
+
 #include "akonadiserializer.h"
 #include "akonadistorage.h"
 
+#include "utils/dependencymanager.h"
 #include "utils/jobhandler.h"
 
 using namespace Akonadi;
@@ -40,7 +43,7 @@ TagQueries::TagQueries(QObject *parent)
     : QObject(parent),
       m_storage(new Storage),
       m_serializer(new Serializer),
-      m_monitor(new MonitorImpl),
+      m_monitor(Utils::DependencyManager::globalInstance().create<MonitorInterface>()),
       m_fetchContentTypeFilter(StorageInterface::Tasks|StorageInterface::Notes),
       m_ownInterfaces(true)
 {
@@ -116,6 +119,9 @@ TagQueries::TagResult::Ptr TagQueries::findAll() const
         m_findAll->setRepresentsFunction([this] (const Akonadi::Tag &akonadiTag, const Domain::Tag::Ptr &tag) {
             return m_serializer->representsAkonadiTag(tag, akonadiTag);
         });
+        m_findAll->setKeyFunction([] (const Akonadi::Tag &akonadiTag) {
+            return akonadiTag.id();
+        });
     }
 
     return m_findAll->result();
@@ -132,7 +138,7 @@ TagQueries::ArtifactResult::Ptr TagQueries::findTopLevelArtifacts(Domain::Tag::P
             self->m_findTopLevel.insert(akonadiTag.id(), query);
         }
 
-        query->setFetchFunction([this, akonadiTag] (const ArtifactQuery::AddFunction &add) {
+        query->setRangeFetchFunction([this, akonadiTag] (const ArtifactQuery::AddRangeFunction &add) {
             CollectionFetchJobInterface *job = m_storage->fetchCollections(Akonadi::Collection::root(),
                                                                            StorageInterface::Recursive,
                                                                            m_fetchContentTypeFilter);
@@ -142,13 +148,7 @@ TagQueries::ArtifactResult::Ptr TagQueries::findTopLevelArtifacts(Domain::Tag::P
 
                 for (auto collection : job->collections()) {
                     ItemFetchJobInterface *job = m_storage->fetchItems(collection);
-                    Utils::JobHandler::install(job->kjob(), [this, job, add] {
-                        if (job->kjob()->error() != KJob::NoError)
-                            return;
-
-                        for (auto item : job->items())
-                            add(item);
-                    });
+                    job->installItemsReceivedHandler(add);
                 }
             });
         });
@@ -167,6 +167,9 @@ TagQueries::ArtifactResult::Ptr TagQueries::findTopLevelArtifacts(Domain::Tag::P
             Q_ASSERT(false);
             return Domain::Artifact::Ptr();
         });
+        query->setRangeConvertFunction([this] (const Akonadi::Item::List &items) {
+            return m_serializer->createArtifactsFromItems(items);
+        });
         query->setUpdateFunction([this] (const Akonadi::Item &item, Domain::Artifact::Ptr &artifact) {
             if (auto task = artifact.dynamicCast<Domain::Task>()) {
                 m_serializer->updateTaskFromItem(task, item);
@@ -183,6 +186,9 @@ TagQueries::ArtifactResult::Ptr TagQueries::findTopLevelArtifacts(Domain::Tag::P
         query->setRepresentsFunction([this] (const Akonadi::Item &item, const Domain::Artifact::Ptr &artifact) {
             return m_serializer->representsItem(artifact, item);
         });
+        query->setKeyFunction([] (const Akonadi::Item &item) {
+            return item.id();
+        });
     }
 
     return m_findTopLevel.value(akonadiTag.id())->result();
@@ -206,6 +212,8 @@ void TagQueries::onTagChanged(const Tag &tag)
         query->onChanged(tag);
 }
 
+// The per tag artifact queries stay broadcast: an item can carry several
+// tags and the router only knows a single route per input.
 void TagQueries::onItemAdded(const Item &item)
 {
     foreach (const ArtifactQuery::Ptr &query, m_artifactQueries)
@@ -227,6 +235,8 @@ void TagQueries::onItemChanged(const Item &item)
 TagQueries::TagQuery::Ptr TagQueries::createTagQuery()
 {
     auto query = TagQueries::TagQuery::Ptr::create();
+    LiveQueryHelpers::attachJobOwner(query);
+    query->setBatchingEnabled(true);
     m_tagQueries << query;
     return query;
 }
@@ -234,6 +244,8 @@ TagQueries::TagQuery::Ptr TagQueries::createTagQuery()
 TagQueries::ArtifactQuery::Ptr TagQueries::createArtifactQuery()
 {
     auto query = TagQueries::ArtifactQuery::Ptr::create();
+    LiveQueryHelpers::attachJobOwner(query);
+    query->setBatchingEnabled(true);
     m_artifactQueries << query;
     return query;
 }
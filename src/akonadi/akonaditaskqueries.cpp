@@ -26,13 +26,17 @@
 
 #include "akonadicollectionfetchjobinterface.h"
 #include "akonadiitemfetchjobinterface.h"
-#include "akonadimonitorimpl.h"
+#include "akonadilivequeryhelpers.h"
+#include "akonadimonitorinterface.h"
 #include "akonadiserializer.h"
 #include "akonadistorage.h"
 
 #include <QPointer>
 #include <KCalCore/Todo>
 
+#include <algorithm>
+
+#include "utils/dependencymanager.h"
 #include "utils/jobhandler.h"
 
 using namespace Akonadi;
@@ -78,6 +82,17 @@ void AkonadiItemSource::findChildren(const Item &item)
     });
 }
 
+bool AkonadiItemSource::mayHaveChildren(const QString &parentUid)
+{
+    if (!m_populated) {
+        // Anything could be a parent until the tree got fetched
+        populate([] {});
+        return true;
+    }
+
+    return m_items.contains(parentUid);
+}
+
 void AkonadiItemSource::setFilter(const std::function<bool(const Akonadi::Item &)> &filter)
 {
     isWantedItem = filter;
@@ -90,6 +105,9 @@ void AkonadiItemSource::setItemFetcher(const std::function<void(const std::funct
 
 void AkonadiItemSource::populate(const std::function<void()> &callback)
 {
+    // Every caller waits on the same fetch, it only gets cancelled with the last one
+    Utils::JobHandler::hold(this);
+
     if (m_populated) {
         callback();
     } else if (m_populationInProgress) {
@@ -99,19 +117,23 @@ void AkonadiItemSource::populate(const std::function<void()> &callback)
         m_pendingCallbacks << callback;
         QPointer<AkonadiItemSource> handle(this);
 
+        Utils::JobHandler::Scope scope(this, Utils::JobHandler::currentPriority());
         fetchItems([this, handle](bool error, const Akonadi::Item::List &items){
             //Since the this pointer might be invalid meanwhile, we have to double check
             if (!handle) {
                 return;
             }
             if (error) {
+                // Let the next request try again, the fetch might have been
+                // cancelled along with everyone waiting on it
+                m_populationInProgress = false;
                 m_pendingCallbacks.clear();
                 return;
             }
             for (auto item : items) {
                 try {
                     auto todo = item.payload<KCalCore::Todo::Ptr>();
-                    m_items[todo->relatedTo()].append(item);
+                    insertItem(item, todo->relatedTo());
                 } catch (...) {
 
                 }
@@ -144,12 +166,14 @@ void AkonadiItemSource::onAdded(const Item &item)
     } catch (...) {
 
     }
+    insertItem(item, parent);
     emit added(item, parent);
 }
 
 void AkonadiItemSource::onRemoved(const Item &item)
 {
     QString parent;
+    removeItem(item);
     emit removed(item, parent);
 }
 
@@ -162,9 +186,34 @@ void AkonadiItemSource::onChanged(const Item &item)
     } catch (...) {
 
     }
+    if (isWantedItem(item))
+        insertItem(item, parent);
+    else
+        removeItem(item);
     emit changed(item, parent);
 }
 
+void AkonadiItemSource::insertItem(const Item &item, const QString &parent)
+{
+    // Keep the tree in sync with the monitor, it gets handed
+    // to the later findChildren() calls
+    removeItem(item);
+    m_items[parent].append(item);
+    m_parents.insert(item.id(), parent);
+}
+
+void AkonadiItemSource::removeItem(const Item &item)
+{
+    if (!m_parents.contains(item.id()))
+        return;
+
+    const QString parent = m_parents.take(item.id());
+    auto &children = m_items[parent];
+    children.erase(std::remove(children.begin(), children.end(), item), children.end());
+    if (children.isEmpty())
+        m_items.remove(parent);
+}
+
 
 TaskTreeQuery::TaskTreeQuery(SerializerInterface *serializer, const QSharedPointer<AkonadiItemSource> &source)
     : QObject(),
@@ -174,6 +223,15 @@ TaskTreeQuery::TaskTreeQuery(SerializerInterface *serializer, const QSharedPoint
     connect(m_source.data(), SIGNAL(added(Akonadi::Item, QString)), this, SLOT(onAdded(Akonadi::Item, QString)));
     connect(m_source.data(), SIGNAL(removed(Akonadi::Item, QString)), this, SLOT(onRemoved(Akonadi::Item, QString)));
     connect(m_source.data(), SIGNAL(changed(Akonadi::Item, QString)), this, SLOT(onChanged(Akonadi::Item, QString)));
+
+    // The source already tells under which parent an item lives, the route
+    // function only serves the notifications coming without one
+    m_findChildren.setRouteFunction([serializer] (const Akonadi::Item &item) {
+        return serializer->relatedUidFromItem(item);
+    });
+    m_findChildren.setKeyFunction([] (const Akonadi::Item &item) {
+        return item.id();
+    });
 }
 
 void TaskTreeQuery::findChildren(const Akonadi::Item &item)
@@ -183,6 +241,11 @@ void TaskTreeQuery::findChildren(const Akonadi::Item &item)
     }
 }
 
+bool TaskTreeQuery::mayHaveChildren(const QString &parentUid)
+{
+    return !m_source || m_source->mayHaveChildren(parentUid);
+}
+
 void TaskTreeQuery::reset(const QSharedPointer<AkonadiItemSource> &source)
 {
     disconnect(m_source.data(), SIGNAL(added(Akonadi::Item, QString)), this, SLOT(onAdded(Akonadi::Item, QString)));
@@ -190,7 +253,7 @@ void TaskTreeQuery::reset(const QSharedPointer<AkonadiItemSource> &source)
     disconnect(m_source.data(), SIGNAL(changed(Akonadi::Item, QString)), this, SLOT(onChanged(Akonadi::Item, QString)));
 
     m_source = source;
-    foreach(auto query, m_findChildren.values()) {
+    foreach(auto query, m_findChildren.queries()) {
         query->reset();
     }
 
@@ -201,43 +264,40 @@ void TaskTreeQuery::reset(const QSharedPointer<AkonadiItemSource> &source)
 
 TaskTreeQuery::Result::Ptr TaskTreeQuery::findChildren(Domain::Task::Ptr parent, const std::function<void(Query::Ptr, const Akonadi::Collection &root)> &setupFunction)
 {
-    const auto parentUid = parent->property("todoUid").toString();
+    const auto parentUid = parent->backendIdentity().uid();
     const auto item = m_serializer->createItemFromTask(parent);
-    if (!m_findChildren.contains(parentUid)) {
-        auto query = Query::Ptr::create();
-        m_findChildren.insert(parentUid, query);
+    auto query = m_findChildren.query(parentUid);
+    if (!query) {
+        query = Query::Ptr::create();
+        LiveQueryHelpers::attachJobOwner(query);
+        m_findChildren.addQuery(parentUid, query);
         setupFunction(query, item.parentCollection());
     }
-    return m_findChildren.value(parentUid)->result();
+    return query->result();
 }
 
 void TaskTreeQuery::onAdded(const Akonadi::Item &item, const QString &parent)
 {
-    auto query = m_findChildren.find(parent);
-    if (query != m_findChildren.end()) {
-        (*query)->onAdded(item);
-    }
+    m_findChildren.onAdded(item, parent);
 }
 
 void TaskTreeQuery::onRemoved(const Akonadi::Item &item, const QString &parent)
 {
-    for (auto query : m_findChildren.values()) {
-        query->onRemoved(item);
-    }
+    Q_UNUSED(parent);
+    // The source doesn't know the parent anymore, the router remembers it
+    m_findChildren.onRemoved(item);
 }
 
 void TaskTreeQuery::onChanged(const Akonadi::Item &item, const QString &parent)
 {
-    for (auto query : m_findChildren.values()) {
-        query->onChanged(item);
-    }
+    m_findChildren.onChanged(item, parent);
 }
 
 TaskQueries::TaskQueries(QObject *parent)
     : QObject(parent),
       m_storage(new Storage),
       m_serializer(new Serializer),
-      m_monitor(new MonitorImpl),
+      m_monitor(Utils::DependencyManager::globalInstance().create<MonitorInterface>()),
       m_ownInterfaces(true)
 {
     connect(m_monitor, SIGNAL(itemAdded(Akonadi::Item)), this, SLOT(onItemAdded(Akonadi::Item)));
@@ -303,7 +363,7 @@ TaskQueries::TaskResult::Ptr TaskQueries::findAll() const
             self->m_findAll = self->createTaskQuery();
         }
 
-        m_findAll->setFetchFunction([this] (const TaskQuery::AddFunction &add) {
+        m_findAll->setRangeFetchFunction([this] (const TaskQuery::AddRangeFunction &add) {
             CollectionFetchJobInterface *job = m_storage->fetchCollections(Akonadi::Collection::root(),
                                                                            StorageInterface::Recursive,
                                                                            StorageInterface::Tasks);
@@ -315,14 +375,7 @@ TaskQueries::TaskResult::Ptr TaskQueries::findAll() const
                     if (!m_serializer->isSelectedCollection(collection))
                         continue;
                     ItemFetchJobInterface *job = m_storage->fetchItems(collection);
-                    Utils::JobHandler::install(job->kjob(), [this, job, add] {
-                        if (job->kjob()->error() != KJob::NoError)
-                            return;
-
-                        for (auto item : job->items()) {
-                            add(item);
-                        }
-                    });
+                    job->installItemsReceivedHandler(add);
                 }
             });
         });
@@ -330,6 +383,9 @@ TaskQueries::TaskResult::Ptr TaskQueries::findAll() const
         m_findAll->setConvertFunction([this] (const Akonadi::Item &item) {
             return m_serializer->createTaskFromItem(item);
         });
+        m_findAll->setRangeConvertFunction([this] (const Akonadi::Item::List &items) {
+            return m_serializer->createTasksFromItems(items);
+        });
         m_findAll->setUpdateFunction([this] (const Akonadi::Item &item, Domain::Task::Ptr &task) {
             m_serializer->updateTaskFromItem(task, item);
         });
@@ -339,6 +395,9 @@ TaskQueries::TaskResult::Ptr TaskQueries::findAll() const
         m_findAll->setRepresentsFunction([this] (const Akonadi::Item &item, const Domain::Task::Ptr &task) {
             return m_serializer->representsItem(task, item);
         });
+        m_findAll->setKeyFunction([] (const Akonadi::Item &item) {
+            return item.id();
+        });
     }
 
     return m_findAll->result();
@@ -368,9 +427,24 @@ TaskQueries::TaskResult::Ptr TaskQueries::findChildren(Domain::Task::Ptr task) c
         query->setRepresentsFunction([this] (const Akonadi::Item &item, const Domain::Task::Ptr &task) {
             return m_serializer->representsItem(task, item);
         });
+        query->setKeyFunction([] (const Akonadi::Item &item) {
+            return item.id();
+        });
     });
 }
 
+bool TaskQueries::mayHaveChildren(Domain::Task::Ptr task) const
+{
+    const auto &identity = task->backendIdentity();
+
+    // Not stored yet, nothing can be related to it
+    if (!identity.hasParentId())
+        return false;
+
+    auto treeQuery = getTaskTree(Akonadi::Collection(identity.parentId()));
+    return treeQuery->mayHaveChildren(identity.uid());
+}
+
 TaskQueries::TaskResult::Ptr TaskQueries::findTopLevel() const
 {
     if (!m_findTopLevel) {
@@ -379,7 +453,7 @@ TaskQueries::TaskResult::Ptr TaskQueries::findTopLevel() const
             self->m_findTopLevel = self->createTaskQuery();
         }
 
-        m_findTopLevel->setFetchFunction([this] (const TaskQuery::AddFunction &add) {
+        m_findTopLevel->setRangeFetchFunction([this] (const TaskQuery::AddRangeFunction &add) {
             CollectionFetchJobInterface *job = m_storage->fetchCollections(Akonadi::Collection::root(),
                                                                            StorageInterface::Recursive,
                                                                            StorageInterface::Tasks);
@@ -391,14 +465,7 @@ TaskQueries::TaskResult::Ptr TaskQueries::findTopLevel() const
                     if (!m_serializer->isSelectedCollection(collection))
                         continue;
                     ItemFetchJobInterface *job = m_storage->fetchItems(collection);
-                    Utils::JobHandler::install(job->kjob(), [this, job, add] {
-                        if (job->kjob()->error() != KJob::NoError)
-                            return;
-
-                        for (auto item : job->items()) {
-                            add(item);
-                        }
-                    });
+                    job->installItemsReceivedHandler(add);
                 }
             });
         });
@@ -406,6 +473,9 @@ TaskQueries::TaskResult::Ptr TaskQueries::findTopLevel() const
         m_findTopLevel->setConvertFunction([this] (const Akonadi::Item &item) {
             return m_serializer->createTaskFromItem(item);
         });
+        m_findTopLevel->setRangeConvertFunction([this] (const Akonadi::Item::List &items) {
+            return m_serializer->createTasksFromItems(items);
+        });
         m_findTopLevel->setUpdateFunction([this] (const Akonadi::Item &item, Domain::Task::Ptr &task) {
             m_serializer->updateTaskFromItem(task, item);
         });
@@ -415,6 +485,9 @@ TaskQueries::TaskResult::Ptr TaskQueries::findTopLevel() const
         m_findTopLevel->setRepresentsFunction([this] (const Akonadi::Item &item, const Domain::Task::Ptr &task) {
             return m_serializer->representsItem(task, item);
         });
+        m_findTopLevel->setKeyFunction([] (const Akonadi::Item &item) {
+            return item.id();
+        });
     }
 
     return m_findTopLevel->result();
@@ -427,6 +500,10 @@ TaskQueries::ContextResult::Ptr TaskQueries::findContexts(Domain::Task::Ptr task
     return ContextResult::Ptr();
 }
 
+// Only findAll() and findTopLevel() are left here, the children queries
+// are routed by parent through TaskTreeQuery. Both span every selected
+// collection so any task can belong to them, they are deliberately kept
+// as broadcast.
 void TaskQueries::onItemAdded(const Item &item)
 {
     foreach (const TaskQuery::Ptr &query, m_taskQueries)
@@ -437,11 +514,6 @@ void TaskQueries::onItemRemoved(const Item &item)
 {
     foreach (const TaskQuery::Ptr &query, m_taskQueries)
         query->onRemoved(item);
-
-    if (m_findChildren.contains(item.id())) {
-        auto query = m_findChildren.take(item.id());
-        m_taskQueries.removeAll(query);
-    }
 }
 
 void TaskQueries::onItemChanged(const Item &item)
@@ -453,6 +525,8 @@ void TaskQueries::onItemChanged(const Item &item)
 TaskQueries::TaskQuery::Ptr TaskQueries::createTaskQuery()
 {
     auto query = TaskQueries::TaskQuery::Ptr::create();
+    LiveQueryHelpers::attachJobOwner(query);
+    query->setBatchingEnabled(true);
     m_taskQueries << query;
     return query;
 }
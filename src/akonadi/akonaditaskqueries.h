@@ -30,6 +30,7 @@
 #include <Akonadi/Item>
 
 #include "domain/livequery.h"
+#include "domain/livequeryrouter.h"
 #include "domain/taskqueries.h"
 
 class KJob;
@@ -60,6 +61,7 @@ public:
 
     TaskResult::Ptr findAll() const;
     TaskResult::Ptr findChildren(Domain::Task::Ptr task) const;
+    bool mayHaveChildren(Domain::Task::Ptr task) const;
     TaskResult::Ptr findTopLevel() const;
     ContextResult::Ptr findContexts(Domain::Task::Ptr task) const;
 
@@ -79,7 +81,6 @@ private:
     bool m_ownInterfaces;
 
     TaskQuery::Ptr m_findAll;
-    QHash<Akonadi::Entity::Id, TaskQuery::Ptr> m_findChildren;
     TaskQuery::Ptr m_findTopLevel;
     TaskQuery::List m_taskQueries;
     QHash<Akonadi::Collection::Id, QSharedPointer<TaskTreeQuery> > m_treeQueries;
@@ -97,6 +98,10 @@ public:
 
     void findChildren(const Akonadi::Item &parent);
 
+    //Tells if items related to the given uid might exist. It starts fetching the tree
+    //if needed and answers true until it is known.
+    bool mayHaveChildren(const QString &parentUid);
+
     //Defines what parts match the tree. Implement to filter monitor notifications outside of the tree.
     //The filter is recursive, meaning that if a parent is filtered, children will automatically match the filter as well.
     void setFilter(const std::function<bool(const Akonadi::Item &)> &);
@@ -118,7 +123,10 @@ private:
     Akonadi::Collection::Id id(const Akonadi::Collection &col) const;
     //Internally trigger the fetchFunction and then call the appropriate signals/callbacks
     void populate(const std::function<void()> &callback);
+    void insertItem(const Akonadi::Item &item, const QString &parent);
+    void removeItem(const Akonadi::Item &item);
     QHash<QString /*parent*/, Item::List /*children*/> m_items;
+    QHash<Akonadi::Item::Id, QString /*parent*/> m_parents;
     MonitorInterface *m_monitor;
     bool m_populated;
     bool m_populationInProgress;
@@ -137,12 +145,14 @@ public:
     typedef Domain::LiveQuery<Akonadi::Item, Domain::Task::Ptr> Query;
     typedef Domain::QueryResultProvider<Domain::Task::Ptr> Provider;
     typedef Domain::QueryResult<Domain::Task::Ptr> Result;
+    typedef Domain::LiveQueryRouter<Akonadi::Item, Domain::Task::Ptr, QString> Router;
 
     TaskTreeQuery(SerializerInterface *, const QSharedPointer<AkonadiItemSource> &source);
     void reset(const QSharedPointer<AkonadiItemSource> &source);
 
     Result::Ptr findChildren(Domain::Task::Ptr source, const std::function<void(typename Query::Ptr, const Akonadi::Collection &root)> &setupFunction);
     void findChildren(const Item &parent);
+    bool mayHaveChildren(const QString &parentUid);
 
 private slots:
     void onAdded(const Akonadi::Item &, const QString &parent);
@@ -150,7 +160,7 @@ private slots:
     void onChanged(const Akonadi::Item &, const QString &parent);
 
 private:
-    QHash<QString, typename Query::Ptr> m_findChildren;
+    Router m_findChildren;
     SerializerInterface *m_serializer;
     QSharedPointer<AkonadiItemSource> m_source;
 };
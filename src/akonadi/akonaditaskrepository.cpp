@@ -169,7 +169,7 @@ KJob *TaskRepository::update(Domain::Task::Ptr task)
         *ocurrence = *task;
         ocurrence->setRecurrence(Domain::Recurrence::Ptr());
         ocurrence->setStatus(Domain::Task::Complete);
-        ocurrence->setProperty("relatedUid", task->property("todoUid"));
+        ocurrence->backendIdentity().setRelatedUid(task->backendIdentity().uid());
 
         if (!task->startDate().isValid()) {
             qWarning() << "A recurring todo must always have a valid start date";
@@ -202,7 +202,7 @@ KJob *TaskRepository::update(Domain::Task::Ptr task)
         Q_ASSERT(item.isValid());
         auto itemOcurrence = m_serializer->createItemFromTask(ocurrence);
         Q_ASSERT(!itemOcurrence.isValid());
-        auto collection = Akonadi::Collection(task->property("parentCollectionId").value<Entity::Id>());
+        auto collection = Akonadi::Collection(task->backendIdentity().parentId());
 
         auto job = new CompositeJob();
         job->install(m_storage->createItem(itemOcurrence, collection),[] {});
@@ -24,10 +24,14 @@
 #include "dependencies.h"
 
 #include "akonadi/akonadiartifactqueries.h"
+#include "akonadi/akonadicache.h"
 #include "akonadi/akonadicontextqueries.h"
 #include "akonadi/akonadicontextrepository.h"
 #include "akonadi/akonadidatasourcequeries.h"
 #include "akonadi/akonadidatasourcerepository.h"
+#include "akonadi/akonadifetchscheduler.h"
+#include "akonadi/akonadimonitorimpl.h"
+#include "akonadi/akonadimonitorproxy.h"
 #include "akonadi/akonadinotequeries.h"
 #include "akonadi/akonadinoterepository.h"
 #include "akonadi/akonadiprojectqueries.h"
@@ -44,6 +48,18 @@
 void App::initializeDependencies()
 {
     auto &deps = Utils::DependencyManager::globalInstance();
+    deps.add<Akonadi::FetchScheduler, Akonadi::FetchScheduler>(Utils::DependencyManager::UniqueInstance);
+    deps.add<Akonadi::MonitorImpl, Akonadi::MonitorImpl>(Utils::DependencyManager::UniqueInstance);
+    deps.add<Akonadi::MonitorInterface, Akonadi::MonitorProxy>();
+    deps.add<Akonadi::Cache>([] () -> Akonadi::Cache* {
+        auto monitor = new Akonadi::MonitorProxy;
+        auto cache = new Akonadi::Cache(monitor);
+        monitor->setParent(cache);
+        // Only the cache knows which items the queries asked for
+        auto &deps = Utils::DependencyManager::globalInstance();
+        deps.create<Akonadi::MonitorImpl>()->setItemFilter(cache->itemFilter());
+        return cache;
+    }, Utils::DependencyManager::UniqueInstance);
     deps.add<Domain::ArtifactQueries, Akonadi::ArtifactQueries>();
     deps.add<Domain::ContextQueries, Akonadi::ContextQueries>();
     deps.add<Domain::ContextRepository, Akonadi::ContextRepository>();
@@ -0,0 +1,75 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include "fetchprogress.h"
+
+#include <QProgressBar>
+
+#include <KLocalizedString>
+#include <KMainWindow>
+#include <KStatusBar>
+
+#include "akonadi/akonadifetchscheduler.h"
+
+namespace App {
+
+class FetchProgressBar : public QProgressBar
+{
+    Q_OBJECT
+public:
+    explicit FetchProgressBar(QWidget *parent = 0)
+        : QProgressBar(parent)
+    {
+        setFormat(i18n("Loading %v/%m"));
+        setMaximumWidth(200);
+        hide();
+    }
+
+public slots:
+    void setProgress(int finished, int total)
+    {
+        if (finished >= total) {
+            hide();
+            return;
+        }
+
+        setMaximum(total);
+        setValue(finished);
+        show();
+    }
+};
+
+}
+
+void App::showFetchProgress(KMainWindow *window)
+{
+    auto statusBar = window->statusBar();
+    auto progressBar = new FetchProgressBar(statusBar);
+    statusBar->addPermanentWidget(progressBar);
+
+    QObject::connect(Akonadi::FetchScheduler::sharedScheduler(), SIGNAL(progress(int,int)),
+                     progressBar, SLOT(setProgress(int,int)));
+}
+
+#include "fetchprogress.moc"
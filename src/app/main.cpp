@@ -44,6 +44,7 @@
 #include "presentation/applicationmodel.h"
 
 #include "dependencies.h"
+#include "fetchprogress.h"
 
 #include <iostream>
 
@@ -108,6 +109,7 @@ int main(int argc, char **argv)
     window->resize(1024, 600);
     window->setAutoSaveSettings("MainWindow");
     window->setCentralWidget(widget);
+    App::showFetchProgress(window);
 
     QToolBar *mainToolBar = window->addToolBar(QObject::tr("Main"));
     mainToolBar->setObjectName("mainToolBar");
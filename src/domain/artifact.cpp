@@ -63,3 +63,12 @@ void Artifact::setTitle(const QString &title)
     emit titleChanged(title);
 }
 
+const BackendIdentity &Artifact::backendIdentity() const
+{
+    return m_backendIdentity;
+}
+
+BackendIdentity &Artifact::backendIdentity()
+{
+    return m_backendIdentity;
+}
@@ -29,6 +29,8 @@
 #include <QSharedPointer>
 #include <QString>
 
+#include "backendidentity.h"
+
 namespace Domain {
 
 class Artifact : public QObject
@@ -47,6 +49,9 @@ public:
     QString text() const;
     QString title() const;
 
+    const BackendIdentity &backendIdentity() const;
+    BackendIdentity &backendIdentity();
+
 public slots:
     void setText(const QString &text);
     void setTitle(const QString &title);
@@ -58,6 +63,7 @@ signals:
 private:
     QString m_text;
     QString m_title;
+    BackendIdentity m_backendIdentity;
 };
 
 }
@@ -0,0 +1,95 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+
+#include "backendidentity.h"
+
+using namespace Domain;
+
+BackendIdentity::BackendIdentity()
+    : m_id(-1),
+      m_parentId(-1),
+      m_partial(false)
+{
+}
+
+bool BackendIdentity::hasId() const
+{
+    return m_id != -1;
+}
+
+qint64 BackendIdentity::id() const
+{
+    return m_id;
+}
+
+void BackendIdentity::setId(qint64 id)
+{
+    m_id = id;
+}
+
+bool BackendIdentity::hasParentId() const
+{
+    return m_parentId != -1;
+}
+
+qint64 BackendIdentity::parentId() const
+{
+    return m_parentId;
+}
+
+void BackendIdentity::setParentId(qint64 parentId)
+{
+    m_parentId = parentId;
+}
+
+QString BackendIdentity::uid() const
+{
+    return m_uid;
+}
+
+void BackendIdentity::setUid(const QString &uid)
+{
+    m_uid = uid;
+}
+
+QString BackendIdentity::relatedUid() const
+{
+    return m_relatedUid;
+}
+
+void BackendIdentity::setRelatedUid(const QString &relatedUid)
+{
+    m_relatedUid = relatedUid;
+}
+
+bool BackendIdentity::isPartial() const
+{
+    return m_partial;
+}
+
+void BackendIdentity::setPartial(bool partial)
+{
+    m_partial = partial;
+}
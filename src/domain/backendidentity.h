@@ -0,0 +1,70 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+
+#ifndef DOMAIN_BACKENDIDENTITY_H
+#define DOMAIN_BACKENDIDENTITY_H
+
+#include <QString>
+
+namespace Domain {
+
+// Where a domain object comes from in the storage backend. It is
+// filled and read by the backend only, the rest of the application
+// doesn't know what the values mean.
+class BackendIdentity
+{
+public:
+    BackendIdentity();
+
+    bool hasId() const;
+    qint64 id() const;
+    void setId(qint64 id);
+
+    bool hasParentId() const;
+    qint64 parentId() const;
+    void setParentId(qint64 parentId);
+
+    QString uid() const;
+    void setUid(const QString &uid);
+
+    QString relatedUid() const;
+    void setRelatedUid(const QString &relatedUid);
+
+    // Only what the lists display got loaded, the object has
+    // to be loaded in full before showing or saving its content
+    bool isPartial() const;
+    void setPartial(bool partial);
+
+private:
+    qint64 m_id;
+    qint64 m_parentId;
+    QString m_uid;
+    QString m_relatedUid;
+    bool m_partial;
+};
+
+}
+
+#endif // DOMAIN_BACKENDIDENTITY_H
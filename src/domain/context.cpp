@@ -48,3 +48,13 @@ void Context::setName(const QString &name)
     m_name = name;
     emit nameChanged(name);
 }
+
+const BackendIdentity &Context::backendIdentity() const
+{
+    return m_backendIdentity;
+}
+
+BackendIdentity &Context::backendIdentity()
+{
+    return m_backendIdentity;
+}
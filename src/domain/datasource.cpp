@@ -122,3 +122,13 @@ void DataSource::setPerson(bool person)
     m_person = person;
     emit personChanged(person);
 }
+
+const BackendIdentity &DataSource::backendIdentity() const
+{
+    return m_backendIdentity;
+}
+
+BackendIdentity &DataSource::backendIdentity()
+{
+    return m_backendIdentity;
+}
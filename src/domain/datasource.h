@@ -29,6 +29,8 @@
 #include <QSharedPointer>
 #include <QString>
 
+#include "backendidentity.h"
+
 namespace Domain {
 
 class DataSource : public QObject
@@ -67,6 +69,9 @@ public:
     bool isSelected() const;
     bool isPerson() const;
 
+    const BackendIdentity &backendIdentity() const;
+    BackendIdentity &backendIdentity();
+
 public slots:
     void setName(const QString &name);
     void setIconName(const QString &iconName);
@@ -90,6 +95,7 @@ private:
     ListStatus m_listStatus;
     bool m_selected;
     bool m_person;
+    BackendIdentity m_backendIdentity;
 };
 
 }
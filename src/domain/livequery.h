@@ -25,6 +25,11 @@
 #ifndef DOMAIN_LIVEQUERY_H
 #define DOMAIN_LIVEQUERY_H
 
+#include <algorithm>
+
+#include <QHash>
+#include <QVector>
+
 #include "queryresult.h"
 
 namespace Domain {
@@ -42,11 +47,25 @@ public:
 
     typedef std::function<void(const InputType &)> AddFunction;
 
+    typedef std::function<void(const QList<InputType> &)> AddRangeFunction;
+
     typedef std::function<void(const AddFunction &)> FetchFunction;
+    typedef std::function<void(const AddRangeFunction &)> RangeFetchFunction;
     typedef std::function<bool(const InputType &)> PredicateFunction;
     typedef std::function<OutputType(const InputType &)> ConvertFunction;
+    typedef std::function<QList<OutputType>(const QList<InputType> &)> RangeConvertFunction;
     typedef std::function<void(const InputType &, OutputType &)> UpdateFunction;
     typedef std::function<bool(const InputType &, const OutputType &)> RepresentsFunction;
+    typedef std::function<qint64(const InputType &)> KeyFunction;
+    typedef std::function<void()> HoldFunction;
+    typedef std::function<void(const std::function<void()> &)> ScopeFunction;
+    typedef std::function<void(const std::function<void()> &)> PostFunction;
+
+    LiveQuery()
+        : m_nextSequence(0),
+          m_batching(false)
+    {
+    }
 
     ~LiveQuery()
     {
@@ -55,6 +74,11 @@ public:
 
     typename Result::Ptr result()
     {
+        // The result is shared, so are the jobs filling it: they
+        // only get cancelled once no caller is waiting on them anymore
+        if (m_hold)
+            m_hold();
+
         typename Provider::Ptr provider(m_provider.toStrongRef());
 
         if (provider)
@@ -73,6 +97,13 @@ public:
         m_fetch = fetch;
     }
 
+    // Same as the fetch function but the inputs are delivered by batches,
+    // each batch ending up in a single insertion in the provider
+    void setRangeFetchFunction(const RangeFetchFunction &fetch)
+    {
+        m_rangeFetch = fetch;
+    }
+
     void setPredicateFunction(const PredicateFunction &predicate)
     {
         m_predicate = predicate;
@@ -83,6 +114,13 @@ public:
         m_convert = convert;
     }
 
+    // Used instead of the convert function for the batches coming from
+    // the range fetch function, it must give back one output per input
+    void setRangeConvertFunction(const RangeConvertFunction &convert)
+    {
+        m_rangeConvert = convert;
+    }
+
     void setUpdateFunction(const UpdateFunction &update)
     {
         m_update = update;
@@ -93,13 +131,108 @@ public:
         m_represents = represents;
     }
 
+    // When a key function is set, the query maintains a key index in step
+    // with the provider so that change and remove notifications don't need
+    // to scan the whole result. The represents function is then only used
+    // for inputs which have no key (negative value)
+    void setKeyFunction(const KeyFunction &key)
+    {
+        m_key = key;
+    }
+
+    // The domain doesn't know about jobs, the backend decides what they
+    // belong to: the hold function is called in the context of each caller
+    // asking for a result and the fetches are run through the scope function
+    void setHoldFunction(const HoldFunction &hold)
+    {
+        m_hold = hold;
+    }
+
+    void setScopeFunction(const ScopeFunction &scope)
+    {
+        m_scope = scope;
+    }
+
+    // Used in batching mode to get called back on the next event loop turn,
+    // it must drop the callback if the query is gone by then
+    void setPostFunction(const PostFunction &post)
+    {
+        m_post = post;
+    }
+
+    // In batching mode the notifications received during an event loop
+    // turn are queued, only the last one per key is kept, and they get
+    // applied in arrival order on the next turn. It needs a post function.
+    void setBatchingEnabled(bool batching)
+    {
+        m_batching = batching;
+    }
+
     void reset()
     {
+        // The refetch supersedes whatever was still queued
+        m_pending.clear();
+        m_pendingIndex.clear();
         clear();
         doFetch();
     }
 
     void onAdded(const InputType &input)
+    {
+        if (isBatching())
+            enqueue(Added, input);
+        else
+            applyAdded(input);
+    }
+
+    void onChanged(const InputType &input)
+    {
+        if (isBatching())
+            enqueue(Changed, input);
+        else
+            applyChanged(input);
+    }
+
+    void onRemoved(const InputType &input)
+    {
+        if (isBatching())
+            enqueue(Removed, input);
+        else
+            applyRemoved(input);
+    }
+
+private:
+    enum Operation {
+        Added,
+        Changed,
+        Removed
+    };
+
+    struct PendingChange
+    {
+        PendingChange() : operation(Added), key(-1) {}
+        PendingChange(Operation op, const InputType &in, qint64 k) : operation(op), input(in), key(k) {}
+
+        Operation operation;
+        InputType input;
+        qint64 key;
+    };
+
+    struct RowEntry
+    {
+        RowEntry() : sequence(-1), key(-1) {}
+        RowEntry(qint64 seq, qint64 k) : sequence(seq), key(k) {}
+
+        qint64 sequence;
+        qint64 key;
+    };
+
+    bool isBatching() const
+    {
+        return m_batching && m_post;
+    }
+
+    void applyAdded(const InputType &input)
     {
         typename Provider::Ptr provider(m_provider.toStrongRef());
 
@@ -107,60 +240,163 @@ public:
             return;
 
         if (m_predicate(input))
-            provider->append(m_convert(input));
+            addToProvider(provider, input);
     }
 
-    void onChanged(const InputType &input)
+    void applyChanged(const InputType &input)
     {
         typename Provider::Ptr provider(m_provider.toStrongRef());
 
         if (!provider)
             return;
 
+        const qint64 key = keyOf(input);
+        if (key >= 0) {
+            const int row = rowForKey(key);
+
+            if (!m_predicate(input)) {
+                if (row >= 0)
+                    removeRow(provider, row);
+            } else if (row >= 0) {
+                updateRow(provider, row, input);
+            } else {
+                addToProvider(provider, input);
+            }
+            return;
+        }
+
+        const auto &data = provider->constData();
+
         if (!m_predicate(input)) {
-            for (int i = 0; i < provider->data().size(); i++) {
-                auto output = provider->data().at(i);
-                if (m_represents(input, output)) {
-                    provider->removeAt(i);
-                    i--;
-                }
+            for (int i = data.size() - 1; i >= 0; i--) {
+                if (m_represents(input, data.at(i)))
+                    removeRow(provider, i);
             }
         } else {
             bool found = false;
 
-            for (int i = 0; i < provider->data().size(); i++) {
-                auto output = provider->data().at(i);
-                if (m_represents(input, output)) {
-                    m_update(input, output);
-                    provider->replace(i, output);
-
+            for (int i = 0; i < data.size(); i++) {
+                if (m_represents(input, data.at(i))) {
+                    updateRow(provider, i, input);
                     found = true;
                 }
             }
 
-            if (!found) {
-                provider->append(m_convert(input));
-            }
+            if (!found)
+                addToProvider(provider, input);
         }
     }
 
-    void onRemoved(const InputType &input)
+    void applyRemoved(const InputType &input)
     {
         typename Provider::Ptr provider(m_provider.toStrongRef());
 
         if (!provider)
             return;
 
-        for (int i = 0; i < provider->data().size(); i++) {
-            auto output = provider->data().at(i);
-            if (m_represents(input, output)) {
-                provider->removeAt(i);
-                i--;
+        const qint64 key = keyOf(input);
+        if (key >= 0) {
+            const int row = rowForKey(key);
+            if (row >= 0)
+                removeRow(provider, row);
+            return;
+        }
+
+        const auto &data = provider->constData();
+        for (int i = data.size() - 1; i >= 0; i--) {
+            if (m_represents(input, data.at(i)))
+                removeRow(provider, i);
+        }
+    }
+
+    void enqueue(Operation operation, const InputType &input)
+    {
+        if (!m_provider.toStrongRef())
+            return;
+
+        if (m_pending.isEmpty())
+            m_post([this] { flush(); });
+
+        // Only the last notification for a given key matters, the
+        // earlier ones stay queued but get skipped when flushing
+        const qint64 key = keyOf(input);
+        if (key >= 0)
+            m_pendingIndex.insert(key, m_pending.size());
+        m_pending << PendingChange(operation, input, key);
+    }
+
+    void flush()
+    {
+        const auto pending = m_pending;
+        const auto pendingIndex = m_pendingIndex;
+        m_pending.clear();
+        m_pendingIndex.clear();
+
+        typename Provider::Ptr provider(m_provider.toStrongRef());
+
+        if (!provider)
+            return;
+
+        // Changes are applied in arrival order, the keyed ones
+        // received in a row being applied together as a single diff
+        QList<PendingChange> keyed;
+
+        for (int i = 0; i < pending.size(); i++) {
+            const auto &change = pending.at(i);
+
+            if (change.key >= 0) {
+                if (pendingIndex.value(change.key) == i)
+                    keyed << change;
+                continue;
             }
+
+            applyKeyedChanges(provider, keyed);
+            keyed.clear();
+
+            // No way to coalesce those, apply them as they came
+            if (change.operation == Added)
+                applyAdded(change.input);
+            else if (change.operation == Changed)
+                applyChanged(change.input);
+            else
+                applyRemoved(change.input);
         }
+
+        applyKeyedChanges(provider, keyed);
+    }
+
+    void applyKeyedChanges(const typename Provider::Ptr &provider, const QList<PendingChange> &changes)
+    {
+        if (changes.isEmpty())
+            return;
+
+        // Replaces first since they don't move rows, then removes and
+        // finally all the inserts in one go at the end of the list
+        QList<int> rowsToRemove;
+        QList<InputType> inputsToAdd;
+
+        for (const auto &change : changes) {
+            const int row = rowForKey(change.key);
+            const bool accepted = change.operation != Removed && m_predicate(change.input);
+
+            if (!accepted) {
+                // Unsuitable additions are simply ignored
+                if (row >= 0 && change.operation != Added)
+                    rowsToRemove << row;
+            } else if (row >= 0) {
+                updateRow(provider, row, change.input);
+            } else {
+                inputsToAdd << change.input;
+            }
+        }
+
+        removeRows(provider, rowsToRemove);
+
+        // The range convert is meant for fetched batches, notifications
+        // are converted one by one like in the unbatched mode
+        addRangeToProvider(provider, inputsToAdd, RangeConvertFunction());
     }
 
-private:
     void doFetch()
     {
         typename Provider::Ptr provider(m_provider.toStrongRef());
@@ -168,9 +404,31 @@ private:
         if (!provider)
             return;
 
+        if (m_scope)
+            m_scope([this, provider] { fetchInto(provider); });
+        else
+            fetchInto(provider);
+    }
+
+    void fetchInto(const typename Provider::Ptr &provider)
+    {
+        if (m_rangeFetch) {
+            auto addRangeFunction = [this, provider] (const QList<InputType> &inputs) {
+                QList<InputType> acceptedInputs;
+                for (const auto &input : inputs) {
+                    if (m_predicate(input))
+                        acceptedInputs << input;
+                }
+                addRangeToProvider(provider, acceptedInputs, m_rangeConvert);
+            };
+
+            m_rangeFetch(addRangeFunction);
+            return;
+        }
+
         auto addFunction = [this, provider] (const InputType &input) {
             if (m_predicate(input))
-                provider->append(m_convert(input));
+                addToProvider(provider, input);
         };
 
         m_fetch(addFunction);
@@ -183,17 +441,172 @@ private:
         if (!provider)
             return;
 
-        while (!provider->data().isEmpty())
-            provider->removeFirst();
+        provider->removeRange(0, provider->constData().size());
+
+        m_sequenceForKey.clear();
+        m_rows.clear();
+    }
+
+    qint64 keyOf(const InputType &input) const
+    {
+        return m_key ? m_key(input) : -1;
+    }
+
+    // Rows are only ever appended, so their sequence numbers stay sorted
+    // and the row of a key is found back by bisection. Removing a row
+    // then doesn't require renumbering the keys of the following ones
+    int rowForKey(qint64 key) const
+    {
+        const qint64 sequence = m_sequenceForKey.value(key, -1);
+        if (sequence < 0)
+            return -1;
+
+        const auto it = std::lower_bound(m_rows.constBegin(), m_rows.constEnd(), sequence,
+                                         [] (const RowEntry &entry, qint64 value) {
+                                             return entry.sequence < value;
+                                         });
+        Q_ASSERT(it != m_rows.constEnd() && it->sequence == sequence);
+        return it - m_rows.constBegin();
+    }
+
+    void appendRowKey(qint64 key)
+    {
+        const qint64 sequence = m_nextSequence++;
+        if (key >= 0)
+            m_sequenceForKey.insert(key, sequence);
+        m_rows.append(RowEntry(sequence, key));
+    }
+
+    void removeRowKeys(int row, int count)
+    {
+        for (int i = row; i < row + count; i++) {
+            if (m_rows.at(i).key >= 0)
+                m_sequenceForKey.remove(m_rows.at(i).key);
+        }
+        m_rows.erase(m_rows.begin() + row, m_rows.begin() + row + count);
+    }
+
+    void addToProvider(const typename Provider::Ptr &provider, const InputType &input)
+    {
+        const qint64 key = keyOf(input);
+
+        if (key >= 0) {
+            const int row = rowForKey(key);
+
+            // Already known, it's an update in disguise
+            if (row >= 0) {
+                updateRow(provider, row, input);
+                return;
+            }
+        }
+
+        if (m_key)
+            appendRowKey(key);
+
+        provider->append(m_convert(input));
+    }
+
+    void addRangeToProvider(const typename Provider::Ptr &provider, const QList<InputType> &inputs,
+                            const RangeConvertFunction &rangeConvert)
+    {
+        const int firstRow = provider->constData().size();
+        QList<InputType> inputsToConvert;
+        QList<OutputType> outputs;
+
+        for (const auto &input : inputs) {
+            const qint64 key = keyOf(input);
+
+            if (key >= 0) {
+                const int row = rowForKey(key);
+
+                if (row >= firstRow) {
+                    // Already part of this batch
+                    if (rangeConvert)
+                        inputsToConvert[row - firstRow] = input;
+                    else
+                        m_update(input, outputs[row - firstRow]);
+                    continue;
+                } else if (row >= 0) {
+                    updateRow(provider, row, input);
+                    continue;
+                }
+            }
+
+            if (m_key)
+                appendRowKey(key);
+
+            if (rangeConvert)
+                inputsToConvert.append(input);
+            else
+                outputs.append(m_convert(input));
+        }
+
+        if (rangeConvert && !inputsToConvert.isEmpty())
+            outputs = rangeConvert(inputsToConvert);
+
+        provider->appendRange(outputs);
+    }
+
+    void updateRow(const typename Provider::Ptr &provider, int row, const InputType &input)
+    {
+        auto output = provider->constData().at(row);
+        m_update(input, output);
+        provider->replace(row, output);
+    }
+
+    void removeRow(const typename Provider::Ptr &provider, int row)
+    {
+        provider->removeAt(row);
+
+        if (m_key)
+            removeRowKeys(row, 1);
+    }
+
+    void removeRows(const typename Provider::Ptr &provider, QList<int> rows)
+    {
+        if (rows.isEmpty())
+            return;
+
+        std::sort(rows.begin(), rows.end());
+
+        // Remove contiguous rows as ranges starting from the end so that
+        // the remaining rows to remove stay valid
+        int last = rows.size() - 1;
+        while (last >= 0) {
+            int first = last;
+            while (first > 0 && rows.at(first - 1) == rows.at(first) - 1)
+                first--;
+
+            const int row = rows.at(first);
+            const int count = last - first + 1;
+            provider->removeRange(row, count);
+            if (m_key)
+                removeRowKeys(row, count);
+
+            last = first - 1;
+        }
     }
 
     FetchFunction m_fetch;
+    RangeFetchFunction m_rangeFetch;
     PredicateFunction m_predicate;
     ConvertFunction m_convert;
+    RangeConvertFunction m_rangeConvert;
     UpdateFunction m_update;
     RepresentsFunction m_represents;
+    KeyFunction m_key;
+    HoldFunction m_hold;
+    ScopeFunction m_scope;
+    PostFunction m_post;
 
     typename Provider::WeakPtr m_provider;
+    QHash<qint64, qint64> m_sequenceForKey;
+    QVector<RowEntry> m_rows;
+    qint64 m_nextSequence;
+
+    bool m_batching;
+    QList<PendingChange> m_pending;
+    QHash<qint64, int> m_pendingIndex;
 };
 
 
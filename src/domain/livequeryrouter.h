@@ -0,0 +1,186 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#ifndef DOMAIN_LIVEQUERYROUTER_H
+#define DOMAIN_LIVEQUERYROUTER_H
+
+#include <QHash>
+
+#include "livequery.h"
+
+namespace Domain {
+
+// Dispatches change notifications only to the queries they can affect.
+// Each query is registered under the route it depends on (e.g. the uid of
+// a parent), and the router remembers the route under which it last saw
+// an input so that the query holding it can be told when it moves away.
+// Queries added without a route keep receiving every notification.
+template<typename InputType, typename OutputType, typename RouteType>
+class LiveQueryRouter
+{
+public:
+    typedef LiveQuery<InputType, OutputType> Query;
+
+    typedef std::function<RouteType(const InputType &)> RouteFunction;
+    typedef std::function<qint64(const InputType &)> KeyFunction;
+
+    void setRouteFunction(const RouteFunction &route)
+    {
+        m_route = route;
+    }
+
+    void setKeyFunction(const KeyFunction &key)
+    {
+        m_key = key;
+    }
+
+    void addQuery(const typename Query::Ptr &query)
+    {
+        m_unroutedQueries << query;
+    }
+
+    void addQuery(const RouteType &route, const typename Query::Ptr &query)
+    {
+        m_queries.insert(route, query);
+    }
+
+    typename Query::Ptr query(const RouteType &route) const
+    {
+        return m_queries.value(route);
+    }
+
+    typename Query::Ptr takeQuery(const RouteType &route)
+    {
+        return m_queries.take(route);
+    }
+
+    typename Query::List queries() const
+    {
+        return m_unroutedQueries + m_queries.values();
+    }
+
+    void track(const InputType &input)
+    {
+        if (!m_queries.isEmpty())
+            track(input, m_route(input));
+    }
+
+    void track(const QList<InputType> &inputs)
+    {
+        for (const auto &input : inputs)
+            track(input);
+    }
+
+    void onAdded(const InputType &input)
+    {
+        for (const auto &query : m_unroutedQueries)
+            query->onAdded(input);
+
+        if (!m_queries.isEmpty())
+            addRouted(input, m_route(input));
+    }
+
+    void onAdded(const InputType &input, const RouteType &route)
+    {
+        for (const auto &query : m_unroutedQueries)
+            query->onAdded(input);
+
+        addRouted(input, route);
+    }
+
+    void onChanged(const InputType &input)
+    {
+        for (const auto &query : m_unroutedQueries)
+            query->onChanged(input);
+
+        if (!m_queries.isEmpty())
+            changeRouted(input, m_route(input));
+    }
+
+    void onChanged(const InputType &input, const RouteType &route)
+    {
+        for (const auto &query : m_unroutedQueries)
+            query->onChanged(input);
+
+        changeRouted(input, route);
+    }
+
+    void onRemoved(const InputType &input)
+    {
+        for (const auto &query : m_unroutedQueries)
+            query->onRemoved(input);
+
+        const qint64 key = m_key(input);
+        if (!m_routeForKey.contains(key))
+            return;
+
+        const auto route = m_routeForKey.take(key);
+        if (auto query = m_queries.value(route))
+            query->onRemoved(input);
+    }
+
+private:
+    void track(const InputType &input, const RouteType &route)
+    {
+        // Only inputs which can be held by a routed query need to be remembered
+        if (m_queries.contains(route))
+            m_routeForKey.insert(m_key(input), route);
+        else
+            m_routeForKey.remove(m_key(input));
+    }
+
+    void addRouted(const InputType &input, const RouteType &route)
+    {
+        track(input, route);
+        if (auto query = m_queries.value(route))
+            query->onAdded(input);
+    }
+
+    void changeRouted(const InputType &input, const RouteType &route)
+    {
+        const qint64 key = m_key(input);
+        if (m_routeForKey.contains(key)) {
+            const auto previous = m_routeForKey.value(key);
+            if (previous != route) {
+                if (auto query = m_queries.value(previous))
+                    query->onChanged(input);
+            }
+        }
+
+        track(input, route);
+        if (auto query = m_queries.value(route))
+            query->onChanged(input);
+    }
+
+    RouteFunction m_route;
+    KeyFunction m_key;
+
+    typename Query::List m_unroutedQueries;
+    QHash<RouteType, typename Query::Ptr> m_queries;
+    QHash<qint64, RouteType> m_routeForKey;
+};
+
+}
+
+#endif // DOMAIN_LIVEQUERYROUTER_H
@@ -50,11 +50,12 @@ public:
         //We need to keep the pointer around
         m_inputResults << result;
 
-        result->addPostInsertHandler([this](const ItemType &item, int){
-            this->append(item);
+        result->addPostInsertRangeHandler([this](const QueryResultRange<ItemType> &items, int){
+            this->appendRange(items.toList());
         });
-        result->addPreRemoveHandler([this](const ItemType &item, int){
-            this->remove(item);
+        result->addPreRemoveRangeHandler([this](const QueryResultRange<ItemType> &items, int){
+            for (const auto &item : items)
+                this->remove(item);
         });
 
         //FIXME we need a better replace handler
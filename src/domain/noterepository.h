@@ -45,6 +45,8 @@ public:
     virtual KJob *createInTag(Note::Ptr task, Tag::Ptr tag) = 0;
     virtual KJob *save(Note::Ptr note) = 0;
     virtual KJob *remove(Note::Ptr note) = 0;
+
+    virtual KJob *load(Note::Ptr note) = 0;
 };
 
 }
@@ -48,3 +48,13 @@ void Project::setName(const QString &name)
     m_name = name;
     emit nameChanged(name);
 }
+
+const BackendIdentity &Project::backendIdentity() const
+{
+    return m_backendIdentity;
+}
+
+BackendIdentity &Project::backendIdentity()
+{
+    return m_backendIdentity;
+}
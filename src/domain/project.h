@@ -29,6 +29,8 @@
 #include <QSharedPointer>
 #include <QString>
 
+#include "backendidentity.h"
+
 namespace Domain {
 
 class Project : public QObject
@@ -45,6 +47,9 @@ public:
 
     QString name() const;
 
+    const BackendIdentity &backendIdentity() const;
+    BackendIdentity &backendIdentity();
+
 public slots:
     void setName(const QString &name);
 
@@ -53,6 +58,7 @@ signals:
 
 private:
     QString m_name;
+    BackendIdentity m_backendIdentity;
 };
 
 }
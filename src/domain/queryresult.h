@@ -40,6 +40,7 @@ public:
     typedef QSharedPointer<QueryResult<InputType, OutputType>> Ptr;
     typedef QWeakPointer<QueryResult<InputType, OutputType>> WeakPtr;
     typedef std::function<void(OutputType, int)> ChangeHandler;
+    typedef std::function<void(const QueryResultRange<OutputType> &, int)> ChangeRangeHandler;
 
     static Ptr create(const typename QueryResultProvider<InputType>::Ptr &provider)
     {
@@ -59,7 +60,19 @@ public:
 
     QList<OutputType> data() const
     {
-        return dataImpl<OutputType>();
+        auto provider = QueryResultInputImpl<InputType>::m_provider;
+        return convertList<OutputType>(provider->data());
+    }
+
+    int size() const
+    {
+        return QueryResultInputImpl<InputType>::m_provider->constData().size();
+    }
+
+    // Only the requested element gets converted
+    OutputType at(int index) const
+    {
+        return OutputType(QueryResultInputImpl<InputType>::m_provider->constData().at(index));
     }
 
     void addPreInsertHandler(const ChangeHandler &handler)
@@ -97,26 +110,76 @@ public:
         QueryResultInputImpl<InputType>::m_doneHandlers << handler;
     }
 
+    void addPreInsertRangeHandler(const ChangeRangeHandler &handler)
+    {
+        QueryResultInputImpl<InputType>::addRangeHandler(QueryResultInputImpl<InputType>::m_preInsertRangeHandlers, convertRangeHandler(handler));
+    }
+
+    void addPostInsertRangeHandler(const ChangeRangeHandler &handler)
+    {
+        QueryResultInputImpl<InputType>::addRangeHandler(QueryResultInputImpl<InputType>::m_postInsertRangeHandlers, convertRangeHandler(handler));
+    }
+
+    void addPreRemoveRangeHandler(const ChangeRangeHandler &handler)
+    {
+        QueryResultInputImpl<InputType>::addRangeHandler(QueryResultInputImpl<InputType>::m_preRemoveRangeHandlers, convertRangeHandler(handler));
+    }
+
+    void addPostRemoveRangeHandler(const ChangeRangeHandler &handler)
+    {
+        QueryResultInputImpl<InputType>::addRangeHandler(QueryResultInputImpl<InputType>::m_postRemoveRangeHandlers, convertRangeHandler(handler));
+    }
+
 private:
     explicit QueryResult(const typename QueryResultProvider<InputType>::Ptr &provider)
         : QueryResultInputImpl<InputType>(provider)
     {
     }
 
+    static typename QueryResultInputImpl<InputType>::ChangeRangeHandler convertRangeHandler(const ChangeRangeHandler &handler)
+    {
+        return [handler] (const QueryResultRange<InputType> &items, int index) {
+            forwardRange<OutputType>(handler, items, index);
+        };
+    }
+
+    // Same types go through untouched, otherwise only the notified
+    // items get converted
     template<typename T>
-    typename std::enable_if<std::is_same<InputType, T>::value, QList<InputType>>::type
-    dataImpl() const
+    static typename std::enable_if<std::is_same<InputType, T>::value>::type
+    forwardRange(const ChangeRangeHandler &handler, const QueryResultRange<InputType> &items, int index)
     {
-        auto provider = QueryResultInputImpl<InputType>::m_provider;
-        return provider->data();
+        handler(items, index);
     }
 
     template<typename T>
-    typename std::enable_if<!std::is_same<InputType, T>::value, QList<T>>::type
-    dataImpl() const
+    static typename std::enable_if<!std::is_same<InputType, T>::value>::type
+    forwardRange(const ChangeRangeHandler &handler, const QueryResultRange<InputType> &items, int index)
+    {
+        if (items.size() == 1) {
+            const T output(items.at(0));
+            handler(QueryResultRange<T>(output), index);
+            return;
+        }
+
+        QList<T> outputs;
+        outputs.reserve(items.size());
+        for (int i = 0; i < items.size(); i++)
+            outputs << T(items.at(i));
+        handler(QueryResultRange<T>(outputs), index);
+    }
+
+    template<typename T>
+    static typename std::enable_if<std::is_same<InputType, T>::value, QList<InputType>>::type
+    convertList(const QList<InputType> &inputData)
+    {
+        return inputData;
+    }
+
+    template<typename T>
+    static typename std::enable_if<!std::is_same<InputType, T>::value, QList<T>>::type
+    convertList(const QList<InputType> &inputData)
     {
-        auto provider = QueryResultInputImpl<InputType>::m_provider;
-        QList<InputType> inputData = provider->data();
         QList<OutputType> outputData;
         std::transform(inputData.constBegin(), inputData.constEnd(),
                        std::back_inserter(outputData),
@@ -27,8 +27,11 @@
 
 #include <functional>
 
+#include <QList>
 #include <QSharedPointer>
 
+#include "queryresultrange.h"
+
 namespace Domain {
 
 template<typename OutputType>
@@ -38,17 +41,50 @@ public:
     typedef QSharedPointer<QueryResultInterface<OutputType>> Ptr;
     typedef QWeakPointer<QueryResultInterface<OutputType>> WeakPtr;
     typedef std::function<void(OutputType, int)> ChangeHandler;
+    typedef std::function<void(const QueryResultRange<OutputType> &, int)> ChangeRangeHandler;
+
+    // Read only iteration over a result going through at(), so that
+    // walking a result doesn't copy or convert the whole list
+    class const_iterator
+    {
+    public:
+        const_iterator(const QueryResultInterface<OutputType> *result, int index)
+            : m_result(result), m_index(index)
+        {
+        }
+
+        OutputType operator*() const { return m_result->at(m_index); }
+        const_iterator &operator++() { m_index++; return *this; }
+        bool operator==(const const_iterator &other) const { return m_index == other.m_index && m_result == other.m_result; }
+        bool operator!=(const const_iterator &other) const { return !(*this == other); }
+
+    private:
+        const QueryResultInterface<OutputType> *m_result;
+        int m_index;
+    };
 
     virtual ~QueryResultInterface() {}
 
     virtual QList<OutputType> data() const = 0;
 
+    virtual int size() const = 0;
+    virtual OutputType at(int index) const = 0;
+
+    bool isEmpty() const { return size() == 0; }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
     virtual void addPreInsertHandler(const ChangeHandler &handler) = 0;
     virtual void addPostInsertHandler(const ChangeHandler &handler) = 0;
     virtual void addPreRemoveHandler(const ChangeHandler &handler) = 0;
     virtual void addPostRemoveHandler(const ChangeHandler &handler) = 0;
     virtual void addPreReplaceHandler(const ChangeHandler &handler) = 0;
     virtual void addPostReplaceHandler(const ChangeHandler &handler) = 0;
+
+    virtual void addPreInsertRangeHandler(const ChangeRangeHandler &handler) = 0;
+    virtual void addPostInsertRangeHandler(const ChangeRangeHandler &handler) = 0;
+    virtual void addPreRemoveRangeHandler(const ChangeRangeHandler &handler) = 0;
+    virtual void addPostRemoveRangeHandler(const ChangeRangeHandler &handler) = 0;
 };
 
 }
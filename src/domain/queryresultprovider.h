@@ -31,6 +31,8 @@
 #include <QList>
 #include <QSharedPointer>
 
+#include "queryresultrange.h"
+
 namespace Domain {
 
 template<typename ItemType>
@@ -45,8 +47,17 @@ public:
     typedef QWeakPointer<QueryResultInputImpl<InputType>> WeakPtr;
     typedef std::function<void(InputType, int)> ChangeHandler;
     typedef QList<ChangeHandler> ChangeHandlerList;
+    typedef std::function<void(const QueryResultRange<InputType> &, int)> ChangeRangeHandler;
+    typedef QList<ChangeRangeHandler> ChangeRangeHandlerList;
 
-    virtual ~QueryResultInputImpl() {}
+    virtual ~QueryResultInputImpl()
+    {
+        if (m_provider)
+            m_provider->m_rangeHandlerCount -= m_preInsertRangeHandlers.size()
+                                              + m_postInsertRangeHandlers.size()
+                                              + m_preRemoveRangeHandlers.size()
+                                              + m_postRemoveRangeHandlers.size();
+    }
 
 protected:
     explicit QueryResultInputImpl(const ProviderPtr &provider)
@@ -56,6 +67,7 @@ protected:
 
     static void registerResult(const ProviderPtr &provider, const Ptr &result)
     {
+        provider->cleanupResults();
         provider->m_results << result;
     }
 
@@ -64,55 +76,91 @@ protected:
         return result->m_provider;
     }
 
+    // The provider keeps count of the range handlers so that single item
+    // changes don't have to look for them in every result
+    void addRangeHandler(ChangeRangeHandlerList &handlers, const ChangeRangeHandler &handler)
+    {
+        handlers << handler;
+        m_provider->m_rangeHandlerCount++;
+    }
+
     // cppcheck can't figure out the friend class
     // cppcheck-suppress unusedPrivateFunction
-    ChangeHandlerList preInsertHandlers() const
+    const ChangeHandlerList &preInsertHandlers() const
     {
         return m_preInsertHandlers;
     }
 
     // cppcheck can't figure out the friend class
     // cppcheck-suppress unusedPrivateFunction
-    ChangeHandlerList postInsertHandlers() const
+    const ChangeHandlerList &postInsertHandlers() const
     {
         return m_postInsertHandlers;
     }
 
     // cppcheck can't figure out the friend class
     // cppcheck-suppress unusedPrivateFunction
-    ChangeHandlerList preRemoveHandlers() const
+    const ChangeHandlerList &preRemoveHandlers() const
     {
         return m_preRemoveHandlers;
     }
 
     // cppcheck can't figure out the friend class
     // cppcheck-suppress unusedPrivateFunction
-    ChangeHandlerList postRemoveHandlers() const
+    const ChangeHandlerList &postRemoveHandlers() const
     {
         return m_postRemoveHandlers;
     }
 
     // cppcheck can't figure out the friend class
     // cppcheck-suppress unusedPrivateFunction
-    ChangeHandlerList preReplaceHandlers() const
+    const ChangeHandlerList &preReplaceHandlers() const
     {
         return m_preReplaceHandlers;
     }
 
     // cppcheck can't figure out the friend class
     // cppcheck-suppress unusedPrivateFunction
-    ChangeHandlerList postReplaceHandlers() const
+    const ChangeHandlerList &postReplaceHandlers() const
     {
         return m_postReplaceHandlers;
     }
 
     // cppcheck can't figure out the friend class
     // cppcheck-suppress unusedPrivateFunction
-    ChangeHandlerList doneHandlers() const
+    const ChangeHandlerList &doneHandlers() const
     {
         return m_doneHandlers;
     }
 
+    // cppcheck can't figure out the friend class
+    // cppcheck-suppress unusedPrivateFunction
+    const ChangeRangeHandlerList &preInsertRangeHandlers() const
+    {
+        return m_preInsertRangeHandlers;
+    }
+
+    // cppcheck can't figure out the friend class
+    // cppcheck-suppress unusedPrivateFunction
+    const ChangeRangeHandlerList &postInsertRangeHandlers() const
+    {
+        return m_postInsertRangeHandlers;
+    }
+
+    // cppcheck can't figure out the friend class
+    // cppcheck-suppress unusedPrivateFunction
+    const ChangeRangeHandlerList &preRemoveRangeHandlers() const
+    {
+        return m_preRemoveRangeHandlers;
+    }
+
+    // cppcheck can't figure out the friend class
+    // cppcheck-suppress unusedPrivateFunction
+    const ChangeRangeHandlerList &postRemoveRangeHandlers() const
+    {
+        return m_postRemoveRangeHandlers;
+    }
+
     friend class QueryResultProvider<InputType>;
     ProviderPtr m_provider;
     ChangeHandlerList m_preInsertHandlers;
@@ -122,6 +170,10 @@ protected:
     ChangeHandlerList m_preReplaceHandlers;
     ChangeHandlerList m_postReplaceHandlers;
     ChangeHandlerList m_doneHandlers;
+    ChangeRangeHandlerList m_preInsertRangeHandlers;
+    ChangeRangeHandlerList m_postInsertRangeHandlers;
+    ChangeRangeHandlerList m_preRemoveRangeHandlers;
+    ChangeRangeHandlerList m_postRemoveRangeHandlers;
 };
 
 template<typename ItemType>
@@ -135,9 +187,12 @@ public:
     typedef QWeakPointer<QueryResultInputImpl<ItemType>> ResultWeakPtr;
     typedef std::function<void(ItemType, int)> ChangeHandler;
     typedef QList<ChangeHandler> ChangeHandlerList;
+    typedef std::function<void(const QueryResultRange<ItemType> &, int)> ChangeRangeHandler;
+    typedef QList<ChangeRangeHandler> ChangeRangeHandlerList;
 
 
     QueryResultProvider()
+        : m_rangeHandlerCount(0)
     {
     }
 
@@ -146,53 +201,111 @@ public:
         return m_list;
     }
 
+    // Unlike data() this doesn't hold a copy of the list, so mutating the
+    // provider while it is being used won't trigger a detach
+    const QList<ItemType> &constData() const
+    {
+        return m_list;
+    }
+
     void append(const ItemType &item)
     {
-        cleanupResults();
-        ChangeHandlerGetter preInsert = [](ResultPtr ptr) { return ptr->preInsertHandlers(); };
-        ChangeHandlerGetter postInsert = [](ResultPtr ptr) { return ptr->postInsertHandlers(); };
-        callChangeHandlers(item, m_list.size(), preInsert);
+        const ChangeHandlerGetter preInsert = &QueryResultInputImpl<ItemType>::preInsertHandlers;
+        const ChangeHandlerGetter postInsert = &QueryResultInputImpl<ItemType>::postInsertHandlers;
+        const ChangeRangeHandlerGetter preInsertRange = &QueryResultInputImpl<ItemType>::preInsertRangeHandlers;
+        const ChangeRangeHandlerGetter postInsertRange = &QueryResultInputImpl<ItemType>::postInsertRangeHandlers;
+        callChangeHandlers(item, m_list.size(), preInsert, preInsertRange);
         m_list.append(item);
-        callChangeHandlers(item, m_list.size()-1, postInsert);
+        callChangeHandlers(item, m_list.size()-1, postInsert, postInsertRange);
     }
 
     void prepend(const ItemType &item)
     {
-        cleanupResults();
-        ChangeHandlerGetter preInsert = [](ResultPtr ptr) { return ptr->preInsertHandlers(); };
-        ChangeHandlerGetter postInsert = [](ResultPtr ptr) { return ptr->postInsertHandlers(); };
-        callChangeHandlers(item, 0, preInsert);
+        const ChangeHandlerGetter preInsert = &QueryResultInputImpl<ItemType>::preInsertHandlers;
+        const ChangeHandlerGetter postInsert = &QueryResultInputImpl<ItemType>::postInsertHandlers;
+        const ChangeRangeHandlerGetter preInsertRange = &QueryResultInputImpl<ItemType>::preInsertRangeHandlers;
+        const ChangeRangeHandlerGetter postInsertRange = &QueryResultInputImpl<ItemType>::postInsertRangeHandlers;
+        callChangeHandlers(item, 0, preInsert, preInsertRange);
         m_list.prepend(item);
-        callChangeHandlers(item, 0, postInsert);
+        callChangeHandlers(item, 0, postInsert, postInsertRange);
     }
 
     void done()
     {
-        cleanupResults();
-        ChangeHandlerGetter done = [](ResultPtr ptr) { return ptr->doneHandlers(); };
+        const ChangeHandlerGetter done = &QueryResultInputImpl<ItemType>::doneHandlers;
         callChangeHandlers(ItemType(), 0, done);
     }
 
     void insert(int index, const ItemType &item)
     {
-        cleanupResults();
-        ChangeHandlerGetter preInsert = [](ResultPtr ptr) { return ptr->preInsertHandlers(); };
-        ChangeHandlerGetter postInsert = [](ResultPtr ptr) { return ptr->postInsertHandlers(); };
-        callChangeHandlers(item, index, preInsert);
+        const ChangeHandlerGetter preInsert = &QueryResultInputImpl<ItemType>::preInsertHandlers;
+        const ChangeHandlerGetter postInsert = &QueryResultInputImpl<ItemType>::postInsertHandlers;
+        const ChangeRangeHandlerGetter preInsertRange = &QueryResultInputImpl<ItemType>::preInsertRangeHandlers;
+        const ChangeRangeHandlerGetter postInsertRange = &QueryResultInputImpl<ItemType>::postInsertRangeHandlers;
+        callChangeHandlers(item, index, preInsert, preInsertRange);
         m_list.insert(index, item);
-        callChangeHandlers(item, index, postInsert);
+        callChangeHandlers(item, index, postInsert, postInsertRange);
+    }
+
+    void appendRange(const QList<ItemType> &items)
+    {
+        insertRange(m_list.size(), items);
+    }
+
+    // Results only interested in ranges get a single notification for the
+    // whole range, if any result still relies on per item handlers we have
+    // no choice but to go through the items one by one
+    void insertRange(int index, const QList<ItemType> &items)
+    {
+        if (items.isEmpty())
+            return;
+
+        const ChangeHandlerGetter preInsert = &QueryResultInputImpl<ItemType>::preInsertHandlers;
+        const ChangeHandlerGetter postInsert = &QueryResultInputImpl<ItemType>::postInsertHandlers;
+
+        if (hasChangeHandlers(preInsert) || hasChangeHandlers(postInsert)) {
+            for (int i = 0; i < items.size(); i++)
+                insert(index + i, items.at(i));
+            return;
+        }
+
+        const ChangeRangeHandlerGetter preInsertRange = &QueryResultInputImpl<ItemType>::preInsertRangeHandlers;
+        const ChangeRangeHandlerGetter postInsertRange = &QueryResultInputImpl<ItemType>::postInsertRangeHandlers;
+        const QueryResultRange<ItemType> range(items);
+        callChangeRangeHandlers(range, index, preInsertRange);
+        if (index == m_list.size())
+            m_list.append(items);
+        else
+            m_list = m_list.mid(0, index) + items + m_list.mid(index);
+        callChangeRangeHandlers(range, index, postInsertRange);
+    }
+
+    void removeRange(int index, int count)
+    {
+        if (count <= 0)
+            return;
+
+        const ChangeHandlerGetter preRemove = &QueryResultInputImpl<ItemType>::preRemoveHandlers;
+        const ChangeHandlerGetter postRemove = &QueryResultInputImpl<ItemType>::postRemoveHandlers;
+
+        if (hasChangeHandlers(preRemove) || hasChangeHandlers(postRemove)) {
+            for (int i = 0; i < count; i++)
+                removeAt(index);
+            return;
+        }
+
+        const ChangeRangeHandlerGetter preRemoveRange = &QueryResultInputImpl<ItemType>::preRemoveRangeHandlers;
+        const ChangeRangeHandlerGetter postRemoveRange = &QueryResultInputImpl<ItemType>::postRemoveRangeHandlers;
+        const QList<ItemType> items = m_list.mid(index, count);
+        const QueryResultRange<ItemType> range(items);
+        callChangeRangeHandlers(range, index, preRemoveRange);
+        m_list.erase(m_list.begin() + index, m_list.begin() + index + count);
+        callChangeRangeHandlers(range, index, postRemoveRange);
     }
 
     ItemType takeFirst()
     {
-        cleanupResults();
-        ChangeHandlerGetter preRemove = [](ResultPtr ptr) { return ptr->preRemoveHandlers(); };
-        ChangeHandlerGetter postRemove = [](ResultPtr ptr) { return ptr->postRemoveHandlers(); };
-        const ItemType item = m_list.first();
-        callChangeHandlers(item, 0, preRemove);
-        m_list.removeFirst();
-        callChangeHandlers(item, 0, postRemove);
-        return item;
+        return takeAt(0);
     }
 
     void removeFirst()
@@ -202,14 +315,7 @@ public:
 
     ItemType takeLast()
     {
-        cleanupResults();
-        ChangeHandlerGetter preRemove = [](ResultPtr ptr) { return ptr->preRemoveHandlers(); };
-        ChangeHandlerGetter postRemove = [](ResultPtr ptr) { return ptr->postRemoveHandlers(); };
-        const ItemType item = m_list.last();
-        callChangeHandlers(item, m_list.size()-1, preRemove);
-        m_list.removeLast();
-        callChangeHandlers(item, m_list.size(), postRemove);
-        return item;
+        return takeAt(m_list.size() - 1);
     }
 
     void removeLast()
@@ -219,13 +325,14 @@ public:
 
     ItemType takeAt(int index)
     {
-        cleanupResults();
-        ChangeHandlerGetter preRemove = [](ResultPtr ptr) { return ptr->preRemoveHandlers(); };
-        ChangeHandlerGetter postRemove = [](ResultPtr ptr) { return ptr->postRemoveHandlers(); };
+        const ChangeHandlerGetter preRemove = &QueryResultInputImpl<ItemType>::preRemoveHandlers;
+        const ChangeHandlerGetter postRemove = &QueryResultInputImpl<ItemType>::postRemoveHandlers;
+        const ChangeRangeHandlerGetter preRemoveRange = &QueryResultInputImpl<ItemType>::preRemoveRangeHandlers;
+        const ChangeRangeHandlerGetter postRemoveRange = &QueryResultInputImpl<ItemType>::postRemoveRangeHandlers;
         const ItemType item = m_list.at(index);
-        callChangeHandlers(item, index, preRemove);
+        callChangeHandlers(item, index, preRemove, preRemoveRange);
         m_list.removeAt(index);
-        callChangeHandlers(item, index, postRemove);
+        callChangeHandlers(item, index, postRemove, postRemoveRange);
         return item;
     }
 
@@ -242,9 +349,8 @@ public:
 
     void replace(int index, const ItemType &item)
     {
-        cleanupResults();
-        ChangeHandlerGetter preReplace = [](ResultPtr ptr) { return ptr->preReplaceHandlers(); };
-        ChangeHandlerGetter postReplace = [](ResultPtr ptr) { return ptr->postReplaceHandlers(); };
+        const ChangeHandlerGetter preReplace = &QueryResultInputImpl<ItemType>::preReplaceHandlers;
+        const ChangeHandlerGetter postReplace = &QueryResultInputImpl<ItemType>::postReplaceHandlers;
         callChangeHandlers(m_list.at(index), index, preReplace);
         m_list.replace(index, item);
         callChangeHandlers(item, index, postReplace);
@@ -257,6 +363,8 @@ public:
     }
 
 private:
+    // Only called when registering a new result, dispatching skips
+    // the dead results so we don't need to pay for a pass on each change
     void cleanupResults()
     {
         m_results.erase(std::remove_if(m_results.begin(),
@@ -265,24 +373,61 @@ private:
                         m_results.end());
     }
 
-    typedef std::function<ChangeHandlerList(ResultPtr)> ChangeHandlerGetter;
+    // Plain member function pointers, handlers are iterated in place
+    // without copying the lists or wrapping the getters in std::function
+    typedef const ChangeHandlerList &(QueryResultInputImpl<ItemType>::*ChangeHandlerGetter)() const;
+    typedef const ChangeRangeHandlerList &(QueryResultInputImpl<ItemType>::*ChangeRangeHandlerGetter)() const;
+
+    // Indices are used on purpose, handlers might register new results
+    // or handlers while we're iterating
+    void callChangeHandlers(const ItemType &item, int index, ChangeHandlerGetter handlerGetter)
+    {
+        for (int i = 0; i < m_results.size(); i++) {
+            const auto result = m_results.at(i).toStrongRef();
+            if (!result) continue;
+
+            const ChangeHandlerList &handlers = (result.data()->*handlerGetter)();
+            for (int j = 0; j < handlers.size(); j++)
+                handlers.at(j)(item, index);
+        }
+    }
+
+    void callChangeHandlers(const ItemType &item, int index,
+                            ChangeHandlerGetter handlerGetter,
+                            ChangeRangeHandlerGetter rangeHandlerGetter)
+    {
+        callChangeHandlers(item, index, handlerGetter);
+
+        if (m_rangeHandlerCount > 0)
+            callChangeRangeHandlers(QueryResultRange<ItemType>(item), index, rangeHandlerGetter);
+    }
 
-    void callChangeHandlers(const ItemType &item, int index, const ChangeHandlerGetter &handlerGetter)
+    void callChangeRangeHandlers(const QueryResultRange<ItemType> &items, int index, ChangeRangeHandlerGetter handlerGetter)
     {
-        for (auto weakResult : m_results)
-        {
-            auto result = weakResult.toStrongRef();
+        for (int i = 0; i < m_results.size(); i++) {
+            const auto result = m_results.at(i).toStrongRef();
             if (!result) continue;
-            for (auto handler : handlerGetter(result))
-            {
-                handler(item, index);
-            }
+
+            const ChangeRangeHandlerList &handlers = (result.data()->*handlerGetter)();
+            for (int j = 0; j < handlers.size(); j++)
+                handlers.at(j)(items, index);
+        }
+    }
+
+    bool hasChangeHandlers(ChangeHandlerGetter handlerGetter) const
+    {
+        for (int i = 0; i < m_results.size(); i++) {
+            const auto result = m_results.at(i).toStrongRef();
+            if (result && !(result.data()->*handlerGetter)().isEmpty())
+                return true;
         }
+        return false;
     }
 
     friend class QueryResultInputImpl<ItemType>;
     QList<ItemType> m_list;
     QList<ResultWeakPtr> m_results;
+    int m_rangeHandlerCount;
 };
 
 }
@@ -0,0 +1,96 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#ifndef DOMAIN_QUERYRESULTRANGE_H
+#define DOMAIN_QUERYRESULTRANGE_H
+
+#include <QList>
+
+namespace Domain {
+
+// Non owning view on the items given to the range handlers, it points
+// either to a single item or to a slice of a list so that notifying a
+// single change doesn't need a list to be built. It is only valid for
+// the duration of the handler call, use toList() to keep the items.
+template<typename ItemType>
+class QueryResultRange
+{
+public:
+    class const_iterator
+    {
+    public:
+        const_iterator(const QueryResultRange<ItemType> *range, int index)
+            : m_range(range), m_index(index)
+        {
+        }
+
+        const ItemType &operator*() const { return m_range->at(m_index); }
+        const_iterator &operator++() { m_index++; return *this; }
+        bool operator==(const const_iterator &other) const { return m_index == other.m_index && m_range == other.m_range; }
+        bool operator!=(const const_iterator &other) const { return !(*this == other); }
+
+    private:
+        const QueryResultRange<ItemType> *m_range;
+        int m_index;
+    };
+
+    explicit QueryResultRange(const ItemType &item)
+        : m_item(&item), m_list(0), m_offset(0), m_size(1)
+    {
+    }
+
+    explicit QueryResultRange(const QList<ItemType> &list, int offset = 0, int size = -1)
+        : m_item(0), m_list(&list), m_offset(offset),
+          m_size(size < 0 ? list.size() - offset : size)
+    {
+    }
+
+    int size() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+
+    const ItemType &at(int index) const
+    {
+        return m_item ? *m_item : m_list->at(m_offset + index);
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, m_size); }
+
+    QList<ItemType> toList() const
+    {
+        if (m_item)
+            return QList<ItemType>() << *m_item;
+        return m_list->mid(m_offset, m_size);
+    }
+
+private:
+    const ItemType *m_item;
+    const QList<ItemType> *m_list;
+    int m_offset;
+    int m_size;
+};
+
+}
+
+#endif // DOMAIN_QUERYRESULTRANGE_H
@@ -48,3 +48,13 @@ void Tag::setName(const QString &name)
     m_name = name;
     emit nameChanged(name);
 }
+
+const BackendIdentity &Tag::backendIdentity() const
+{
+    return m_backendIdentity;
+}
+
+BackendIdentity &Tag::backendIdentity()
+{
+    return m_backendIdentity;
+}
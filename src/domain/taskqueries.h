@@ -40,6 +40,10 @@ public:
 
     virtual QueryResult<Task::Ptr>::Ptr findChildren(Task::Ptr task) const = 0;
 
+    // Cheap hint which doesn't start a query per task, it can claim
+    // there are children when there are none but never the opposite
+    virtual bool mayHaveChildren(Task::Ptr task) const = 0;
+
     virtual QueryResult<Task::Ptr>::Ptr findTopLevel() const = 0;
 
     virtual QueryResult<Context::Ptr>::Ptr findContexts(Task::Ptr task) const = 0;
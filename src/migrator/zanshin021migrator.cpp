@@ -52,7 +52,7 @@ Zanshin021Migrator::SeenItemHash Zanshin021Migrator::fetchAllItems()
 
     auto collections = collectionsJob->collections();
     for (const auto &collection : collections) {
-        auto job = m_storage.fetchItems(collection);
+        auto job = m_storage.fetchFullItems(collection);
         job->kjob()->exec();
         auto items = job->items();
         for (const Akonadi::Item &item : items) {
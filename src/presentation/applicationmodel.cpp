@@ -40,6 +40,7 @@
 #include "presentation/availablepagesmodel.h"
 #include "presentation/availablesourcesmodel.h"
 #include "presentation/datasourcelistmodel.h"
+#include "presentation/pagemodel.h"
 
 #include "utils/dependencymanager.h"
 
@@ -260,6 +261,11 @@ void ApplicationModel::setCurrentPage(QObject *page)
     if (page == m_currentPage)
         return;
 
+    // Nobody will look at the previous page anymore, its fetches
+    // shouldn't hold back the ones of the new page
+    if (auto previousPage = qobject_cast<PageModel*>(m_currentPage))
+        previousPage->cancelJobs();
+
     m_currentPage = page;
     emit currentPageChanged(page);
 }
@@ -95,6 +95,13 @@ void ArtifactEditorModel::setArtifact(const Domain::Artifact::Ptr &artifact)
                 this, SLOT(onTitleChanged(QString)));
     }
 
+    // The lists only load the note headers, the body will come
+    // through textChanged() once loaded
+    if (auto note = artifact.objectCast<Domain::Note>()) {
+        if (note->backendIdentity().isPartial())
+            m_noteRepository->load(note);
+    }
+
     if (auto task = artifact.objectCast<Domain::Task>()) {
         m_start = task->startDate();
         m_due = task->dueDate();
@@ -33,9 +33,67 @@
 
 using namespace Presentation;
 
+static Domain::Artifact::Ptr artifactFromIndex(const QModelIndex &index)
+{
+    return index.data(QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>();
+}
+
+static QString normalizedText(const QString &text)
+{
+    return text.normalized(QString::NormalizationForm_KC).toLower();
+}
+
+static qint64 dateKey(const QDateTime &date)
+{
+    if (date.isValid())
+        return date.toMSecsSinceEpoch();
+
+    // Tasks without date go after the dated ones but before the notes
+    return std::numeric_limits<qint64>::max() - 1;
+}
+
+static bool isInRemovedRows(const QModelIndex &index, const QModelIndex &parent, int first, int last)
+{
+    for (QModelIndex current = index; current.isValid(); current = current.parent()) {
+        if (current.parent() == parent)
+            return current.row() >= first && current.row() <= last;
+    }
+    return false;
+}
+
+static int statusPriority(Domain::Task::Status status)
+{
+    switch (status) {
+        case Domain::Task::Status::Complete:
+            return 0;
+        case Domain::Task::Status::None:
+            return 2;
+        case Domain::Task::Status::NeedsAction:
+            return 3;
+        case Domain::Task::Status::InProcess:
+            return 4;
+        case Domain::Task::Status::Cancelled:
+            return 1;
+    };
+    return -1;
+}
+
+ArtifactFilterProxyModel::MatchEntry::MatchEntry()
+    : generation(-1),
+      matches(false),
+      subtreeGeneration(-1),
+      subtreeMatches(false)
+{
+}
+
 ArtifactFilterProxyModel::ArtifactFilterProxyModel(QObject *parent)
     : QSortFilterProxyModel(parent),
-      m_sortType(TitleSort)
+      m_sortType(TitleSort),
+      m_fixedFilter(true),
+      m_filterGeneration(0),
+      m_refinementStart(0),
+      m_subtreeGeneration(0),
+      m_currentSortKeys(0)
 {
     setDynamicSortFilter(true);
     setSortCaseSensitivity(Qt::CaseInsensitive);
@@ -50,6 +108,7 @@ ArtifactFilterProxyModel::SortType ArtifactFilterProxyModel::sortType() const
 void ArtifactFilterProxyModel::setSortType(ArtifactFilterProxyModel::SortType type)
 {
     m_sortType = type;
+    clearSortKeys();
     invalidate();
 }
 
@@ -58,94 +117,325 @@ void ArtifactFilterProxyModel::setSortOrder(Qt::SortOrder order)
     sort(0, order);
 }
 
+void ArtifactFilterProxyModel::sort(int column, Qt::SortOrder order)
+{
+    clearSortKeys();
+    QSortFilterProxyModel::sort(column, order);
+}
+
+void ArtifactFilterProxyModel::setSourceModel(QAbstractItemModel *model)
+{
+    if (sourceModel())
+        disconnect(sourceModel(), 0, this, 0);
+
+    m_matchIndex.clear();
+    clearSortKeys();
+
+    // Connected before QSortFilterProxyModel does so that the index
+    // is up to date when it filters the changed rows again
+    if (model) {
+        connect(model, SIGNAL(dataChanged(QModelIndex,QModelIndex)),
+                this, SLOT(onSourceDataChanged(QModelIndex,QModelIndex)));
+        connect(model, SIGNAL(rowsInserted(QModelIndex,int,int)),
+                this, SLOT(onSourceRowsInserted(QModelIndex,int,int)));
+        connect(model, SIGNAL(rowsAboutToBeRemoved(QModelIndex,int,int)),
+                this, SLOT(onSourceRowsAboutToBeRemoved(QModelIndex,int,int)));
+        connect(model, SIGNAL(layoutChanged()),
+                this, SLOT(onSourceLayoutChanged()));
+        connect(model, SIGNAL(modelReset()),
+                this, SLOT(onSourceModelReset()));
+    }
+
+    QSortFilterProxyModel::setSourceModel(model);
+}
+
 bool ArtifactFilterProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+{
+    updateMatchFilter();
+    return acceptsSubtree(sourceRow, sourceParent);
+}
+
+void ArtifactFilterProxyModel::onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+    const QModelIndex parent = topLeft.parent();
+    for (int row = topLeft.row(); row <= bottomRight.row(); row++) {
+        const auto artifact = artifactFromIndex(sourceModel()->index(row, 0, parent));
+        if (artifact)
+            m_matchIndex.remove(artifact.data());
+    }
+
+    if (auto keys = sortKeysFor(parent)) {
+        for (int row = topLeft.row(); row <= bottomRight.row(); row++)
+            (*keys)[row] = sortKey(sourceModel()->index(row, 0, parent));
+    }
+
+    invalidateSubtrees(parent);
+}
+
+void ArtifactFilterProxyModel::onSourceRowsInserted(const QModelIndex &parent, int first, int last)
+{
+    if (auto keys = sortKeysFor(parent)) {
+        keys->insert(first, last - first + 1, SortKey());
+        for (int row = first; row <= last; row++)
+            (*keys)[row] = sortKey(sourceModel()->index(row, 0, parent));
+    }
+
+    invalidateSubtrees(parent);
+}
+
+void ArtifactFilterProxyModel::onSourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last)
+{
+    for (int row = first; row <= last; row++)
+        removeEntries(sourceModel()->index(row, 0, parent));
+
+    removeSortKeys(parent, first, last);
+
+    invalidateSubtrees(parent);
+}
+
+void ArtifactFilterProxyModel::onSourceLayoutChanged()
+{
+    m_subtreeGeneration++;
+    clearSortKeys();
+}
+
+void ArtifactFilterProxyModel::onSourceModelReset()
+{
+    m_matchIndex.clear();
+    clearSortKeys();
+}
+
+ArtifactFilterProxyModel::MatchEntry &ArtifactFilterProxyModel::matchEntry(const Domain::Artifact::Ptr &artifact) const
+{
+    MatchEntry &entry = m_matchIndex[artifact.data()];
+    if (!entry.artifact)
+        entry.artifact = artifact;
+    return entry;
+}
+
+bool ArtifactFilterProxyModel::matches(MatchEntry &entry) const
+{
+    if (entry.generation == m_filterGeneration)
+        return entry.matches;
+
+    // The filter got refined since this artifact was rejected, no need to test it again
+    if (!entry.matches && entry.generation >= m_refinementStart) {
+        entry.generation = m_filterGeneration;
+        return false;
+    }
+
+    if (m_fixedFilter) {
+        if (m_filterText.isEmpty()) {
+            entry.matches = true;
+        } else {
+            if (entry.title.isNull()) {
+                entry.title = normalizedText(entry.artifact->title());
+                entry.text = normalizedText(entry.artifact->text());
+            }
+            entry.matches = entry.title.contains(m_filterText)
+                         || entry.text.contains(m_filterText);
+        }
+    } else {
+        entry.matches = entry.artifact->title().contains(m_filterRegExp)
+                     || entry.artifact->text().contains(m_filterRegExp);
+    }
+
+    entry.generation = m_filterGeneration;
+    return entry.matches;
+}
+
+bool ArtifactFilterProxyModel::acceptsSubtree(int sourceRow, const QModelIndex &sourceParent) const
 {
     const QModelIndex index = sourceModel()->index(sourceRow, 0, sourceParent);
-    const auto artifact = index.data(QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>();
+    const auto artifact = artifactFromIndex(index);
     if (artifact) {
-        QRegExp regexp = filterRegExp();
-        regexp.setCaseSensitivity(Qt::CaseInsensitive);
+        MatchEntry &entry = matchEntry(artifact);
+        if (entry.subtreeGeneration == m_subtreeGeneration)
+            return entry.subtreeMatches;
 
-        if (artifact->title().contains(regexp)
-         || artifact->text().contains(regexp)) {
+        if (matches(entry)) {
+            entry.subtreeGeneration = m_subtreeGeneration;
+            entry.subtreeMatches = true;
             return true;
         }
     }
 
-    for (int childRow = 0; childRow < sourceModel()->rowCount(index); childRow++) {
-        if (filterAcceptsRow(childRow, index))
-            return true;
+    bool result = false;
+
+    // Don't make a lazy model fetch the whole tree because of a filter,
+    // children nobody asked for yet can't bring their parent in
+    if (!sourceModel()->canFetchMore(index)) {
+        for (int childRow = 0; childRow < sourceModel()->rowCount(index); childRow++) {
+            if (acceptsSubtree(childRow, index)) {
+                result = true;
+                break;
+            }
+        }
+    }
+
+    if (!result)
+        result = QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
+
+    // Looked up again, the children might have grown the index in the meantime
+    if (artifact) {
+        MatchEntry &entry = matchEntry(artifact);
+        entry.subtreeGeneration = m_subtreeGeneration;
+        entry.subtreeMatches = result;
     }
 
-    return QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
+    return result;
 }
 
-static QDateTime validDt(const QDateTime &date = QDateTime())
+void ArtifactFilterProxyModel::updateMatchFilter() const
 {
-    if (date.isValid())
-        return date;
+    // Any of the QSortFilterProxyModel setters can have changed the filter,
+    // they all end up refiltering the rows so this is the place to catch up
+    const QRegExp regExp = filterRegExp();
+    if (regExp == m_appliedRegExp)
+        return;
+    m_appliedRegExp = regExp;
+
+    const bool fixedFilter = regExp.patternSyntax() == QRegExp::FixedString;
+    const QString filterText = fixedFilter ? normalizedText(regExp.pattern()) : QString();
+
+    m_filterGeneration++;
+    m_subtreeGeneration++;
+
+    // Rows which didn't match the previous pattern can't match a longer one
+    const bool refined = fixedFilter && m_fixedFilter && filterText.contains(m_filterText);
+    if (!refined)
+        m_refinementStart = m_filterGeneration;
+
+    m_fixedFilter = fixedFilter;
+    m_filterText = filterText;
+    m_filterRegExp = regExp;
+    m_filterRegExp.setCaseSensitivity(Qt::CaseInsensitive);
+}
 
-    return QDateTime::fromTime_t(std::numeric_limits<uint>::max() - 1);
+void ArtifactFilterProxyModel::invalidateSubtrees(const QModelIndex &sourceIndex)
+{
+    for (QModelIndex index = sourceIndex; index.isValid(); index = index.parent()) {
+        const auto artifact = artifactFromIndex(index);
+        if (artifact && m_matchIndex.contains(artifact.data()))
+            m_matchIndex[artifact.data()].subtreeGeneration = -1;
+    }
 }
 
-static int statusPriority(Domain::Task::Status status)
+void ArtifactFilterProxyModel::removeEntries(const QModelIndex &sourceIndex)
 {
-    switch (status) {
-        case Domain::Task::Status::Complete:
-            return 0;
-        case Domain::Task::Status::None:
-            return 2;
-        case Domain::Task::Status::NeedsAction:
-            return 3;
-        case Domain::Task::Status::InProcess:
-            return 4;
-        case Domain::Task::Status::Cancelled:
-            return 1;
-    };
-    return -1;
+    const auto artifact = artifactFromIndex(sourceIndex);
+    if (artifact)
+        m_matchIndex.remove(artifact.data());
+
+    // Don't make a lazy model fetch children only to forget about them
+    if (sourceModel()->canFetchMore(sourceIndex))
+        return;
+
+    for (int row = 0; row < sourceModel()->rowCount(sourceIndex); row++)
+        removeEntries(sourceModel()->index(row, 0, sourceIndex));
 }
 
-bool ArtifactFilterProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
+ArtifactFilterProxyModel::SortKey ArtifactFilterProxyModel::sortKey(const QModelIndex &sourceIndex) const
 {
-    if (m_sortType == TitleSort) {
-        return QSortFilterProxyModel::lessThan(left, right);
-    } else if (m_sortType == DateSort) {
-        const auto leftArtifact = left.data(QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>();
-        const auto rightArtifact = right.data(QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>();
+    SortKey key;
+    const auto task = artifactFromIndex(sourceIndex).objectCast<Domain::Task>();
+    if (task) {
+        key.dueDate = dateKey(task->dueDate());
+        key.startDate = dateKey(task->startDate());
+        key.earliestDate = qMin(key.dueDate, key.startDate);
+        key.progress = task->progress();
+        key.statusPriority = statusPriority(task->status());
+    } else {
+        key.earliestDate = std::numeric_limits<qint64>::max();
+        key.dueDate = std::numeric_limits<qint64>::max();
+        key.startDate = std::numeric_limits<qint64>::max();
+        key.progress = std::numeric_limits<int>::max();
+        key.statusPriority = 0;
+    }
+    return key;
+}
 
-        const auto leftTask = leftArtifact.objectCast<Domain::Task>();
-        const auto rightTask = rightArtifact.objectCast<Domain::Task>();
+QVector<ArtifactFilterProxyModel::SortKey> *ArtifactFilterProxyModel::sortKeysFor(const QModelIndex &sourceParent) const
+{
+    if (m_currentSortKeys && m_currentSortParent == sourceParent)
+        return m_currentSortKeys;
 
-        const QDateTime leftDue = leftTask ? validDt(leftTask->dueDate()) : validDt().addSecs(1);
-        const QDateTime rightDue = rightTask ? validDt(rightTask->dueDate()) : validDt().addSecs(1);
+    if (m_sortKeys.isEmpty())
+        return 0;
 
-        const QDateTime leftStart = leftTask ? validDt(leftTask->startDate()) : validDt().addSecs(1);
-        const QDateTime rightStart = rightTask ? validDt(rightTask->startDate()) : validDt().addSecs(1);
+    auto it = m_sortKeys.find(sourceParent);
+    if (it == m_sortKeys.end())
+        return 0;
 
-        return leftDue < rightDue
-            || leftStart < rightStart;
-    } else if (m_sortType == ProgressSort) {
-        const auto leftArtifact = left.data(QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>();
-        const auto rightArtifact = right.data(QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>();
+    m_currentSortParent = sourceParent;
+    m_currentSortKeys = &it.value();
+    return m_currentSortKeys;
+}
 
-        const auto leftTask = leftArtifact.objectCast<Domain::Task>();
-        const auto rightTask = rightArtifact.objectCast<Domain::Task>();
+QVector<ArtifactFilterProxyModel::SortKey> *ArtifactFilterProxyModel::fillSortKeys(const QModelIndex &sourceParent) const
+{
+    QVector<SortKey> &keys = m_sortKeys[sourceParent];
 
-        const int leftProgress = leftTask ? leftTask->progress() : std::numeric_limits<int>::max();
-        const int rightProgress = rightTask ? rightTask->progress() : std::numeric_limits<int>::max();
+    const int count = sourceModel()->rowCount(sourceParent);
+    keys.resize(count);
+    for (int row = 0; row < count; row++)
+        keys[row] = sortKey(sourceModel()->index(row, 0, sourceParent));
 
-        return leftProgress < rightProgress;
-    } else if (m_sortType == StatusSort) {
-        const auto leftArtifact = left.data(QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>();
-        const auto rightArtifact = right.data(QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>();
+    m_currentSortParent = sourceParent;
+    m_currentSortKeys = &keys;
+    return m_currentSortKeys;
+}
+
+void ArtifactFilterProxyModel::removeSortKeys(const QModelIndex &sourceParent, int first, int last)
+{
+    // The keys of the removed rows' subtrees go away with them, a removed
+    // parent would otherwise linger as an invalid index matching the root
+    m_currentSortParent = QPersistentModelIndex();
+    m_currentSortKeys = 0;
+
+    for (auto it = m_sortKeys.begin(); it != m_sortKeys.end();) {
+        if (isInRemovedRows(it.key(), sourceParent, first, last))
+            it = m_sortKeys.erase(it);
+        else
+            ++it;
+    }
+
+    if (auto keys = sortKeysFor(sourceParent))
+        keys->remove(first, last - first + 1);
+}
 
-        const auto leftTask = leftArtifact.objectCast<Domain::Task>();
-        const auto rightTask = rightArtifact.objectCast<Domain::Task>();
+void ArtifactFilterProxyModel::clearSortKeys()
+{
+    m_currentSortParent = QPersistentModelIndex();
+    m_currentSortKeys = 0;
+    m_sortKeys.clear();
+}
 
-        const int leftStatusPriority = leftTask ? statusPriority(leftTask->status()) : 0;
-        const int rightStatusPriority = rightTask ? statusPriority(rightTask->status()) : 0;
+bool ArtifactFilterProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
+{
+    if (m_sortType == TitleSort)
+        return QSortFilterProxyModel::lessThan(left, right);
 
-        return leftStatusPriority < rightStatusPriority;
+    // Rows get sorted one parent at a time, fetch their keys only once
+    const QModelIndex parent = left.parent();
+    const QVector<SortKey> *keys = sortKeysFor(parent);
+    if (!keys)
+        keys = fillSortKeys(parent);
+
+    const SortKey &leftKey = keys->at(left.row());
+    const SortKey &rightKey = keys->at(right.row());
+
+    if (m_sortType == DateSort) {
+        // Earliest of the two dates first, then due date, then start date
+        if (leftKey.earliestDate != rightKey.earliestDate)
+            return leftKey.earliestDate < rightKey.earliestDate;
+        if (leftKey.dueDate != rightKey.dueDate)
+            return leftKey.dueDate < rightKey.dueDate;
+        return leftKey.startDate < rightKey.startDate;
+    } else if (m_sortType == ProgressSort) {
+        return leftKey.progress < rightKey.progress;
+    } else if (m_sortType == StatusSort) {
+        return leftKey.statusPriority < rightKey.statusPriority;
     }
     return QSortFilterProxyModel::lessThan(left, right);
 }
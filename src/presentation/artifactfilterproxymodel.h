@@ -25,7 +25,11 @@
 #ifndef PRESENTATION_ARTIFACTFILTERPROXYMODEL_H
 #define PRESENTATION_ARTIFACTFILTERPROXYMODEL_H
 
+#include <QPersistentModelIndex>
 #include <QSortFilterProxyModel>
+#include <QVector>
+
+#include "domain/artifact.h"
 
 namespace Presentation {
 
@@ -48,12 +52,74 @@ public:
 
     void setSortOrder(Qt::SortOrder order);
 
+    void setSourceModel(QAbstractItemModel *model);
+
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder);
+
 protected:
     bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const;
     bool lessThan(const QModelIndex &left, const QModelIndex &right) const;
 
+private slots:
+    void onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+    void onSourceRowsInserted(const QModelIndex &parent, int first, int last);
+    void onSourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+    void onSourceLayoutChanged();
+    void onSourceModelReset();
+
 private:
+    struct MatchEntry
+    {
+        MatchEntry();
+
+        Domain::Artifact::Ptr artifact; // Keeps the key alive
+        QString title;
+        QString text;
+        int generation;
+        bool matches;
+        int subtreeGeneration;
+        bool subtreeMatches;
+    };
+
+    struct SortKey
+    {
+        qint64 earliestDate;
+        qint64 dueDate;
+        qint64 startDate;
+        int progress;
+        int statusPriority;
+    };
+
+    MatchEntry &matchEntry(const Domain::Artifact::Ptr &artifact) const;
+    bool matches(MatchEntry &entry) const;
+    bool acceptsSubtree(int sourceRow, const QModelIndex &sourceParent) const;
+    void updateMatchFilter() const;
+    void invalidateSubtrees(const QModelIndex &sourceIndex);
+    void removeEntries(const QModelIndex &sourceIndex);
+    SortKey sortKey(const QModelIndex &sourceIndex) const;
+    QVector<SortKey> *sortKeysFor(const QModelIndex &sourceParent) const;
+    QVector<SortKey> *fillSortKeys(const QModelIndex &sourceParent) const;
+    void removeSortKeys(const QModelIndex &sourceParent, int first, int last);
+    void clearSortKeys();
+
     SortType m_sortType;
+
+    mutable QHash<const Domain::Artifact*, MatchEntry> m_matchIndex;
+
+    // Follow filterRegExp() lazily, its setters aren't virtual
+    mutable QRegExp m_appliedRegExp;
+    mutable QString m_filterText;
+    mutable QRegExp m_filterRegExp;
+    mutable bool m_fixedFilter;
+    mutable int m_filterGeneration;
+    mutable int m_refinementStart;
+    mutable int m_subtreeGeneration;
+
+    // Keys of the rows of each parent sorted so far, indexed by source row
+    mutable QHash<QPersistentModelIndex, QVector<SortKey>> m_sortKeys;
+    // Last parent looked up, spares a hash lookup per comparison
+    mutable QPersistentModelIndex m_currentSortParent;
+    mutable QVector<SortKey> *m_currentSortKeys;
 };
 
 }
@@ -321,5 +321,8 @@ QAbstractItemModel *AvailablePagesModel::createPageListModel()
         return 0;
     };
 
-    return new QueryTreeModel<QObjectPtr>(query, flags, data, setData, drop, drag, this);
+    auto model = new QueryTreeModel<QObjectPtr>(query, flags, data, setData, drop, drag, this);
+    // The pages' own fetches come first, these mostly warm up the cache they use
+    model->setJobPriority(Utils::JobHandler::PrefetchPriority);
+    return model;
 }
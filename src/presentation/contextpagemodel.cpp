@@ -164,5 +164,12 @@ QAbstractItemModel *ContextPageModel::createCentralListModel()
         return data;
     };
 
-    return new QueryTreeModel<Domain::Task::Ptr>(query, flags, data, setData, drop, drag, this);
+    auto childrenHint = [](const Domain::Task::Ptr &) {
+        // Only the tasks of the context get listed, never their children
+        return false;
+    };
+
+    auto model = new QueryTreeModel<Domain::Task::Ptr>(query, flags, data, setData, drop, drag, this);
+    model->setChildrenHintFunction(childrenHint);
+    return model;
 }
@@ -24,6 +24,8 @@
 
 #include "pagemodel.h"
 
+#include "utils/jobhandler.h"
+
 using namespace Presentation;
 
 PageModel::PageModel(Domain::TaskQueries *taskQueries,
@@ -45,6 +47,13 @@ QAbstractItemModel *PageModel::centralListModel()
     return m_centralListModel;
 }
 
+void PageModel::cancelJobs()
+{
+    // The jobs started by the list belong to it
+    if (m_centralListModel)
+        Utils::JobHandler::cancelJobs(m_centralListModel);
+}
+
 Domain::TaskQueries *PageModel::taskQueries() const
 {
     return m_taskQueries;
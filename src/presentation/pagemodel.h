@@ -51,6 +51,10 @@ public:
 
     QAbstractItemModel *centralListModel();
 
+    // Stops the fetches still running for the central list, the list
+    // itself stays owned by the page
+    void cancelJobs();
+
 public slots:
     virtual void addTask(const QString &title) = 0;
     virtual void addNote(const QString &title) = 0;
@@ -42,6 +42,7 @@ public:
     typedef typename QueryTreeNode<ItemType>::DataFunction DataFunction;
     typedef typename QueryTreeNode<ItemType>::SetDataFunction SetDataFunction;
     typedef typename QueryTreeNode<ItemType>::DropFunction DropFunction;
+    typedef typename QueryTreeNode<ItemType>::ChildrenHintFunction ChildrenHintFunction;
     typedef std::function<QMimeData*(const QList<ItemType> &)> DragFunction;
 
     explicit QueryTreeModel(const QueryGenerator &queryGenerator,
@@ -72,6 +73,13 @@ public:
     {
     }
 
+    // Lets hasChildren() rule out the items which are known to have no
+    // children before querying them, to be set before the rows get fetched
+    void setChildrenHintFunction(const ChildrenHintFunction &childrenHintFunction)
+    {
+        static_cast<QueryTreeNode<ItemType>*>(nodeFromIndex(QModelIndex()))->setChildrenHintFunction(childrenHintFunction);
+    }
+
 protected:
     QMimeData *createMimeData(const QModelIndexList &indexes) const
     {
@@ -33,7 +33,9 @@ using namespace Presentation;
 
 QueryTreeNodeBase::QueryTreeNodeBase(QueryTreeNodeBase *parent, QueryTreeModelBase *model)
     : m_parent(parent),
-      m_model(model)
+      m_model(model),
+      m_populated(false),
+      m_row(-1)
 {
 }
 
@@ -44,7 +46,7 @@ QueryTreeNodeBase::~QueryTreeNodeBase()
 
 int QueryTreeNodeBase::row()
 {
-    return m_parent ? m_parent->m_childNode.indexOf(this) : -1;
+    return m_row;
 }
 
 QueryTreeNodeBase *QueryTreeNodeBase::parent() const
@@ -60,19 +62,30 @@ QueryTreeNodeBase *QueryTreeNodeBase::child(int row) const
         return 0;
 }
 
-void QueryTreeNodeBase::insertChild(int row, QueryTreeNodeBase *node)
+void QueryTreeNodeBase::insertChildren(int row, const QList<QueryTreeNodeBase*> &nodes)
 {
-    m_childNode.insert(row, node);
+    // Rebuilding the list once and renumbering the rows after it once
+    // keeps inserting a range in front linear in the number of children
+    if (row == m_childNode.size())
+        m_childNode += nodes;
+    else
+        m_childNode = m_childNode.mid(0, row) + nodes + m_childNode.mid(row);
+    updateRows(row);
 }
 
 void QueryTreeNodeBase::appendChild(QueryTreeNodeBase *node)
 {
+    node->m_row = m_childNode.size();
     m_childNode.append(node);
 }
 
-void QueryTreeNodeBase::removeChildAt(int row)
+void QueryTreeNodeBase::removeChildren(int row, int count)
 {
-    delete m_childNode.takeAt(row);
+    const auto begin = m_childNode.begin() + row;
+    const auto end = begin + count;
+    qDeleteAll(begin, end);
+    m_childNode.erase(begin, end);
+    updateRows(row);
 }
 
 int QueryTreeNodeBase::childCount() const
@@ -80,6 +93,33 @@ int QueryTreeNodeBase::childCount() const
     return m_childNode.size();
 }
 
+bool QueryTreeNodeBase::isPopulated() const
+{
+    return m_populated;
+}
+
+void QueryTreeNodeBase::populate()
+{
+    if (m_populated)
+        return;
+
+    m_populated = true;
+
+    Utils::JobHandler::Scope scope(m_model, m_model->jobPriority());
+    populateChildren();
+}
+
+QueryTreeModelBase *QueryTreeNodeBase::model() const
+{
+    return m_model;
+}
+
+void QueryTreeNodeBase::updateRows(int first)
+{
+    for (int i = first; i < m_childNode.size(); i++)
+        m_childNode.at(i)->m_row = i;
+}
+
 QModelIndex QueryTreeNodeBase::index(int row, int column, const QModelIndex &parent) const
 {
     return m_model->index(row, column, parent);
@@ -117,7 +157,8 @@ void QueryTreeNodeBase::emitDataChanged(const QModelIndex &topLeft, const QModel
 
 QueryTreeModelBase::QueryTreeModelBase(QueryTreeNodeBase *rootNode, QObject *parent)
     : QAbstractItemModel(parent),
-      m_rootNode(rootNode)
+      m_rootNode(rootNode),
+      m_jobPriority(Utils::JobHandler::VisiblePriority)
 {
     auto roles = roleNames();
     roles.insert(ObjectRole, "object");
@@ -127,9 +168,20 @@ QueryTreeModelBase::QueryTreeModelBase(QueryTreeNodeBase *rootNode, QObject *par
 
 QueryTreeModelBase::~QueryTreeModelBase()
 {
+    Utils::JobHandler::cancelJobs(this);
     delete m_rootNode;
 }
 
+Utils::JobHandler::Priority QueryTreeModelBase::jobPriority() const
+{
+    return m_jobPriority;
+}
+
+void QueryTreeModelBase::setJobPriority(Utils::JobHandler::Priority priority)
+{
+    m_jobPriority = priority;
+}
+
 Qt::ItemFlags QueryTreeModelBase::flags(const QModelIndex &index) const
 {
     if (!isModelIndexValid(index)) {
@@ -144,8 +196,7 @@ QModelIndex QueryTreeModelBase::index(int row, int column, const QModelIndex &pa
     if (row < 0 || column != 0)
         return QModelIndex();
 
-    const QueryTreeNodeBase *parentNode = nodeFromIndex(parent);
-
+    QueryTreeNodeBase *parentNode = nodeFromIndex(parent);
     if (row < parentNode->childCount()) {
         QueryTreeNodeBase *node = parentNode->child(row);
         return createIndex(row, column, node);
@@ -165,6 +216,7 @@ QModelIndex QueryTreeModelBase::parent(const QModelIndex &index) const
 
 int QueryTreeModelBase::rowCount(const QModelIndex &index) const
 {
+    // Stays empty until fetchMore() populates the node
     return nodeFromIndex(index)->childCount();
 }
 
@@ -173,6 +225,28 @@ int QueryTreeModelBase::columnCount(const QModelIndex &) const
     return 1;
 }
 
+bool QueryTreeModelBase::hasChildren(const QModelIndex &parent) const
+{
+    const QueryTreeNodeBase *node = nodeFromIndex(parent);
+
+    // Answering without populating is the whole point, rely on
+    // the hint until the view fetches the children
+    if (!node->isPopulated())
+        return node->mayHaveChildren();
+
+    return node->childCount() > 0;
+}
+
+bool QueryTreeModelBase::canFetchMore(const QModelIndex &parent) const
+{
+    return !nodeFromIndex(parent)->isPopulated();
+}
+
+void QueryTreeModelBase::fetchMore(const QModelIndex &parent)
+{
+    nodeFromIndex(parent)->populate();
+}
+
 QVariant QueryTreeModelBase::data(const QModelIndex &index, int role) const
 {
     if (!isModelIndexValid(index)) {
@@ -226,7 +300,8 @@ bool QueryTreeModelBase::isModelIndexValid(const QModelIndex &index) const
     if (!valid)
         return false;
 
-    const QueryTreeNodeBase *parentNode = nodeFromIndex(index.parent());
+    // Going through index.parent() would compute the row of the parent for nothing
+    const QueryTreeNodeBase *parentNode = nodeFromIndex(index)->parent();
     const int count = parentNode->childCount();
     return index.row() < count;
 }
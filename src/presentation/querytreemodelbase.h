@@ -28,6 +28,8 @@
 
 #include <QAbstractItemModel>
 
+#include "utils/jobhandler.h"
+
 namespace Presentation {
 
 class QueryTreeModelBase;
@@ -46,12 +48,22 @@ public:
     int row();
     QueryTreeNodeBase *parent() const;
     QueryTreeNodeBase *child(int row) const;
-    void insertChild(int row, QueryTreeNodeBase *node);
+    void insertChildren(int row, const QList<QueryTreeNodeBase*> &nodes);
     void appendChild(QueryTreeNodeBase *node);
-    void removeChildAt(int row);
+    void removeChildren(int row, int count);
     int childCount() const;
 
+    // Children are only queried once the model is asked to fetch them
+    bool isPopulated() const;
+    void populate();
+
+    // Answers without querying, might say yes for a node without children
+    virtual bool mayHaveChildren() const = 0;
+
 protected:
+    virtual void populateChildren() = 0;
+
+    QueryTreeModelBase *model() const;
     QModelIndex index(int row, int column, const QModelIndex &parent) const;
     QModelIndex createIndex(int row, int column, void *data) const;
     void beginInsertRows(const QModelIndex &parent, int first, int last);
@@ -61,9 +73,13 @@ protected:
     void emitDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
 
 private:
+    void updateRows(int first);
+
     QueryTreeNodeBase *m_parent;
     QList<QueryTreeNodeBase*> m_childNode;
     QueryTreeModelBase *m_model;
+    bool m_populated;
+    int m_row;
 };
 
 class QueryTreeModelBase : public QAbstractItemModel
@@ -84,12 +100,20 @@ public:
     QModelIndex parent(const QModelIndex &index) const;
     int rowCount(const QModelIndex &parent = QModelIndex()) const;
     int columnCount(const QModelIndex &parent = QModelIndex()) const;
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const;
+    bool canFetchMore(const QModelIndex &parent) const;
+    void fetchMore(const QModelIndex &parent);
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
     bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole);
     bool dropMimeData(const QMimeData *data, Qt::DropAction action, int row, int column, const QModelIndex &parent);
     QMimeData *mimeData(const QModelIndexList &indexes) const;
     QStringList mimeTypes() const;
 
+    // The jobs started to populate the model belong to it and get that
+    // priority, they are cancelled when the model goes away
+    Utils::JobHandler::Priority jobPriority() const;
+    void setJobPriority(Utils::JobHandler::Priority priority);
+
 protected:
     explicit QueryTreeModelBase(QueryTreeNodeBase *rootNode,
                                 QObject *parent = 0);
@@ -101,6 +125,7 @@ private:
     bool isModelIndexValid(const QModelIndex &index) const;
 
     QueryTreeNodeBase *m_rootNode;
+    Utils::JobHandler::Priority m_jobPriority;
 };
 
 }
@@ -46,6 +46,7 @@ public:
     typedef std::function<QVariant(const ItemType &, int)> DataFunction;
     typedef std::function<bool(const ItemType &, const QVariant &, int)> SetDataFunction;
     typedef std::function<bool(const QMimeData *, Qt::DropAction, const ItemType &)> DropFunction;
+    typedef std::function<bool(const ItemType &)> ChildrenHintFunction;
 
     QueryTreeNode(const ItemType &item, QueryTreeNodeBase *parentNode, QueryTreeModelBase *model,
                   const QueryGenerator &queryGenerator,
@@ -54,11 +55,11 @@ public:
                   const SetDataFunction &setDataFunction)
         : QueryTreeNodeBase(parentNode, model),
           m_item(item),
+          m_queryGenerator(queryGenerator),
           m_flagsFunction(flagsFunction),
           m_dataFunction(dataFunction),
           m_setDataFunction(setDataFunction)
     {
-        init(model, queryGenerator);
     }
 
     QueryTreeNode(const ItemType &item, QueryTreeNodeBase *parentNode, QueryTreeModelBase *model,
@@ -69,12 +70,12 @@ public:
                   const DropFunction &dropFunction)
         : QueryTreeNodeBase(parentNode, model),
           m_item(item),
+          m_queryGenerator(queryGenerator),
           m_flagsFunction(flagsFunction),
           m_dataFunction(dataFunction),
           m_setDataFunction(setDataFunction),
           m_dropFunction(dropFunction)
     {
-        init(model, queryGenerator);
     }
 
     ItemType item() const { return m_item; }
@@ -99,44 +100,58 @@ public:
             return false;
     }
 
-private:
-    void init(QueryTreeModelBase *model, const QueryGenerator &queryGenerator)
+    // Handed over to the children created afterwards
+    void setChildrenHintFunction(const ChildrenHintFunction &childrenHintFunction)
+    {
+        m_childrenHintFunction = childrenHintFunction;
+    }
+
+    bool mayHaveChildren() const Q_DECL_OVERRIDE
+    {
+        // The root has no item to give to the hint
+        if (!parent() || !m_childrenHintFunction)
+            return true;
+
+        return m_childrenHintFunction(m_item);
+    }
+
+protected:
+    void populateChildren() Q_DECL_OVERRIDE
     {
-        m_children = queryGenerator(m_item);
+        m_children = m_queryGenerator(m_item);
 
         if (!m_children)
             return;
 
-        for (auto child : m_children->data()) {
-            //Protect from endless loop
-            Q_ASSERT(child != m_item);
-            QueryTreeNodeBase *node = new QueryTreeNode<ItemType>(child, this,
-                                                                  model, queryGenerator,
-                                                                  m_flagsFunction,
-                                                                  m_dataFunction, m_setDataFunction,
-                                                                  m_dropFunction);
-            appendChild(node);
+        if (!m_children->isEmpty()) {
+            QModelIndex parentIndex = parent() ? createIndex(row(), 0, this) : QModelIndex();
+            beginInsertRows(parentIndex, 0, m_children->size() - 1);
+            for (auto child : *m_children) {
+                //Protect from endless loop
+                Q_ASSERT(child != m_item);
+                appendChild(createChild(child));
+            }
+            endInsertRows();
         }
 
-        m_children->addPreInsertHandler([this](const ItemType &, int index) {
+        m_children->addPreInsertRangeHandler([this](const Domain::QueryResultRange<ItemType> &items, int index) {
             QModelIndex parentIndex = parent() ? createIndex(row(), 0, this) : QModelIndex();
-            beginInsertRows(parentIndex, index, index);
+            beginInsertRows(parentIndex, index, index + items.size() - 1);
         });
-        m_children->addPostInsertHandler([this, model, queryGenerator](const ItemType &item, int index) {
-            QueryTreeNodeBase *node = new QueryTreeNode<ItemType>(item, this,
-                                                                  model, queryGenerator,
-                                                                  m_flagsFunction,
-                                                                  m_dataFunction, m_setDataFunction,
-                                                                  m_dropFunction);
-            insertChild(index, node);
+        m_children->addPostInsertRangeHandler([this](const Domain::QueryResultRange<ItemType> &items, int index) {
+            QList<QueryTreeNodeBase*> nodes;
+            nodes.reserve(items.size());
+            for (const auto &item : items)
+                nodes << createChild(item);
+            insertChildren(index, nodes);
             endInsertRows();
         });
-        m_children->addPreRemoveHandler([this](const ItemType &, int index) {
+        m_children->addPreRemoveRangeHandler([this](const Domain::QueryResultRange<ItemType> &items, int index) {
             QModelIndex parentIndex = parent() ? createIndex(row(), 0, this) : QModelIndex();
-            beginRemoveRows(parentIndex, index, index);
+            beginRemoveRows(parentIndex, index, index + items.size() - 1);
         });
-        m_children->addPostRemoveHandler([this](const ItemType &, int index) {
-            removeChildAt(index);
+        m_children->addPostRemoveRangeHandler([this](const Domain::QueryResultRange<ItemType> &items, int index) {
+            removeChildren(index, items.size());
             endRemoveRows();
         });
         m_children->addPostReplaceHandler([this](const ItemType &, int idx) {
@@ -145,13 +160,27 @@ private:
         });
     }
 
+private:
+    QueryTreeNodeBase *createChild(const ItemType &item)
+    {
+        auto child = new QueryTreeNode<ItemType>(item, this,
+                                                 model(), m_queryGenerator,
+                                                 m_flagsFunction,
+                                                 m_dataFunction, m_setDataFunction,
+                                                 m_dropFunction);
+        child->setChildrenHintFunction(m_childrenHintFunction);
+        return child;
+    }
+
     ItemType m_item;
     ItemQueryPtr m_children;
+    QueryGenerator m_queryGenerator;
 
     FlagsFunction m_flagsFunction;
     DataFunction m_dataFunction;
     SetDataFunction m_setDataFunction;
     DropFunction m_dropFunction;
+    ChildrenHintFunction m_childrenHintFunction;
 };
 
 }
@@ -188,5 +188,13 @@ QAbstractItemModel *TagPageModel::createCentralListModel()
         return data;
     };
 
-    return new QueryTreeModel<Domain::Artifact::Ptr>(query, flags, data, setData, drop, drag, this);
+    auto childrenHint = [this](const Domain::Artifact::Ptr &artifact) {
+        // Notes have no descendants
+        auto task = artifact.dynamicCast<Domain::Task>();
+        return task && taskQueries()->mayHaveChildren(task);
+    };
+
+    auto model = new QueryTreeModel<Domain::Artifact::Ptr>(query, flags, data, setData, drop, drag, this);
+    model->setChildrenHintFunction(childrenHint);
+    return model;
 }
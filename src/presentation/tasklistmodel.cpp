@@ -68,7 +68,7 @@ int TaskListModel::rowCount(const QModelIndex &parent) const
     if (parent.isValid())
         return 0;
     else
-        return m_taskList->data().size();
+        return m_taskList->size();
 }
 
 QVariant TaskListModel::data(const QModelIndex &index, int role) const
@@ -111,7 +111,7 @@ bool TaskListModel::setData(const QModelIndex &index, const QVariant &value, int
 
 Domain::Task::Ptr TaskListModel::taskForIndex(const QModelIndex &index) const
 {
-    return m_taskList->data().at(index.row());
+    return m_taskList->at(index.row());
 }
 
 bool TaskListModel::isModelIndexValid(const QModelIndex &index) const
@@ -119,5 +119,5 @@ bool TaskListModel::isModelIndexValid(const QModelIndex &index) const
     return index.isValid()
         && index.column() == 0
         && index.row() >= 0
-        && index.row() < m_taskList->data().size();
+        && index.row() < m_taskList->size();
 }
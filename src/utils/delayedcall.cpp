@@ -0,0 +1,91 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+
+#include "delayedcall.h"
+
+#include <QList>
+#include <QObject>
+#include <QPointer>
+
+using namespace Utils;
+
+struct PostedCall
+{
+    PostedCall() : hasContext(false) {}
+    PostedCall(QObject *c, const DelayedCall::Callback &cb)
+        : hasContext(c != 0), context(c), callback(cb) {}
+
+    bool hasContext;
+    QPointer<QObject> context;
+    DelayedCall::Callback callback;
+};
+
+class DelayedCallInstance : public QObject
+{
+    Q_OBJECT
+public:
+    DelayedCallInstance()
+        : QObject() {}
+
+    void append(const PostedCall &call)
+    {
+        if (m_calls.isEmpty())
+            QMetaObject::invokeMethod(this, "runCallbacks", Qt::QueuedConnection);
+
+        m_calls << call;
+    }
+
+public slots:
+    void runCallbacks()
+    {
+        const auto calls = m_calls;
+        m_calls.clear();
+
+        for (auto call : calls) {
+            if (call.hasContext && !call.context)
+                continue;
+
+            call.callback();
+        }
+    }
+
+private:
+    QList<PostedCall> m_calls;
+};
+
+Q_GLOBAL_STATIC(DelayedCallInstance, delayedCallInstance)
+
+void DelayedCall::post(const Callback &callback)
+{
+    delayedCallInstance()->append(PostedCall(0, callback));
+}
+
+void DelayedCall::post(QObject *context, const Callback &callback)
+{
+    Q_ASSERT(context);
+    delayedCallInstance()->append(PostedCall(context, callback));
+}
+
+#include "delayedcall.moc"
@@ -56,17 +56,20 @@ namespace Internal {
 #endif
 
         Provider()
-            : m_factory(0)
+            : m_factory(0),
+              m_unique(false)
         {
         }
 
-        Provider(FactoryType factory)
-            : m_factory(factory)
+        Provider(FactoryType factory, bool unique = false)
+            : m_factory(factory),
+              m_unique(unique)
         {
         }
 
         Provider(const Provider &other)
-            : m_factory(other.m_factory)
+            : m_factory(other.m_factory),
+              m_unique(other.m_unique)
         {
         }
 
@@ -74,6 +77,7 @@ namespace Internal {
         {
             Provider tmp(other);
             std::swap(m_factory, tmp.m_factory);
+            std::swap(m_unique, tmp.m_unique);
             return *this;
         }
 
@@ -83,8 +87,14 @@ namespace Internal {
             return m_factory();
         }
 
+        bool isUnique() const
+        {
+            return m_unique;
+        }
+
     private:
         FactoryType m_factory;
+        bool m_unique;
     };
 
     template<class Iface>
@@ -98,7 +108,18 @@ namespace Internal {
 
         static Iface *create(DependencyManager *manager)
         {
-            return s_providers.value(manager)();
+            const Provider<Iface> provider = s_providers.value(manager);
+            if (!provider.isUnique())
+                return provider();
+
+            if (!s_instances.contains(manager))
+                s_instances.insert(manager, provider());
+            return s_instances.value(manager);
+        }
+
+        static bool hasProvider(DependencyManager *manager)
+        {
+            return s_providers.contains(manager);
         }
 
         static int providersCount()
@@ -109,38 +130,51 @@ namespace Internal {
         static void removeProvider(DependencyManager *manager)
         {
             s_providers.remove(manager);
+            delete s_instances.take(manager);
         }
 
     private:
         Supplier();
 
         static QMap< DependencyManager*, Provider<Iface> > s_providers;
+        static QMap< DependencyManager*, Iface* > s_instances;
     };
 
     template<class Iface>
     QMap< DependencyManager*, Provider<Iface> > Supplier<Iface>::s_providers;
+
+    template<class Iface>
+    QMap< DependencyManager*, Iface* > Supplier<Iface>::s_instances;
 }
 
 class DependencyManager
 {
 public:
+    // With UniqueInstance every create() call gets the same object,
+    // it is then owned by the manager and not by the callers
+    enum CreationStrategy {
+        InstancePerUser,
+        UniqueInstance
+    };
+
     static DependencyManager &globalInstance();
 
     DependencyManager();
     ~DependencyManager();
 
     template<class Iface>
-    void add(const typename Internal::Provider<Iface>::FactoryType &factory)
+    void add(const typename Internal::Provider<Iface>::FactoryType &factory,
+             CreationStrategy strategy = InstancePerUser)
     {
-        Internal::Provider<Iface> provider(factory);
+        Internal::Provider<Iface> provider(factory, strategy == UniqueInstance);
         Internal::Supplier<Iface>::setProvider(this, provider);
         m_cleanupFunctions << Internal::Supplier<Iface>::removeProvider;
     }
 
     template<class Iface, class Impl>
-    void add()
+    void add(CreationStrategy strategy = InstancePerUser)
     {
-        add<Iface>(Internal::standardFactory<Iface, Impl>);
+        add<Iface>(Internal::standardFactory<Iface, Impl>, strategy);
     }
 
     template<class Iface>
@@ -149,6 +183,12 @@ public:
         return Internal::Supplier<Iface>::create(this);
     }
 
+    template<class Iface>
+    bool contains()
+    {
+        return Internal::Supplier<Iface>::hasProvider(this);
+    }
+
 private:
     QList<void (*)(DependencyManager*)> m_cleanupFunctions;
 };
@@ -24,25 +24,132 @@
 
 #include "jobhandler.h"
 
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
 #include <QHash>
 #include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QTextStream>
 
 #include <KJob>
 
 using namespace Utils;
 
+static void dumpStatsAtExit()
+{
+    JobHandler::dumpStats(QString::fromLocal8Bit(qgetenv("ZANSHIN_JOB_STATS")));
+}
+
 class JobHandlerInstance : public QObject
 {
     Q_OBJECT
 public:
+    struct Context
+    {
+        Context() : priority(JobHandler::VisiblePriority) {}
+
+        QPointer<QObject> owner;
+        JobHandler::Priority priority;
+    };
+
+    struct Holders
+    {
+        Holders() : pinned(false) {}
+
+        QSet<QObject *> owners;
+        bool pinned;
+    };
+
+    struct Timing
+    {
+        Timing() : queuedTime(-1) {}
+
+        QElapsedTimer timer;
+        qint64 queuedTime;
+    };
+
     JobHandlerInstance()
-        : QObject() {}
+        : QObject()
+    {
+        if (!qgetenv("ZANSHIN_JOB_STATS").isEmpty())
+            qAddPostRoutine(dumpStatsAtExit);
+    }
+
+    void track(KJob *job)
+    {
+        if (m_contexts.contains(job))
+            return;
+
+        m_contexts.insert(job, m_current);
+        if (m_current.owner)
+            m_ownedJobs[m_current.owner.data()] << job;
+
+        m_timings[job].timer.start();
+
+        connect(job, SIGNAL(finished(KJob*)), this, SLOT(forgetJob(KJob*)));
+        connect(job, SIGNAL(result(KJob*)), this, SLOT(recordResult(KJob*)));
+        connect(job, SIGNAL(destroyed(QObject*)), this, SLOT(onJobDestroyed(QObject*)));
+    }
+
+    void hold(QObject *shared)
+    {
+        auto holder = m_current.owner.data();
+        if (holder == shared)
+            return;
+
+        auto &holders = m_holders[shared];
+        connect(shared, SIGNAL(destroyed(QObject*)), this, SLOT(onOwnerDestroyed(QObject*)), Qt::UniqueConnection);
+
+        if (!holder) {
+            holders.pinned = true;
+            return;
+        }
+
+        holders.owners.insert(holder);
+        m_held[holder].insert(shared);
+        connect(holder, SIGNAL(destroyed(QObject*)), this, SLOT(onOwnerDestroyed(QObject*)), Qt::UniqueConnection);
+    }
+
+    void cancelJobs(QObject *owner)
+    {
+        for (auto job : m_ownedJobs.take(owner)) {
+            if (job)
+                job->kill(KJob::EmitResult);
+        }
+
+        for (auto shared : m_held.take(owner)) {
+            auto it = m_holders.find(shared);
+            if (it == m_holders.end())
+                continue;
+
+            it->owners.remove(owner);
+            if (it->owners.isEmpty() && !it->pinned) {
+                m_holders.erase(it);
+                cancelJobs(shared);
+            }
+        }
+    }
+
+    void notifyStarted(KJob *job)
+    {
+        auto it = m_timings.find(job);
+        if (it == m_timings.end() || it->queuedTime >= 0)
+            return;
+
+        it->queuedTime = it->timer.restart();
+    }
 
 private slots:
     void handleJobResult(KJob *job)
     {
         Q_ASSERT(m_handlers.contains(job) || m_handlersWithJob.contains(job));
 
+        // Jobs started from the handlers belong to the same scope
+        const auto previous = m_current;
+        m_current = m_contexts.take(job);
+
         for (auto handler : m_handlers.take(job)) {
             handler();
         }
@@ -50,23 +157,191 @@ private slots:
         for (auto handler : m_handlersWithJob.take(job)) {
             handler(job);
         }
+
+        m_current = previous;
+    }
+
+    void forgetJob(KJob *job)
+    {
+        const auto context = m_contexts.value(job);
+        if (context.owner) {
+            auto it = m_ownedJobs.find(context.owner.data());
+            if (it != m_ownedJobs.end()) {
+                it->removeAll(job);
+                if (it->isEmpty())
+                    m_ownedJobs.erase(it);
+            }
+        }
+
+        // The result handling still needs the context otherwise
+        if (!m_handlers.contains(job) && !m_handlersWithJob.contains(job))
+            m_contexts.remove(job);
+    }
+
+    void recordResult(KJob *job)
+    {
+        if (!m_timings.contains(job))
+            return;
+
+        const auto timing = m_timings.take(job);
+        const auto runTime = timing.timer.elapsed();
+        const auto type = QString::fromLatin1(job->metaObject()->className());
+
+        auto &stats = m_stats[type];
+        stats.type = type;
+        stats.count++;
+        if (job->error())
+            stats.errors++;
+        stats.items += job->processedAmount(KJob::Items);
+        stats.queuedTime += qMax<qint64>(0, timing.queuedTime);
+        stats.runTime += runTime;
+        stats.maximumRunTime = qMax(stats.maximumRunTime, runTime);
+    }
+
+    void onOwnerDestroyed(QObject *object)
+    {
+        // Gone without being cancelled, it just doesn't hold anything anymore
+        for (auto shared : m_held.take(object)) {
+            auto it = m_holders.find(shared);
+            if (it != m_holders.end())
+                it->owners.remove(object);
+        }
+
+        if (m_holders.contains(object)) {
+            for (auto holder : m_holders.take(object).owners)
+                m_held[holder].remove(object);
+        }
+    }
+
+    void onJobDestroyed(QObject *object)
+    {
+        // Some jobs never finish, don't let a new job with the same
+        // address pick up their context
+        m_contexts.remove(static_cast<KJob*>(object));
+        m_timings.remove(static_cast<KJob*>(object));
     }
 
 public:
+    Context m_current;
+    QHash<KJob *, Timing> m_timings;
+    QHash<QString, JobHandler::JobStats> m_stats;
+    QHash<KJob *, Context> m_contexts;
+    QHash<QObject *, QList<QPointer<KJob>>> m_ownedJobs;
+    QHash<QObject *, Holders> m_holders;
+    QHash<QObject *, QSet<QObject *>> m_held;
     QHash<KJob *, QList<JobHandler::ResultHandler>> m_handlers;
     QHash<KJob *, QList<JobHandler::ResultHandlerWithJob>> m_handlersWithJob;
 };
 
 Q_GLOBAL_STATIC(JobHandlerInstance, jobHandlerInstance)
 
+
+JobHandler::Scope::Scope(QObject *owner, Priority priority)
+{
+    auto self = jobHandlerInstance();
+    m_previousOwner = self->m_current.owner;
+    m_previousPriority = self->m_current.priority;
+    self->m_current.owner = owner;
+    self->m_current.priority = priority;
+}
+
+JobHandler::Scope::~Scope()
+{
+    auto self = jobHandlerInstance();
+    self->m_current.owner = m_previousOwner;
+    self->m_current.priority = m_previousPriority;
+}
+
+QObject *JobHandler::currentOwner()
+{
+    return jobHandlerInstance()->m_current.owner;
+}
+
+JobHandler::Priority JobHandler::currentPriority()
+{
+    return jobHandlerInstance()->m_current.priority;
+}
+
 void JobHandler::install(KJob *job, const ResultHandler &handler)
 {
     auto self = jobHandlerInstance();
+    self->track(job);
     QObject::connect(job, SIGNAL(result(KJob*)), self, SLOT(handleJobResult(KJob*)), Qt::UniqueConnection);
     self->m_handlers[job] << handler;
     job->start();
 }
 
+void JobHandler::track(KJob *job)
+{
+    jobHandlerInstance()->track(job);
+}
+
+void JobHandler::notifyStarted(KJob *job)
+{
+    jobHandlerInstance()->notifyStarted(job);
+}
+
+void JobHandler::hold(QObject *shared)
+{
+    jobHandlerInstance()->hold(shared);
+}
+
+void JobHandler::cancelJobs(QObject *owner)
+{
+    auto self = jobHandlerInstance();
+    if (!self)
+        return;
+
+    self->cancelJobs(owner);
+}
+
+JobHandler::JobStats::JobStats()
+    : count(0),
+      errors(0),
+      items(0),
+      queuedTime(0),
+      runTime(0),
+      maximumRunTime(0)
+{
+}
+
+QList<JobHandler::JobStats> JobHandler::stats()
+{
+    return jobHandlerInstance()->m_stats.values();
+}
+
+void JobHandler::resetStats()
+{
+    jobHandlerInstance()->m_stats.clear();
+}
+
+bool JobHandler::dumpStats(const QString &fileName)
+{
+    auto self = jobHandlerInstance();
+    if (!self)
+        return false;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+        return false;
+
+    QTextStream stream(&file);
+    stream << "type\tcount\terrors\titems\tqueued_ms\trun_ms\tmax_run_ms\titems_per_s\n";
+    for (const auto &stats : self->m_stats) {
+        const auto itemsPerSecond = stats.runTime > 0 ? (stats.items * 1000 / stats.runTime) : 0;
+        stream << stats.type << '\t'
+               << stats.count << '\t'
+               << stats.errors << '\t'
+               << stats.items << '\t'
+               << stats.queuedTime << '\t'
+               << stats.runTime << '\t'
+               << stats.maximumRunTime << '\t'
+               << itemsPerSecond << '\n';
+    }
+
+    return true;
+}
+
 /**
   * gcc 4.7 does not like overloaded functions with different types of lambdas.
   * because the second variant is not used at all till now disable it.
@@ -27,7 +27,12 @@
 
 #include <functional>
 
+#include <QList>
+#include <QPointer>
+#include <QString>
+
 class KJob;
+class QObject;
 
 namespace Utils {
 
@@ -36,7 +41,70 @@ namespace JobHandler
     typedef std::function<void(KJob*)> ResultHandlerWithJob;
     typedef std::function<void()> ResultHandler;
 
+    enum Priority {
+        VisiblePriority = 0,
+        PrefetchPriority,
+        BackgroundPriority
+    };
+
+    // While a scope is alive the jobs installed or tracked belong to its
+    // owner and priority, the jobs started from their handlers inherit them.
+    // Outside of any scope jobs have no owner and the visible priority.
+    class Scope
+    {
+    public:
+        Scope(QObject *owner, Priority priority);
+        ~Scope();
+
+    private:
+        Q_DISABLE_COPY(Scope)
+
+        QPointer<QObject> m_previousOwner;
+        Priority m_previousPriority;
+    };
+
+    QObject *currentOwner();
+    Priority currentPriority();
+
     void install(KJob *job, const ResultHandler &handler);
+
+    // Ties a job which doesn't go through install() to the current scope
+    void track(KJob *job);
+
+    // Work shared between several owners (e.g. a query result) owns its
+    // jobs itself and gets held by the current owner, outside of any scope
+    // it is held for good. Cancelling a holder only cancels the shared
+    // work once none of its other holders are left.
+    void hold(QObject *shared);
+
+    // Kills the jobs of that owner which are still running, their
+    // handlers get called with the job in error
+    void cancelJobs(QObject *owner);
+
+    // Jobs are considered started when installed or tracked, the ones
+    // waiting in a queue first report when they actually start
+    void notifyStarted(KJob *job);
+
+    // Timings in milliseconds of the jobs which got a result so far,
+    // per job class. Items are the processed amount the jobs report.
+    struct JobStats
+    {
+        JobStats();
+
+        QString type;
+        int count;
+        int errors;
+        qint64 items;
+        qint64 queuedTime;
+        qint64 runTime;
+        qint64 maximumRunTime;
+    };
+
+    QList<JobStats> stats();
+    void resetStats();
+
+    // Also done at exit into the file named by ZANSHIN_JOB_STATS if set
+    bool dumpStats(const QString &fileName);
     /**
       * gcc 4.7 does not like overloaded functions with different types of lambdas.
       * because the second variant is not used at all till now disable it.
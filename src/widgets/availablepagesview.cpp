@@ -272,8 +272,10 @@ void AvailablePagesView::onRemoveTriggered()
 
 void AvailablePagesView::onInitTimeout()
 {
-    if (m_pagesView->model()) {
-        m_pagesView->setCurrentIndex(m_pagesView->model()->index(0, 0));
+    if (auto model = m_pagesView->model()) {
+        if (model->canFetchMore(QModelIndex()))
+            model->fetchMore(QModelIndex());
+        m_pagesView->setCurrentIndex(model->index(0, 0));
         m_pagesView->expandAll();
     }
 }
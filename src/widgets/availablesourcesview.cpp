@@ -182,6 +182,8 @@ void AvailableSourcesView::selectSource(Domain::DataSource::Ptr source, const QM
 {
     std::function<void(QAbstractItemModel *, const QModelIndex &, std::function<void(const QModelIndex &)>)> traverseTree;
     traverseTree = [&traverseTree](QAbstractItemModel *model, const QModelIndex &parent, std::function<void(const QModelIndex &)> visitor) {
+        if (model->canFetchMore(parent))
+            model->fetchMore(parent);
         for (int i = 0; i < model->rowCount(parent); i++) {
             const auto idx = model->index(i, 0, parent);
             visitor(idx);
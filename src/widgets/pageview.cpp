@@ -193,7 +193,7 @@ void PageView::onRemoveItemRequested()
             if (!currentIndex.isValid())
                 continue;
 
-            if (currentIndex.model()->rowCount(currentIndex) > 0) {
+            if (currentIndex.model()->hasChildren(currentIndex)) {
                 hasDescendants = true;
                 break;
             }
@@ -209,7 +209,7 @@ void PageView::onRemoveItemRequested()
         if (!currentIndex.isValid())
             return;
 
-        if (currentIndex.model()->rowCount(currentIndex) > 0)
+        if (currentIndex.model()->hasChildren(currentIndex))
             text = tr("Do you really want to delete the selected item and all its children?");
     }
 
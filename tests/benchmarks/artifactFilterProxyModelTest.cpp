@@ -0,0 +1,158 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include <QtTest/QtTest>
+#include <QStandardItemModel>
+
+#include "akonadi/akonadiserializer.h"
+
+#include "presentation/artifactfilterproxymodel.h"
+#include "presentation/querytreemodelbase.h"
+
+#include "testlib/datasetgenerator.h"
+
+Q_DECLARE_METATYPE(Presentation::ArtifactFilterProxyModel::SortType)
+
+class ArtifactFilterProxyModelBenchmark : public QObject
+{
+    Q_OBJECT
+
+    void fillModel(QStandardItemModel *model, int count);
+
+private slots:
+    void filter_data();
+    void filter();
+    void refineFilter_data();
+    void refineFilter();
+    void sort_data();
+    void sort();
+};
+
+void ArtifactFilterProxyModelBenchmark::fillModel(QStandardItemModel *model, int count)
+{
+    // Nine tasks for one note, only the notes have "note" in their text
+    TestLib::DatasetGenerator::Options options;
+    options.todoCount = count - count / 10;
+    options.noteCount = count / 10;
+    options.projectCount = 0;
+    TestLib::DatasetGenerator generator(options);
+
+    Akonadi::Serializer serializer;
+    foreach (const Domain::Artifact::Ptr &artifact, serializer.createArtifactsFromItems(generator.items())) {
+        auto item = new QStandardItem;
+        item->setData(artifact->title(), Qt::DisplayRole);
+        item->setData(QVariant::fromValue(artifact), Presentation::QueryTreeModelBase::ObjectRole);
+        model->appendRow(item);
+    }
+}
+
+void ArtifactFilterProxyModelBenchmark::filter_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("1000 items") << 1000;
+    QTest::newRow("10000 items") << 10000;
+    QTest::newRow("100000 items") << 100000;
+}
+
+void ArtifactFilterProxyModelBenchmark::filter()
+{
+    QFETCH(int, count);
+
+    QStandardItemModel input;
+    fillModel(&input, count);
+    Presentation::ArtifactFilterProxyModel output;
+    output.setSourceModel(&input);
+    QCOMPARE(output.rowCount(), count);
+
+    // Each round clears the filter and sets it again, like typing a
+    // new search from an empty field
+    QBENCHMARK {
+        output.setFilterFixedString(QString());
+        output.setFilterFixedString("note");
+    }
+
+    QCOMPARE(output.rowCount(), count / 10);
+}
+
+void ArtifactFilterProxyModelBenchmark::refineFilter_data()
+{
+    filter_data();
+}
+
+void ArtifactFilterProxyModelBenchmark::refineFilter()
+{
+    QFETCH(int, count);
+
+    QStandardItemModel input;
+    fillModel(&input, count);
+    Presentation::ArtifactFilterProxyModel output;
+    output.setSourceModel(&input);
+
+    // Typing "note" one key at a time
+    const QString pattern = "note";
+    QBENCHMARK {
+        output.setFilterFixedString(QString());
+        for (int i = 1; i <= pattern.size(); i++)
+            output.setFilterFixedString(pattern.left(i));
+    }
+
+    QCOMPARE(output.rowCount(), count / 10);
+}
+
+void ArtifactFilterProxyModelBenchmark::sort_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<Presentation::ArtifactFilterProxyModel::SortType>("sortType");
+
+    const QList<int> counts = QList<int>() << 1000 << 10000 << 100000;
+    foreach (int count, counts) {
+        const QByteArray size = QByteArray::number(count) + " items";
+        QTest::newRow(size + ", title") << count << Presentation::ArtifactFilterProxyModel::TitleSort;
+        QTest::newRow(size + ", date") << count << Presentation::ArtifactFilterProxyModel::DateSort;
+        QTest::newRow(size + ", progress") << count << Presentation::ArtifactFilterProxyModel::ProgressSort;
+        QTest::newRow(size + ", status") << count << Presentation::ArtifactFilterProxyModel::StatusSort;
+    }
+}
+
+void ArtifactFilterProxyModelBenchmark::sort()
+{
+    QFETCH(int, count);
+    QFETCH(Presentation::ArtifactFilterProxyModel::SortType, sortType);
+
+    QStandardItemModel input;
+    fillModel(&input, count);
+    Presentation::ArtifactFilterProxyModel output;
+    output.setSourceModel(&input);
+
+    // Setting the sort type invalidates the proxy, so every round sorts again
+    QBENCHMARK {
+        output.setSortType(sortType);
+    }
+
+    QCOMPARE(output.rowCount(), count);
+}
+
+QTEST_MAIN(ArtifactFilterProxyModelBenchmark)
+#include "artifactFilterProxyModelTest.moc"
@@ -0,0 +1,102 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include <QtTest/QtTest>
+#include <Akonadi/Collection>
+#include "akonadi/akonadistorage.h"
+#include "testlib/datasetgenerator.h"
+
+class CollectionJobBenchmark : public QObject
+{
+    Q_OBJECT
+
+    Akonadi::Collection::List createCollections(int count, int depth);
+private slots:
+    void resolveAncestors_data();
+    void resolveAncestors();
+};
+
+Akonadi::Collection::List CollectionJobBenchmark::createCollections(int count, int depth)
+{
+    // Only folders, below the generated root, the parents are then turned
+    // into dummies with only an id like what a recursive fetch gives back
+    TestLib::DatasetGenerator::Options options;
+    options.collectionCount = count - 1;
+    options.folderDepth = depth;
+    options.todoCount = 0;
+    options.noteCount = 0;
+    TestLib::DatasetGenerator generator(options);
+
+    Akonadi::Collection::List collections;
+    foreach (Akonadi::Collection collection, generator.collections()) {
+        if (collection.parentCollection() != Akonadi::Collection::root())
+            collection.setParentCollection(Akonadi::Collection(collection.parentCollection().id()));
+        collections << collection;
+    }
+    return collections;
+}
+
+void CollectionJobBenchmark::resolveAncestors_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("depth");
+
+    QTest::newRow("1000 collections, flat") << 1000 << 1;
+    QTest::newRow("1000 collections, 10 levels") << 1000 << 10;
+    QTest::newRow("10000 collections, flat") << 10000 << 1;
+    QTest::newRow("10000 collections, 10 levels") << 10000 << 10;
+    QTest::newRow("10000 collections, 100 levels") << 10000 << 100;
+    QTest::newRow("100000 collections, 10 levels") << 100000 << 10;
+}
+
+void CollectionJobBenchmark::resolveAncestors()
+{
+    QFETCH(int, count);
+    QFETCH(int, depth);
+
+    const auto collections = createCollections(count, depth);
+    const auto mimeTypes = QStringList() << "application/x-vnd.akonadi.calendar.todo";
+
+    Akonadi::Collection::List result;
+    QBENCHMARK {
+        result = Akonadi::Storage::resolveAncestors(Akonadi::Collection::root(), collections, mimeTypes);
+    }
+
+    // Only the task folders are kept, each with its whole chain up to the root
+    QCOMPARE(collections.size(), count);
+    QCOMPARE(result.size(), count - 1);
+
+    auto ancestor = result.last().parentCollection();
+    int levels = 1;
+    while (ancestor != Akonadi::Collection::root()) {
+        QVERIFY(!ancestor.name().isEmpty());
+        ancestor = ancestor.parentCollection();
+        levels++;
+    }
+    QVERIFY(levels >= 2);
+    QVERIFY(levels <= depth + 1);
+}
+
+QTEST_MAIN(CollectionJobBenchmark)
+#include "collectionJobTest.moc"
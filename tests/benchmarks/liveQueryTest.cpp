@@ -0,0 +1,202 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include <QtTest/QtTest>
+#include <KCalCore/Todo>
+#include "domain/livequery.h"
+#include "utils/delayedcall.h"
+#include "testlib/datasetgenerator.h"
+
+// Inputs are (item id, title) pairs taken from the generated tasks,
+// outputs are the titles
+typedef QPair<int, QString> Input;
+typedef Domain::LiveQuery<Input, QString> StringQuery;
+
+class LiveQueryBenchmark : public QObject
+{
+    Q_OBJECT
+
+    QList<Input> createInputs(int count, const QString &prefix);
+    void setupQuery(StringQuery *query, const QList<Input> &fetched);
+
+private slots:
+    void fetch_data();
+    void fetch();
+    void add_data();
+    void add();
+    void change_data();
+    void change();
+    void remove_data();
+    void remove();
+};
+
+QList<Input> LiveQueryBenchmark::createInputs(int count, const QString &prefix)
+{
+    TestLib::DatasetGenerator::Options options;
+    options.todoCount = count;
+    options.noteCount = 0;
+
+    QList<Input> inputs;
+    foreach (const Akonadi::Item &item, TestLib::DatasetGenerator(options).items())
+        inputs << Input(item.id(), prefix + item.payload<KCalCore::Todo::Ptr>()->summary());
+    return inputs;
+}
+
+void LiveQueryBenchmark::setupQuery(StringQuery *query, const QList<Input> &fetched)
+{
+    // Mirrors the way the Akonadi queries are set up
+    query->setRangeFetchFunction([fetched] (const StringQuery::AddRangeFunction &add) {
+        add(fetched);
+    });
+    query->setConvertFunction([] (const Input &input) {
+        return input.second;
+    });
+    query->setUpdateFunction([] (const Input &input, QString &output) {
+        output = input.second;
+    });
+    query->setPredicateFunction([] (const Input &input) {
+        return !input.second.isEmpty();
+    });
+    query->setRepresentsFunction([] (const Input &input, const QString &output) {
+        return input.second == output;
+    });
+    query->setKeyFunction([] (const Input &input) {
+        return input.first;
+    });
+    query->setPostFunction([] (const std::function<void()> &callback) {
+        Utils::DelayedCall::post(callback);
+    });
+    query->setBatchingEnabled(true);
+}
+
+void LiveQueryBenchmark::fetch_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("1000 items") << 1000;
+    QTest::newRow("10000 items") << 10000;
+    QTest::newRow("100000 items") << 100000;
+}
+
+void LiveQueryBenchmark::fetch()
+{
+    QFETCH(int, count);
+
+    const auto inputs = createInputs(count, QString());
+
+    int rowCount = 0;
+    QBENCHMARK {
+        StringQuery query;
+        setupQuery(&query, inputs);
+        rowCount = query.result()->data().size();
+    }
+    QCOMPARE(rowCount, count);
+}
+
+void LiveQueryBenchmark::add_data()
+{
+    fetch_data();
+}
+
+void LiveQueryBenchmark::add()
+{
+    QFETCH(int, count);
+
+    const auto inputs = createInputs(count, QString());
+
+    // A fresh query each time, otherwise the adds turn into updates
+    int rowCount = 0;
+    QBENCHMARK {
+        StringQuery query;
+        setupQuery(&query, QList<Input>());
+        auto result = query.result();
+
+        for (const auto &input : inputs)
+            query.onAdded(input);
+        QCoreApplication::processEvents();
+
+        rowCount = result->data().size();
+    }
+    QCOMPARE(rowCount, count);
+}
+
+void LiveQueryBenchmark::change_data()
+{
+    fetch_data();
+}
+
+void LiveQueryBenchmark::change()
+{
+    QFETCH(int, count);
+
+    StringQuery query;
+    setupQuery(&query, createInputs(count, QString()));
+    auto result = query.result();
+    QCOMPARE(result->data().size(), count);
+
+    const auto changed = createInputs(count, "Changed ");
+
+    QBENCHMARK {
+        for (const auto &input : changed)
+            query.onChanged(input);
+        QCoreApplication::processEvents();
+    }
+    QCOMPARE(result->data().size(), count);
+    QCOMPARE(result->data().first(), changed.first().second);
+}
+
+void LiveQueryBenchmark::remove_data()
+{
+    fetch_data();
+}
+
+void LiveQueryBenchmark::remove()
+{
+    QFETCH(int, count);
+
+    const auto inputs = createInputs(count, QString());
+
+    // Every other item goes away, the fetch is part of the measure since
+    // each round needs a populated query
+    QList<Input> removed;
+    for (int i = 0; i < count; i += 2)
+        removed << inputs.at(i);
+
+    int rowCount = 0;
+    QBENCHMARK {
+        StringQuery query;
+        setupQuery(&query, inputs);
+        auto result = query.result();
+
+        for (const auto &input : removed)
+            query.onRemoved(input);
+        QCoreApplication::processEvents();
+
+        rowCount = result->data().size();
+    }
+    QCOMPARE(rowCount, count - removed.size());
+}
+
+QTEST_MAIN(LiveQueryBenchmark)
+#include "liveQueryTest.moc"
@@ -0,0 +1,147 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#include <QtTest/QtTest>
+#include "domain/queryresult.h"
+
+class QueryResultProviderBenchmark : public QObject
+{
+    Q_OBJECT
+
+    QList<Domain::QueryResult<int>::Ptr> createResults(const Domain::QueryResultProvider<int>::Ptr &provider,
+                                                        int count, int *callCount);
+    QList<Domain::QueryResult<int>::Ptr> createRangeResults(const Domain::QueryResultProvider<int>::Ptr &provider,
+                                                             int count, int *callCount);
+private slots:
+    void appendAndRemove_data();
+    void appendAndRemove();
+    void appendAndRemoveWithRangeHandlers_data();
+    void appendAndRemoveWithRangeHandlers();
+    void replace_data();
+    void replace();
+};
+
+QList<Domain::QueryResult<int>::Ptr> QueryResultProviderBenchmark::createResults(const Domain::QueryResultProvider<int>::Ptr &provider,
+                                                                                  int count, int *callCount)
+{
+    QList<Domain::QueryResult<int>::Ptr> results;
+    for (int i = 0; i < count; i++) {
+        auto result = Domain::QueryResult<int>::create(provider);
+        auto handler = [callCount] (int, int) { (*callCount)++; };
+        result->addPreInsertHandler(handler);
+        result->addPostInsertHandler(handler);
+        result->addPreRemoveHandler(handler);
+        result->addPostRemoveHandler(handler);
+        result->addPreReplaceHandler(handler);
+        result->addPostReplaceHandler(handler);
+        results << result;
+    }
+    return results;
+}
+
+// Same as above but the results also listen to ranges, like the
+// tree models do, so single item changes go through both paths
+QList<Domain::QueryResult<int>::Ptr> QueryResultProviderBenchmark::createRangeResults(const Domain::QueryResultProvider<int>::Ptr &provider,
+                                                                                       int count, int *callCount)
+{
+    auto results = createResults(provider, count, callCount);
+    foreach (const auto &result, results) {
+        auto handler = [callCount] (const Domain::QueryResultRange<int> &items, int) { (*callCount) += items.size(); };
+        result->addPreInsertRangeHandler(handler);
+        result->addPostInsertRangeHandler(handler);
+        result->addPreRemoveRangeHandler(handler);
+        result->addPostRemoveRangeHandler(handler);
+    }
+    return results;
+}
+
+void QueryResultProviderBenchmark::appendAndRemove_data()
+{
+    QTest::addColumn<int>("resultCount");
+
+    QTest::newRow("1 result") << 1;
+    QTest::newRow("5 results") << 5;
+    QTest::newRow("20 results") << 20;
+}
+
+void QueryResultProviderBenchmark::appendAndRemove()
+{
+    QFETCH(int, resultCount);
+
+    int callCount = 0;
+    auto provider = Domain::QueryResultProvider<int>::Ptr::create();
+    auto results = createResults(provider, resultCount, &callCount);
+
+    QBENCHMARK {
+        provider->append(42);
+        provider->removeLast();
+    }
+
+    QVERIFY(callCount > 0);
+}
+
+void QueryResultProviderBenchmark::appendAndRemoveWithRangeHandlers_data()
+{
+    appendAndRemove_data();
+}
+
+void QueryResultProviderBenchmark::appendAndRemoveWithRangeHandlers()
+{
+    QFETCH(int, resultCount);
+
+    int callCount = 0;
+    auto provider = Domain::QueryResultProvider<int>::Ptr::create();
+    auto results = createRangeResults(provider, resultCount, &callCount);
+
+    QBENCHMARK {
+        provider->append(42);
+        provider->removeLast();
+    }
+
+    QVERIFY(callCount > 0);
+}
+
+void QueryResultProviderBenchmark::replace_data()
+{
+    appendAndRemove_data();
+}
+
+void QueryResultProviderBenchmark::replace()
+{
+    QFETCH(int, resultCount);
+
+    int callCount = 0;
+    auto provider = Domain::QueryResultProvider<int>::Ptr::create();
+    provider->append(0);
+    auto results = createResults(provider, resultCount, &callCount);
+
+    int value = 0;
+    QBENCHMARK {
+        provider->replace(0, value++);
+    }
+
+    QVERIFY(callCount > 0);
+}
+
+QTEST_MAIN(QueryResultProviderBenchmark)
+#include "queryResultProviderTest.moc"
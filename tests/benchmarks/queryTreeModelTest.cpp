@@ -0,0 +1,228 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#include <QtTest/QtTest>
+#include <KCalCore/Todo>
+#include "domain/queryresult.h"
+#include "presentation/querytreemodel.h"
+#include "testlib/datasetgenerator.h"
+
+typedef Presentation::QueryTreeModel<int> IntTreeModel;
+
+class QueryTreeModelBenchmark : public QObject
+{
+    Q_OBJECT
+
+    QHash<int, QList<int>> createTree(int count, int depth);
+    IntTreeModel *createModel(const QHash<int, QList<int>> &children);
+    int scroll(IntTreeModel *model, const QModelIndex &parent);
+    int populate(IntTreeModel *model, const QModelIndex &parent);
+
+private slots:
+    void populate_data();
+    void populate();
+    void scroll_data();
+    void scroll();
+    void removeFirst_data();
+    void removeFirst();
+};
+
+QHash<int, QList<int>> QueryTreeModelBenchmark::createTree(int count, int depth)
+{
+    // Nodes are the ids of the generated tasks, arranged by their parent uid,
+    // 0 being the root
+    TestLib::DatasetGenerator::Options options;
+    options.todoCount = count;
+    options.noteCount = 0;
+    options.projectCount = 0;
+    options.subtaskDepth = depth;
+
+    QHash<QString, int> idForUid;
+    QHash<int, QList<int>> children;
+    foreach (const Akonadi::Item &item, TestLib::DatasetGenerator(options).items()) {
+        auto todo = item.payload<KCalCore::Todo::Ptr>();
+        idForUid.insert(todo->uid(), item.id());
+        children[idForUid.value(todo->relatedTo())] << item.id();
+    }
+    return children;
+}
+
+IntTreeModel *QueryTreeModelBenchmark::createModel(const QHash<int, QList<int>> &children)
+{
+    auto queryGenerator = [children] (const int &item) {
+        auto provider = Domain::QueryResultProvider<int>::Ptr::create();
+        foreach (int child, children.value(item))
+            provider->append(child);
+        return Domain::QueryResult<int>::create(provider);
+    };
+    auto flagsFunction = [] (const int &) {
+        return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+    };
+    auto dataFunction = [] (const int &item, int role) {
+        if (role != Qt::DisplayRole)
+            return QVariant();
+        return QVariant(item);
+    };
+    auto setDataFunction = [] (const int &, const QVariant &, int) {
+        return false;
+    };
+
+    return new IntTreeModel(queryGenerator, flagsFunction, dataFunction, setDataFunction);
+}
+
+int QueryTreeModelBenchmark::scroll(IntTreeModel *model, const QModelIndex &parent)
+{
+    // Mimics what a view does while painting rows: index, data and a trip back to the parent
+    int visited = 0;
+    const int rowCount = model->rowCount(parent);
+    for (int row = 0; row < rowCount; row++) {
+        const QModelIndex index = model->index(row, 0, parent);
+        model->data(index, Qt::DisplayRole);
+        model->flags(index);
+        if (model->parent(index) != parent)
+            return -1;
+        visited++;
+
+        if (model->hasChildren(index))
+            visited += scroll(model, index);
+    }
+    return visited;
+}
+
+int QueryTreeModelBenchmark::populate(IntTreeModel *model, const QModelIndex &parent)
+{
+    // Only asks for what is needed to build every node, that's what
+    // expanding the whole tree in a view ends up doing
+    model->fetchMore(parent);
+
+    int count = 0;
+    const int rowCount = model->rowCount(parent);
+    for (int row = 0; row < rowCount; row++) {
+        count++;
+        count += populate(model, model->index(row, 0, parent));
+    }
+    return count;
+}
+
+void QueryTreeModelBenchmark::populate_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("depth");
+
+    QTest::newRow("1000 flat rows") << 1000 << 0;
+    QTest::newRow("10000 flat rows") << 10000 << 0;
+    QTest::newRow("100000 flat rows") << 100000 << 0;
+    QTest::newRow("1000 rows in a tree") << 1000 << 9;
+    QTest::newRow("10000 rows in a tree") << 10000 << 9;
+    QTest::newRow("100000 rows in a tree") << 100000 << 9;
+}
+
+void QueryTreeModelBenchmark::populate()
+{
+    QFETCH(int, count);
+    QFETCH(int, depth);
+
+    const auto tree = createTree(count, depth);
+
+    int populated = 0;
+    QBENCHMARK {
+        QScopedPointer<IntTreeModel> model(createModel(tree));
+        populated = populate(model.data(), QModelIndex());
+    }
+
+    QCOMPARE(populated, count);
+}
+
+void QueryTreeModelBenchmark::scroll_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("depth");
+
+    QTest::newRow("10000 flat rows") << 10000 << 0;
+    QTest::newRow("10000 rows, chains of 10") << 10000 << 9;
+    QTest::newRow("10000 rows, chains of 100") << 10000 << 99;
+}
+
+void QueryTreeModelBenchmark::scroll()
+{
+    QFETCH(int, count);
+    QFETCH(int, depth);
+
+    QScopedPointer<IntTreeModel> model(createModel(createTree(count, depth)));
+    QCOMPARE(populate(model.data(), QModelIndex()), count);
+    QCOMPARE(scroll(model.data(), QModelIndex()), count);
+
+    int visited = 0;
+    QBENCHMARK {
+        visited = scroll(model.data(), QModelIndex());
+    }
+
+    QCOMPARE(visited, count);
+}
+
+void QueryTreeModelBenchmark::removeFirst_data()
+{
+    QTest::addColumn<int>("topLevelCount");
+
+    QTest::newRow("1000 rows") << 1000;
+    QTest::newRow("10000 rows") << 10000;
+}
+
+void QueryTreeModelBenchmark::removeFirst()
+{
+    QFETCH(int, topLevelCount);
+
+    auto provider = Domain::QueryResultProvider<int>::Ptr::create();
+    foreach (int item, createTree(topLevelCount, 0).value(0))
+        provider->append(item);
+
+    auto queryGenerator = [provider] (const int &item) {
+        if (item == 0)
+            return Domain::QueryResult<int>::create(provider);
+        else
+            return Domain::QueryResult<int>::Ptr();
+    };
+    auto flagsFunction = [] (const int &) {
+        return Qt::NoItemFlags;
+    };
+    auto dataFunction = [] (const int &, int) {
+        return QVariant();
+    };
+    auto setDataFunction = [] (const int &, const QVariant &, int) {
+        return false;
+    };
+    IntTreeModel model(queryGenerator, flagsFunction, dataFunction, setDataFunction);
+    model.fetchMore(QModelIndex());
+    QCOMPARE(model.rowCount(), topLevelCount);
+
+    int value = topLevelCount;
+    QBENCHMARK {
+        provider->removeFirst();
+        provider->append(++value);
+    }
+
+    QCOMPARE(model.rowCount(), topLevelCount);
+}
+
+QTEST_MAIN(QueryTreeModelBenchmark)
+#include "queryTreeModelTest.moc"
@@ -24,37 +24,116 @@
 #include <QtTest/QtTest>
 #include <Akonadi/Item>
 #include <KCalCore/Todo>
+#include "domain/note.h"
+#include "domain/project.h"
 #include "domain/task.h"
 #include "akonadi/akonadiserializer.h"
+#include "testlib/datasetgenerator.h"
 
 class SerializerBenchmark : public QObject
 {
     Q_OBJECT
 
     Akonadi::Item createTestItem();
+    Akonadi::Item::List createTestItems(int count);
+    Akonadi::Item::List createTaskItems(int count, bool rich);
+    Akonadi::Item::List createNoteItems(int count);
+    Akonadi::Item::List createProjectItems(int count);
+    void addItemCounts();
+    void addTaskKinds();
 private slots:
     void deserialize();
     void checkPayloadAndDeserialize();
     void deserializeAndDestroy();
     void checkPayload();
+    void representsItem();
+    void representsItemThroughDynamicProperty();
+    void deserializeOneByOne_data();
+    void deserializeOneByOne();
+    void deserializeInBulk_data();
+    void deserializeInBulk();
+    void filterDescendantItems_data();
+    void filterDescendantItems();
+    void deserializeTasks_data();
+    void deserializeTasks();
+    void serializeTasks_data();
+    void serializeTasks();
+    void deserializeNotes_data();
+    void deserializeNotes();
+    void serializeNotes_data();
+    void serializeNotes();
+    void deserializeProjects_data();
+    void deserializeProjects();
+    void serializeProjects_data();
+    void serializeProjects();
 };
 
 Akonadi::Item SerializerBenchmark::createTestItem()
 {
-    KCalCore::Todo::Ptr todo(new KCalCore::Todo);
-    todo->setSummary("summary");
-    todo->setDescription("content");
-    todo->setCompleted(false);
-    todo->setDtStart(KDateTime(QDateTime(QDate(2013, 11, 24))));
-    todo->setDtDue(KDateTime(QDateTime(QDate(2014, 03, 01))));
-    todo->setRelatedTo("5");
+    // A subtask, it has its parent uid set like createTestItems() ones
+    return createTestItems(2).last();
+}
+
+Akonadi::Item::List SerializerBenchmark::createTestItems(int count)
+{
+    // One folder so that each task but the chain heads is a subtask
+    TestLib::DatasetGenerator::Options options;
+    options.collectionCount = 1;
+    options.todoCount = count;
+    options.noteCount = 0;
+    options.projectCount = 0;
+    return TestLib::DatasetGenerator(options).items();
+}
+
+Akonadi::Item::List SerializerBenchmark::createTaskItems(int count, bool rich)
+{
+    // Rich tasks all have a recurrence and a delegate
+    TestLib::DatasetGenerator::Options options;
+    options.todoCount = count;
+    options.noteCount = 0;
+    options.projectCount = 0;
+    options.recurrencePercent = rich ? 100 : 0;
+    options.delegationPercent = rich ? 100 : 0;
+    return TestLib::DatasetGenerator(options).items();
+}
+
+Akonadi::Item::List SerializerBenchmark::createNoteItems(int count)
+{
+    TestLib::DatasetGenerator::Options options;
+    options.todoCount = 0;
+    options.noteCount = count;
+    return TestLib::DatasetGenerator(options).items();
+}
 
-    // ... as payload of an item
-    Akonadi::Item item;
-    item.setMimeType("application/x-vnd.akonadi.calendar.todo");
-    item.setPayload<KCalCore::Todo::Ptr>(todo);
+Akonadi::Item::List SerializerBenchmark::createProjectItems(int count)
+{
+    TestLib::DatasetGenerator::Options options;
+    options.todoCount = count;
+    options.projectCount = count;
+    options.noteCount = 0;
+    return TestLib::DatasetGenerator(options).items();
+}
+
+void SerializerBenchmark::addItemCounts()
+{
+    QTest::addColumn<int>("count");
 
-    return item;
+    QTest::newRow("1000 items") << 1000;
+    QTest::newRow("10000 items") << 10000;
+    QTest::newRow("100000 items") << 100000;
+}
+
+void SerializerBenchmark::addTaskKinds()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<bool>("rich");
+
+    const QList<int> counts = QList<int>() << 1000 << 10000 << 100000;
+    foreach (int count, counts) {
+        const QByteArray size = QByteArray::number(count) + " items";
+        QTest::newRow(size + ", plain") << count << false;
+        QTest::newRow(size + ", recurrence and attendees") << count << true;
+    }
 }
 
 void SerializerBenchmark::deserialize()
@@ -78,7 +157,7 @@ void SerializerBenchmark::checkPayloadAndDeserialize()
             return;
 
         auto todoCheck = item.payload<KCalCore::Todo::Ptr>();
-        if (todoCheck->relatedTo() != "5") {
+        if (todoCheck->relatedTo() != "task-1") {
             return;
         }
 
@@ -104,11 +183,261 @@ void SerializerBenchmark::checkPayload()
             return;
 
         auto todoCheck = item.payload<KCalCore::Todo::Ptr>();
-        if (todoCheck->relatedTo() != "5") {
+        if (todoCheck->relatedTo() != "task-1") {
             return;
         }
     }
 }
 
+void SerializerBenchmark::representsItem()
+{
+    Akonadi::Item item = createTestItem();
+    item.setId(42);
+    Akonadi::Serializer serializer;
+    auto task = serializer.createTaskFromItem(item);
+
+    bool represents = false;
+    QBENCHMARK {
+        represents = serializer.representsItem(task, item);
+    }
+    QVERIFY(represents);
+}
+
+void SerializerBenchmark::representsItemThroughDynamicProperty()
+{
+    // Reference point, that's how the identity used to be stored on tasks
+    Akonadi::Item item = createTestItem();
+    item.setId(42);
+    Domain::Task::Ptr task(new Domain::Task);
+    task->setProperty("itemId", item.id());
+
+    bool represents = false;
+    QBENCHMARK {
+        represents = task->property("itemId").toLongLong() == item.id();
+    }
+    QVERIFY(represents);
+}
+
+void SerializerBenchmark::deserializeOneByOne_data()
+{
+    addItemCounts();
+}
+
+void SerializerBenchmark::deserializeOneByOne()
+{
+    QFETCH(int, count);
+
+    const Akonadi::Item::List items = createTestItems(count);
+    Akonadi::Serializer serializer;
+
+    Domain::Task::List tasks;
+    QBENCHMARK {
+        tasks.clear();
+        for (const auto &item : items)
+            tasks << serializer.createTaskFromItem(item);
+    }
+    QCOMPARE(tasks.size(), count);
+}
+
+void SerializerBenchmark::deserializeInBulk_data()
+{
+    deserializeOneByOne_data();
+}
+
+void SerializerBenchmark::deserializeInBulk()
+{
+    QFETCH(int, count);
+
+    const Akonadi::Item::List items = createTestItems(count);
+    Akonadi::Serializer serializer;
+
+    Domain::Task::List tasks;
+    QBENCHMARK {
+        tasks = serializer.createTasksFromItems(items);
+    }
+    QCOMPARE(tasks.size(), count);
+}
+
+void SerializerBenchmark::filterDescendantItems_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("chainLength");
+
+    QTest::newRow("1000 items, chains of 100") << 1000 << 100;
+    QTest::newRow("10000 items, chains of 100") << 10000 << 100;
+    QTest::newRow("50000 items, chains of 10") << 50000 << 10;
+    QTest::newRow("50000 items, chains of 100") << 50000 << 100;
+    QTest::newRow("50000 items, chains of 1000") << 50000 << 1000;
+    QTest::newRow("100000 items, chains of 100") << 100000 << 100;
+}
+
+void SerializerBenchmark::filterDescendantItems()
+{
+    QFETCH(int, count);
+    QFETCH(int, chainLength);
+
+    // A single project in a single folder, a third of the subtask chains
+    // hang below it, the others are unrelated top level tasks
+    TestLib::DatasetGenerator::Options options;
+    options.collectionCount = 1;
+    options.todoCount = count;
+    options.noteCount = 0;
+    options.projectCount = 1;
+    options.subtaskDepth = chainLength - 1;
+    const Akonadi::Item::List items = TestLib::DatasetGenerator(options).items();
+    const Akonadi::Item ancestor = items.first();
+
+    // Parents always come before their children in the generated data
+    QSet<QString> descendantUids;
+    descendantUids << ancestor.payload<KCalCore::Todo::Ptr>()->uid();
+    foreach (const Akonadi::Item &item, items) {
+        auto todo = item.payload<KCalCore::Todo::Ptr>();
+        if (descendantUids.contains(todo->relatedTo()))
+            descendantUids << todo->uid();
+    }
+    const int descendantCount = descendantUids.size() - 1;
+    QVERIFY(descendantCount > 0);
+
+    Akonadi::Serializer serializer;
+    Akonadi::Item::List descendants;
+    QBENCHMARK {
+        descendants = serializer.filterDescendantItems(items, ancestor);
+    }
+    QCOMPARE(descendants.size(), descendantCount);
+}
+
+void SerializerBenchmark::deserializeTasks_data()
+{
+    addTaskKinds();
+}
+
+void SerializerBenchmark::deserializeTasks()
+{
+    QFETCH(int, count);
+    QFETCH(bool, rich);
+
+    const Akonadi::Item::List items = createTaskItems(count, rich);
+    Akonadi::Serializer serializer;
+
+    Domain::Task::List tasks;
+    QBENCHMARK {
+        tasks.clear();
+        for (const auto &item : items)
+            tasks << serializer.createTaskFromItem(item);
+    }
+    QCOMPARE(tasks.size(), count);
+    QCOMPARE(!tasks.first()->recurrence().isNull(), rich);
+}
+
+void SerializerBenchmark::serializeTasks_data()
+{
+    addTaskKinds();
+}
+
+void SerializerBenchmark::serializeTasks()
+{
+    QFETCH(int, count);
+    QFETCH(bool, rich);
+
+    Akonadi::Serializer serializer;
+    const Domain::Task::List tasks = serializer.createTasksFromItems(createTaskItems(count, rich));
+
+    Akonadi::Item::List items;
+    QBENCHMARK {
+        items.clear();
+        for (const auto &task : tasks)
+            items << serializer.createItemFromTask(task);
+    }
+    QCOMPARE(items.size(), count);
+}
+
+void SerializerBenchmark::deserializeNotes_data()
+{
+    addItemCounts();
+}
+
+void SerializerBenchmark::deserializeNotes()
+{
+    QFETCH(int, count);
+
+    const Akonadi::Item::List items = createNoteItems(count);
+    Akonadi::Serializer serializer;
+
+    Domain::Note::List notes;
+    QBENCHMARK {
+        notes.clear();
+        for (const auto &item : items)
+            notes << serializer.createNoteFromItem(item);
+    }
+    QCOMPARE(notes.size(), count);
+}
+
+void SerializerBenchmark::serializeNotes_data()
+{
+    addItemCounts();
+}
+
+void SerializerBenchmark::serializeNotes()
+{
+    QFETCH(int, count);
+
+    Akonadi::Serializer serializer;
+    Domain::Note::List notes;
+    for (const auto &item : createNoteItems(count))
+        notes << serializer.createNoteFromItem(item);
+
+    Akonadi::Item::List items;
+    QBENCHMARK {
+        items.clear();
+        for (const auto &note : notes)
+            items << serializer.createItemFromNote(note);
+    }
+    QCOMPARE(items.size(), count);
+}
+
+void SerializerBenchmark::deserializeProjects_data()
+{
+    addItemCounts();
+}
+
+void SerializerBenchmark::deserializeProjects()
+{
+    QFETCH(int, count);
+
+    const Akonadi::Item::List items = createProjectItems(count);
+    Akonadi::Serializer serializer;
+
+    Domain::Project::List projects;
+    QBENCHMARK {
+        projects.clear();
+        for (const auto &item : items)
+            projects << serializer.createProjectFromItem(item);
+    }
+    QCOMPARE(projects.size(), count);
+}
+
+void SerializerBenchmark::serializeProjects_data()
+{
+    addItemCounts();
+}
+
+void SerializerBenchmark::serializeProjects()
+{
+    QFETCH(int, count);
+
+    Akonadi::Serializer serializer;
+    Domain::Project::List projects;
+    for (const auto &item : createProjectItems(count))
+        projects << serializer.createProjectFromItem(item);
+
+    Akonadi::Item::List items;
+    QBENCHMARK {
+        items.clear();
+        for (const auto &project : projects)
+            items << serializer.createItemFromProject(project);
+    }
+    QCOMPARE(items.size(), count);
+}
+
 QTEST_MAIN(SerializerBenchmark)
-#include "deserializerTest.moc"
+#include "serializerTest.moc"
@@ -16,6 +16,7 @@
 #include "akonadi/akonadicontextrepository.h"
 #include "akonadi/akonadidatasourcequeries.h"
 #include "akonadi/akonadidatasourcerepository.h"
+#include "akonadi/akonadimonitorproxy.h"
 #include "akonadi/akonadinoterepository.h"
 #include "akonadi/akonadiprojectqueries.h"
 #include "akonadi/akonadiprojectrepository.h"
@@ -28,6 +29,8 @@
 #include "presentation/querytreemodelbase.h"
 #include "presentation/datasourcelistmodel.h"
 
+#include "utils/dependencymanager.h"
+
 static int argc = 0;
 static QApplication app(argc, 0);
 
@@ -42,6 +45,30 @@ namespace cucumber {
 
 using namespace cucumber;
 
+namespace Zanshin {
+
+bool startChildrenFetch(QAbstractItemModel *model, const QModelIndex &root = QModelIndex())
+{
+    bool started = model->canFetchMore(root);
+    if (started)
+        model->fetchMore(root);
+
+    for (int row = 0; row < model->rowCount(root); row++)
+        started = startChildrenFetch(model, model->index(row, 0, root)) || started;
+
+    return started;
+}
+
+// The tree models only query the children of a node when they are asked for,
+// walk the tree until every node got its children so that steps see everything
+void populateModel(QAbstractItemModel *model)
+{
+    while (startChildrenFetch(model))
+        QTest::qWait(200);
+}
+
+}
+
 class ZanshinContext : public QObject
 {
     Q_OBJECT
@@ -56,6 +83,8 @@ public:
         using namespace Presentation;
         proxyModel->setDynamicSortFilter(true);
 
+        Utils::DependencyManager::globalInstance().add<Akonadi::MonitorInterface, Akonadi::MonitorProxy>();
+
         auto appModel = new ApplicationModel(new Akonadi::ArtifactQueries(this),
                                              new Akonadi::ProjectQueries(this),
                                              new Akonadi::ProjectRepository(this),
@@ -85,6 +114,7 @@ public:
         proxyModel->setSourceModel(model);
         proxyModel->setSortRole(Qt::DisplayRole);
         proxyModel->sort(0);
+        Zanshin::populateModel(proxyModel);
     }
 
     QAbstractItemModel *model()
@@ -447,6 +477,7 @@ WHEN("^I add a \"(.*)\" named \"(.+)\"$") {
 WHEN("^I list the items$") {
     ScenarioScope<ZanshinContext> context;
     context->indices.clear();
+    Zanshin::populateModel(context->model());
     Zanshin::collectIndices(context.get());
 }
 
@@ -0,0 +1,100 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include <KAboutData>
+#include <KApplication>
+#include <KCmdLineArgs>
+
+#include <QTextStream>
+
+#include "testlib/datasetgenerator.h"
+
+static int intOption(KCmdLineArgs *args, const QByteArray &name, int defaultValue)
+{
+    if (!args->isSet(name))
+        return defaultValue;
+
+    bool ok = false;
+    const int value = args->getOption(name).toInt(&ok);
+    return ok && value >= 0 ? value : defaultValue;
+}
+
+int main(int argc, char **argv)
+{
+    KAboutData about("generatedataset", "generatedataset",
+                     ki18n("Generates a synthetic store to test and measure Zanshin against"), "1.0");
+    KCmdLineArgs::init(argc, argv, &about);
+
+    const TestLib::DatasetGenerator::Options defaults;
+
+    KCmdLineOptions options;
+    options.add("collections <count>", ki18n("Number of task and note folders"), QByteArray::number(defaults.collectionCount));
+    options.add("folder-depth <depth>", ki18n("Depth of the folder chains"), QByteArray::number(defaults.folderDepth));
+    options.add("todos <count>", ki18n("Number of todos, projects included"), QByteArray::number(defaults.todoCount));
+    options.add("notes <count>", ki18n("Number of notes"), QByteArray::number(defaults.noteCount));
+    options.add("depth <depth>", ki18n("Depth of the subtask chains"), QByteArray::number(defaults.subtaskDepth));
+    options.add("projects <count>", ki18n("Number of projects"), QByteArray::number(defaults.projectCount));
+    options.add("contexts <count>", ki18n("Number of contexts"), QByteArray::number(defaults.contextCount));
+    options.add("tags <count>", ki18n("Number of tags"), QByteArray::number(defaults.tagCount));
+    options.add("recurrences <percent>", ki18n("Share of recurring tasks"), QByteArray::number(defaults.recurrencePercent));
+    options.add("delegations <percent>", ki18n("Share of delegated tasks"), QByteArray::number(defaults.delegationPercent));
+    options.add("other-users <count>", ki18n("Number of person folders below \"Other Users\""), QByteArray::number(defaults.otherUserCount));
+    options.add("seed <seed>", ki18n("Seed of the generator"), QByteArray::number(defaults.seed));
+    options.add("+directory", ki18n("Where to write the akonaditest environment"));
+    KCmdLineArgs::addCmdLineOptions(options);
+
+    KApplication app(false);
+    KCmdLineArgs *args = KCmdLineArgs::parsedArgs();
+    if (args->count() != 1)
+        KCmdLineArgs::usageError(i18n("A target directory is needed."));
+
+    TestLib::DatasetGenerator::Options generatorOptions;
+    generatorOptions.collectionCount = intOption(args, "collections", defaults.collectionCount);
+    generatorOptions.folderDepth = intOption(args, "folder-depth", defaults.folderDepth);
+    generatorOptions.todoCount = intOption(args, "todos", defaults.todoCount);
+    generatorOptions.noteCount = intOption(args, "notes", defaults.noteCount);
+    generatorOptions.subtaskDepth = intOption(args, "depth", defaults.subtaskDepth);
+    generatorOptions.projectCount = intOption(args, "projects", defaults.projectCount);
+    generatorOptions.contextCount = intOption(args, "contexts", defaults.contextCount);
+    generatorOptions.tagCount = intOption(args, "tags", defaults.tagCount);
+    generatorOptions.recurrencePercent = intOption(args, "recurrences", defaults.recurrencePercent);
+    generatorOptions.delegationPercent = intOption(args, "delegations", defaults.delegationPercent);
+    generatorOptions.otherUserCount = intOption(args, "other-users", defaults.otherUserCount);
+    generatorOptions.seed = intOption(args, "seed", defaults.seed);
+
+    TestLib::DatasetGenerator generator(generatorOptions);
+    const QString directory = args->arg(0);
+
+    QTextStream out(stdout);
+    if (!generator.writeTestEnvironment(directory)) {
+        out << "Couldn't write the environment in " << directory << endl;
+        return 1;
+    }
+
+    out << generator.collections().size() << " collections, "
+        << generator.items().size() << " items and "
+        << generator.tags().size() << " tags written in " << directory << endl
+        << "Run with: akonaditest -c " << directory << "/config.xml <command>" << endl;
+    return 0;
+}
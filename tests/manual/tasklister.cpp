@@ -27,10 +27,13 @@
 
 #include <QListView>
 
+#include "akonadi/akonadimonitorproxy.h"
 #include "akonadi/akonaditaskqueries.h"
 #include "akonadi/akonaditaskrepository.h"
 #include "presentation/tasklistmodel.h"
 
+#include "utils/dependencymanager.h"
+
 int main(int argc, char **argv)
 {
     KAboutData about("tasklister", "tasklister",
@@ -38,6 +41,8 @@ int main(int argc, char **argv)
     KCmdLineArgs::init(argc, argv, &about);
     KApplication app;
 
+    Utils::DependencyManager::globalInstance().add<Akonadi::MonitorInterface, Akonadi::MonitorProxy>();
+
     Akonadi::TaskRepository repository;
     Akonadi::TaskQueries queries;
     auto taskList = queries.findAll();
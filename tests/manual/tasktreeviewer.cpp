@@ -28,10 +28,13 @@
 
 #include <QTreeView>
 
+#include "akonadi/akonadimonitorproxy.h"
 #include "akonadi/akonaditaskqueries.h"
 #include "akonadi/akonaditaskrepository.h"
 #include "presentation/querytreemodel.h"
 
+#include "utils/dependencymanager.h"
+
 int main(int argc, char **argv)
 {
     KAboutData about("tasktreeviewer", "tasktreeviewer",
@@ -39,6 +42,8 @@ int main(int argc, char **argv)
     KCmdLineArgs::init(argc, argv, &about);
     KApplication app;
 
+    Utils::DependencyManager::globalInstance().add<Akonadi::MonitorInterface, Akonadi::MonitorProxy>();
+
     Akonadi::TaskRepository repository;
     Akonadi::TaskQueries queries;
 
@@ -145,6 +145,11 @@ void MockMonitor::changeItem(const Akonadi::Item &item)
     emit itemChanged(item);
 }
 
+void MockMonitor::moveItem(const Akonadi::Item &item)
+{
+    emit itemMoved(item);
+}
+
 void MockMonitor::addTag(const Akonadi::Tag &tag)
 {
     emit tagAdded(tag);
@@ -122,6 +122,7 @@ public:
     void addItem(const Akonadi::Item &item);
     void removeItem(const Akonadi::Item &item);
     void changeItem(const Akonadi::Item &item);
+    void moveItem(const Akonadi::Item &item);
 
     void addTag(const Akonadi::Tag &tag);
     void removeTag(const Akonadi::Tag &tag);
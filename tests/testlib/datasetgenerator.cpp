@@ -0,0 +1,459 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include "datasetgenerator.h"
+
+#include <QDir>
+#include <QFile>
+#include <QXmlStreamWriter>
+
+#include <Akonadi/Notes/NoteUtils>
+#include <akonadi/collectionidentificationattribute.h>
+#include <KCalCore/ICalFormat>
+#include <KCalCore/Todo>
+#include <KMime/Message>
+
+#include "akonadi/akonadiserializerinterface.h"
+#include "testlib/akonadimocks.h"
+
+using namespace TestLib;
+
+DatasetGenerator::Options::Options()
+    : collectionCount(4),
+      folderDepth(1),
+      todoCount(1000),
+      noteCount(200),
+      subtaskDepth(2),
+      projectCount(20),
+      contextCount(5),
+      tagCount(5),
+      recurrencePercent(5),
+      delegationPercent(5),
+      otherUserCount(0),
+      seed(42)
+{
+}
+
+DatasetGenerator::DatasetGenerator(const Options &options)
+    : m_options(options),
+      m_randomState(options.seed)
+{
+    generate();
+}
+
+DatasetGenerator::Options DatasetGenerator::options() const
+{
+    return m_options;
+}
+
+Akonadi::Collection DatasetGenerator::rootCollection() const
+{
+    return m_root;
+}
+
+Akonadi::Collection::List DatasetGenerator::collections() const
+{
+    return m_collections;
+}
+
+Akonadi::Item::List DatasetGenerator::items() const
+{
+    return m_items;
+}
+
+Akonadi::Item::List DatasetGenerator::items(const Akonadi::Collection &collection) const
+{
+    return m_itemsForCollection.value(collection.id());
+}
+
+Akonadi::Tag::List DatasetGenerator::tags() const
+{
+    return m_contexts + m_tags;
+}
+
+MockCollectionFetchJob *DatasetGenerator::createCollectionFetchJob(QObject *parent) const
+{
+    auto job = new MockCollectionFetchJob(parent);
+    job->setCollections(m_collections);
+    return job;
+}
+
+MockItemFetchJob *DatasetGenerator::createItemFetchJob(const Akonadi::Collection &collection, QObject *parent) const
+{
+    auto job = new MockItemFetchJob(parent);
+    job->setItems(items(collection));
+    return job;
+}
+
+MockTagFetchJob *DatasetGenerator::createTagFetchJob(QObject *parent) const
+{
+    auto job = new MockTagFetchJob(parent);
+    job->setTags(tags());
+    return job;
+}
+
+static void writeKnutCollection(QXmlStreamWriter &writer,
+                                const Akonadi::Collection &collection,
+                                const QHash<Akonadi::Collection::Id, Akonadi::Collection::List> &childCollections,
+                                const QHash<Akonadi::Collection::Id, Akonadi::Item::List> &items)
+{
+    writer.writeStartElement("collection");
+    writer.writeAttribute("content", collection.contentMimeTypes().join(","));
+    writer.writeAttribute("rid", collection.remoteId());
+    writer.writeAttribute("name", collection.name());
+
+    writer.writeStartElement("attribute");
+    writer.writeAttribute("type", "AccessRights");
+    writer.writeCharacters("a");
+    writer.writeEndElement();
+    foreach (const Akonadi::Attribute *attribute, collection.attributes()) {
+        writer.writeStartElement("attribute");
+        writer.writeAttribute("type", QString::fromUtf8(attribute->type()));
+        writer.writeCharacters(QString::fromUtf8(attribute->serialized()));
+        writer.writeEndElement();
+    }
+
+    KCalCore::ICalFormat format;
+    foreach (const Akonadi::Item &item, items.value(collection.id())) {
+        writer.writeStartElement("item");
+        writer.writeAttribute("mimetype", item.mimeType());
+        writer.writeAttribute("rid", item.remoteId());
+
+        if (item.hasPayload<KCalCore::Todo::Ptr>())
+            writer.writeTextElement("payload", format.toICalString(item.payload<KCalCore::Todo::Ptr>()));
+        else if (item.hasPayload<KMime::Message::Ptr>())
+            writer.writeTextElement("payload", QString::fromUtf8(item.payload<KMime::Message::Ptr>()->encodedContent()));
+
+        foreach (const Akonadi::Tag &tag, item.tags())
+            writer.writeTextElement("tag", QString::fromUtf8(tag.remoteId()));
+
+        writer.writeEndElement();
+    }
+
+    foreach (const Akonadi::Collection &child, childCollections.value(collection.id()))
+        writeKnutCollection(writer, child, childCollections, items);
+
+    writer.writeEndElement();
+}
+
+QByteArray DatasetGenerator::toKnutXml() const
+{
+    QHash<Akonadi::Collection::Id, Akonadi::Collection::List> childCollections;
+    foreach (const Akonadi::Collection &collection, m_collections)
+        childCollections[collection.parentCollection().id()] << collection;
+
+    QByteArray data;
+    QXmlStreamWriter writer(&data);
+    writer.setAutoFormatting(true);
+    writer.writeStartElement("knut");
+
+    writeKnutCollection(writer, m_root, childCollections, m_itemsForCollection);
+
+    foreach (const Akonadi::Tag &tag, tags()) {
+        writer.writeEmptyElement("tag");
+        writer.writeAttribute("name", tag.name());
+        writer.writeAttribute("type", QString::fromUtf8(tag.type()));
+        writer.writeAttribute("gid", QString::fromUtf8(tag.gid()));
+        writer.writeAttribute("rid", QString::fromUtf8(tag.remoteId()));
+    }
+
+    writer.writeEndElement();
+    return data;
+}
+
+static bool writeFile(const QString &fileName, const QByteArray &content)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    return file.write(content) == content.size();
+}
+
+bool DatasetGenerator::writeTestEnvironment(const QString &path) const
+{
+    QDir dir(path);
+    if (!dir.mkpath("config") || !dir.mkpath("data") || !dir.mkpath("kdehome/share/config"))
+        return false;
+
+    return writeFile(dir.filePath("config.xml"),
+                     "<config>\n"
+                     "  <kdehome>kdehome</kdehome>\n"
+                     "  <confighome>config</confighome>\n"
+                     "  <datahome>data</datahome>\n"
+                     "  <agent synchronize=\"true\">akonadi_knut_resource</agent>\n"
+                     "  <envvar name=\"AKONADI_DISABLE_AGENT_AUTOSTART\">true</envvar>\n"
+                     "</config>\n")
+        && writeFile(dir.filePath("kdehome/share/config/akonadi-firstrunrc"),
+                     "[ProcessedDefaults]\n"
+                     "defaultaddressbook=done\n"
+                     "defaultcalendar=done\n")
+        && writeFile(dir.filePath("kdehome/share/config/akonadi_knut_resource_0rc"),
+                     "[General]\n"
+                     "DataFile[$e]=$KDEHOME/testdata.xml\n")
+        && writeFile(dir.filePath("kdehome/share/config/kdedrc"),
+                     "[General]\n"
+                     "CheckSycoca=false\n"
+                     "CheckFileStamps=false\n")
+        && writeFile(dir.filePath("kdehome/testdata.xml"), toKnutXml());
+}
+
+void DatasetGenerator::generate()
+{
+    const QStringList folderMimeTypes = QStringList() << Akonadi::Collection::mimeType();
+    const QStringList taskMimeTypes = QStringList(folderMimeTypes) << KCalCore::Todo::todoMimeType();
+    const QStringList noteMimeTypes = QStringList(folderMimeTypes) << Akonadi::NoteUtils::noteMimeType();
+
+    m_root = createCollection("Zanshin generated data", Akonadi::Collection::root(), folderMimeTypes);
+    m_collections << m_root;
+
+    int noteCollectionCount = m_options.collectionCount / 2;
+    if (m_options.noteCount == 0)
+        noteCollectionCount = 0;
+    else if (m_options.todoCount == 0)
+        noteCollectionCount = m_options.collectionCount;
+
+    Akonadi::Collection::List taskCollections;
+    Akonadi::Collection::List noteCollections;
+    const int taskCollectionCount = m_options.collectionCount - noteCollectionCount;
+    // Each folder sits below the previous one until the chain is deep enough
+    const int folderDepth = qMax(1, m_options.folderDepth);
+    for (int i = 0; i < taskCollectionCount; i++) {
+        const auto parent = (i % folderDepth == 0) ? m_root : taskCollections.last();
+        auto collection = createCollection(QString("Tasks %1").arg(i + 1), parent, taskMimeTypes);
+        m_collections << collection;
+        taskCollections << collection;
+    }
+    for (int i = 0; i < noteCollectionCount; i++) {
+        const auto parent = (i % folderDepth == 0) ? m_root : noteCollections.last();
+        auto collection = createCollection(QString("Notes %1").arg(i + 1), parent, noteMimeTypes);
+        m_collections << collection;
+        noteCollections << collection;
+    }
+
+    if (m_options.otherUserCount > 0) {
+        auto otherUsers = createCollection("Other Users", m_root, folderMimeTypes);
+        m_collections << otherUsers;
+
+        for (int i = 0; i < m_options.otherUserCount; i++) {
+            const QByteArray name = "user" + QByteArray::number(i + 1);
+            auto person = createCollection(QString::fromUtf8(name), otherUsers, folderMimeTypes);
+            auto identification = person.attribute<CollectionIdentificationAttribute>(Akonadi::Entity::AddIfMissing);
+            identification->setIdentifier(name);
+            identification->setName(name);
+            identification->setCollectionNamespace("usertoplevel");
+            identification->setMail(name + "@example.com");
+            m_collections << person;
+
+            // Shared task folders get their share of todos like the others
+            auto collection = createCollection("Tasks", person, taskMimeTypes);
+            m_collections << collection;
+            taskCollections << collection;
+        }
+    }
+
+    for (int i = 0; i < m_options.contextCount; i++)
+        m_contexts << createTag(QString("Context %1").arg(i + 1), Akonadi::SerializerInterface::contextTagType());
+    for (int i = 0; i < m_options.tagCount; i++)
+        m_tags << createTag(QString("Tag %1").arg(i + 1), Akonadi::Tag::PLAIN);
+
+    createTodos(taskCollections);
+    createNotes(noteCollections);
+}
+
+Akonadi::Collection DatasetGenerator::createCollection(const QString &name, const Akonadi::Collection &parent,
+                                                       const QStringList &mimeTypes)
+{
+    Akonadi::Collection collection(m_collections.size() + 1);
+    collection.setName(name);
+    collection.setRemoteId(QString("collection-%1").arg(collection.id()));
+    collection.setParentCollection(parent);
+    collection.setContentMimeTypes(mimeTypes);
+    collection.setEnabled(true);
+    return collection;
+}
+
+Akonadi::Tag DatasetGenerator::createTag(const QString &name, const QByteArray &type)
+{
+    const QByteArray gid = "tag-" + QByteArray::number(m_contexts.size() + m_tags.size() + 1);
+
+    Akonadi::Tag tag(name);
+    tag.setId(m_contexts.size() + m_tags.size() + 1);
+    tag.setType(type);
+    tag.setGid(gid);
+    tag.setRemoteId(gid);
+    return tag;
+}
+
+void DatasetGenerator::createTodos(const Akonadi::Collection::List &taskCollections)
+{
+    if (taskCollections.isEmpty())
+        return;
+
+    const QDate reference(2014, 1, 1);
+
+    // Projects first, spread over the task folders
+    QHash<Akonadi::Collection::Id, QStringList> projectsForCollection;
+    const int projectCount = qMin(m_options.projectCount, m_options.todoCount);
+    for (int i = 0; i < projectCount; i++) {
+        const auto collection = taskCollections.at(i % taskCollections.size());
+
+        KCalCore::Todo::Ptr todo(new KCalCore::Todo);
+        todo->setUid(QString("project-%1").arg(i + 1));
+        todo->setSummary(QString("Project %1").arg(i + 1));
+        todo->setCustomProperty("Zanshin", "Project", "1");
+
+        auto item = createItem(collection, KCalCore::Todo::todoMimeType());
+        item.setRemoteId(todo->uid());
+        item.setPayload<KCalCore::Todo::Ptr>(todo);
+        m_items << item;
+        m_itemsForCollection[collection.id()] << item;
+
+        projectsForCollection[collection.id()] << todo->uid();
+        m_projectUids << todo->uid();
+    }
+
+    // Then the tasks, in each folder they form chains going down to the
+    // requested depth, top level tasks being sometimes in a project
+    QHash<Akonadi::Collection::Id, QStringList> chainForCollection;
+    const int taskCount = m_options.todoCount - projectCount;
+    for (int i = 0; i < taskCount; i++) {
+        const auto collection = taskCollections.at(i % taskCollections.size());
+        const int depth = (i / taskCollections.size()) % (m_options.subtaskDepth + 1);
+        auto &chain = chainForCollection[collection.id()];
+
+        KCalCore::Todo::Ptr todo(new KCalCore::Todo);
+        todo->setUid(QString("task-%1").arg(i + 1));
+        todo->setSummary(QString("Task %1").arg(i + 1));
+        todo->setDescription(QString("Description of the task %1, long enough to look like a real one "
+                                     "with a couple of sentences in it.").arg(i + 1));
+
+        if (depth == 0) {
+            chain.clear();
+            const auto projects = projectsForCollection.value(collection.id());
+            if (!projects.isEmpty() && random(3) == 0)
+                todo->setRelatedTo(projects.at(random(projects.size())));
+        } else {
+            todo->setRelatedTo(chain.last());
+        }
+        chain << todo->uid();
+
+        if (random(2) == 0)
+            todo->setDtStart(KDateTime(reference.addDays(random(365))));
+        if (random(2) == 0)
+            todo->setDtDue(KDateTime(reference.addDays(random(365))));
+        if (random(5) == 0)
+            todo->setCompleted(true);
+        else
+            todo->setPercentComplete(random(10) * 10);
+
+        if (random(100) < m_options.recurrencePercent) {
+            if (!todo->dtStart().isValid())
+                todo->setDtStart(KDateTime(reference.addDays(random(365))));
+
+            switch (random(3)) {
+            case 0:
+                todo->recurrence()->setDaily(1 + random(3));
+                break;
+            case 1:
+                todo->recurrence()->setWeekly(1 + random(3));
+                break;
+            default:
+                todo->recurrence()->setMonthly(1);
+                break;
+            }
+        }
+
+        if (random(100) < m_options.delegationPercent) {
+            const int delegate = random(20) + 1;
+            todo->addAttendee(KCalCore::Attendee::Ptr(new KCalCore::Attendee(QString("Delegate %1").arg(delegate),
+                                                                              QString("delegate%1@example.com").arg(delegate),
+                                                                              true, KCalCore::Attendee::Delegated)));
+        }
+
+        auto item = createItem(collection, KCalCore::Todo::todoMimeType());
+        item.setRemoteId(todo->uid());
+        item.setPayload<KCalCore::Todo::Ptr>(todo);
+
+        Akonadi::Tag::List tags;
+        if (!m_contexts.isEmpty() && random(3) == 0)
+            tags << m_contexts.at(random(m_contexts.size()));
+        if (!m_tags.isEmpty() && random(4) == 0)
+            tags << m_tags.at(random(m_tags.size()));
+        item.setTags(tags);
+
+        m_items << item;
+        m_itemsForCollection[collection.id()] << item;
+    }
+}
+
+void DatasetGenerator::createNotes(const Akonadi::Collection::List &noteCollections)
+{
+    if (noteCollections.isEmpty())
+        return;
+
+    for (int i = 0; i < m_options.noteCount; i++) {
+        const auto collection = noteCollections.at(i % noteCollections.size());
+
+        KMime::Message::Ptr message(new KMime::Message);
+        message->subject(true)->fromUnicodeString(QString("Note %1").arg(i + 1), "utf-8");
+        message->contentType(true)->setMimeType("text/plain");
+        message->contentType()->setCharset("utf-8");
+        message->mainBodyPart()->fromUnicodeString(QString("Content of the note %1.\n"
+                                                           "It spans a few lines,\n"
+                                                           "like the ones people keep around.").arg(i + 1));
+
+        if (!m_projectUids.isEmpty() && random(4) == 0) {
+            auto relatedHeader = new KMime::Headers::Generic("X-Zanshin-RelatedProjectUid");
+            relatedHeader->from7BitString(m_projectUids.at(random(m_projectUids.size())).toUtf8());
+            message->appendHeader(relatedHeader);
+        }
+        message->assemble();
+
+        auto item = createItem(collection, Akonadi::NoteUtils::noteMimeType());
+        item.setRemoteId(QString("note-%1").arg(i + 1));
+        item.setPayload<KMime::Message::Ptr>(message);
+
+        if (!m_tags.isEmpty() && random(4) == 0)
+            item.setTags(Akonadi::Tag::List() << m_tags.at(random(m_tags.size())));
+
+        m_items << item;
+        m_itemsForCollection[collection.id()] << item;
+    }
+}
+
+Akonadi::Item DatasetGenerator::createItem(const Akonadi::Collection &collection, const QString &mimeType)
+{
+    Akonadi::Item item(m_items.size() + 1);
+    item.setMimeType(mimeType);
+    item.setParentCollection(collection);
+    return item;
+}
+
+int DatasetGenerator::random(int max)
+{
+    // Own generator so that the data doesn't depend on the qrand() state
+    m_randomState = m_randomState * 1103515245 + 12345;
+    return (m_randomState >> 16) % max;
+}
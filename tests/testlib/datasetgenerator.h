@@ -0,0 +1,110 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#ifndef ZANSHIN_TESTLIB_DATASETGENERATOR_H
+#define ZANSHIN_TESTLIB_DATASETGENERATOR_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+#include <Akonadi/Collection>
+#include <Akonadi/Item>
+#include <Akonadi/Tag>
+
+class MockCollectionFetchJob;
+class MockItemFetchJob;
+class MockTagFetchJob;
+class QObject;
+
+namespace TestLib {
+
+// Builds a synthetic store shaped like a Kolab account, the same options
+// and seed always give the same data
+class DatasetGenerator
+{
+public:
+    struct Options
+    {
+        Options();
+
+        int collectionCount;   // Task and note folders, split half and half
+        int folderDepth;       // Length of the folder chains they form below the root
+        int todoCount;         // Includes the projects
+        int noteCount;
+        int subtaskDepth;      // Length of the subtask chains below top level tasks
+        int projectCount;
+        int contextCount;
+        int tagCount;
+        int recurrencePercent; // Share of the tasks which recur
+        int delegationPercent; // Share of the tasks delegated to someone
+        int otherUserCount;    // Person folders below "Other Users", each with a task folder
+        uint seed;
+    };
+
+    explicit DatasetGenerator(const Options &options = Options());
+
+    Options options() const;
+
+    Akonadi::Collection rootCollection() const;
+    Akonadi::Collection::List collections() const;
+    Akonadi::Item::List items() const;
+    Akonadi::Item::List items(const Akonadi::Collection &collection) const;
+    Akonadi::Tag::List tags() const;
+
+    // Fixtures ready to be returned by a storage mock
+    MockCollectionFetchJob *createCollectionFetchJob(QObject *parent = 0) const;
+    MockItemFetchJob *createItemFetchJob(const Akonadi::Collection &collection, QObject *parent = 0) const;
+    MockTagFetchJob *createTagFetchJob(QObject *parent = 0) const;
+
+    // Data file for the knut resource, and a whole environment for akonaditest
+    // using it, laid out like tests/features/testenv
+    QByteArray toKnutXml() const;
+    bool writeTestEnvironment(const QString &path) const;
+
+private:
+    void generate();
+    Akonadi::Collection createCollection(const QString &name, const Akonadi::Collection &parent,
+                                         const QStringList &mimeTypes);
+    Akonadi::Tag createTag(const QString &name, const QByteArray &type);
+    void createTodos(const Akonadi::Collection::List &taskCollections);
+    void createNotes(const Akonadi::Collection::List &noteCollections);
+    Akonadi::Item createItem(const Akonadi::Collection &collection, const QString &mimeType);
+    int random(int max);
+
+    Options m_options;
+    quint32 m_randomState;
+
+    Akonadi::Collection m_root;
+    Akonadi::Collection::List m_collections;
+    Akonadi::Item::List m_items;
+    QHash<Akonadi::Collection::Id, Akonadi::Item::List> m_itemsForCollection;
+    Akonadi::Tag::List m_contexts;
+    Akonadi::Tag::List m_tags;
+    QStringList m_projectUids;
+};
+
+}
+
+#endif // ZANSHIN_TESTLIB_DATASETGENERATOR_H
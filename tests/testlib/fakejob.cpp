@@ -28,6 +28,7 @@
 FakeJob::FakeJob(QObject *parent)
     : KJob(parent)
     , m_launched(false)
+    , m_killed(false)
 {
     setAutoDelete(true);
 }
@@ -40,7 +41,14 @@ void FakeJob::start()
     }
 }
 
+bool FakeJob::doKill()
+{
+    m_killed = true;
+    return true;
+}
+
 void FakeJob::onTimeout()
 {
-    emitResult();
+    if (!m_killed)
+        emitResult();
 }
@@ -33,10 +33,14 @@ public:
 
     void start();
 
+protected:
+    bool doKill();
+
 private slots:
     void onTimeout();
 
 private:
     bool m_launched;
+    bool m_killed;
 };
 
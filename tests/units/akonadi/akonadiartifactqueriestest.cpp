@@ -92,10 +92,10 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::isSelectedCollection).when(col2).thenReturn(true);
         serializerMock(&Akonadi::SerializerInterface::isSelectedCollection).when(col3).thenReturn(false);
 
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).thenReturn(Domain::Task::Ptr());
-        serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item1).thenReturn(note);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).thenReturn(task1);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item3).thenReturn(task2);
+        serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item1)
+                                                                               .thenReturn(Domain::Artifact::List() << note);
+        serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item2 << item3)
+                                                                               .thenReturn(Domain::Artifact::List() << task1 << task2);
 
         serializerMock(&Akonadi::SerializerInterface::relatedUidFromItem).when(item1).thenReturn(QString());
         serializerMock(&Akonadi::SerializerInterface::relatedUidFromItem).when(item2).thenReturn(QString());
@@ -133,9 +133,8 @@ private slots:
                                                                          .exactly(1));
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col1).exactly(1));
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col2).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item1).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item3).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item1).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item2 << item3).exactly(1));
 
         QCOMPARE(result->data().size(), 3);
         QCOMPARE(result->data().at(0).dynamicCast<Domain::Note>(), note);
@@ -178,7 +177,8 @@ private slots:
         mock_object<Akonadi::SerializerInterface> serializerMock;
         serializerMock(&Akonadi::SerializerInterface::isSelectedCollection).when(col).thenReturn(true);
 
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).thenReturn(task1);
+        serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item1)
+                                                                               .thenReturn(Domain::Artifact::List() << task1);
         serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).thenReturn(task2);
         serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item2).thenReturn(note2);
 
@@ -210,7 +210,7 @@ private slots:
                                                                                Akonadi::StorageInterface::Tasks|Akonadi::StorageInterface::Notes)
                                                                          .exactly(1));
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item1).exactly(1));
         QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).exactly(0));
         QVERIFY(serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item2).exactly(0));
 
@@ -260,7 +260,8 @@ private slots:
         mock_object<Akonadi::SerializerInterface> serializerMock;
         serializerMock(&Akonadi::SerializerInterface::isSelectedCollection).when(col).thenReturn(true);
 
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).thenReturn(task1);
+        serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item1)
+                                                                               .thenReturn(Domain::Artifact::List() << task1);
         serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).thenReturn(task2);
         serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item3).thenReturn(Domain::Task::Ptr());
         serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item3).thenReturn(note3);
@@ -298,7 +299,7 @@ private slots:
                                                                                Akonadi::StorageInterface::Tasks|Akonadi::StorageInterface::Notes)
                                                                          .exactly(1));
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item1).exactly(1));
         QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).exactly(0));
         QVERIFY(serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item3).exactly(0));
 
@@ -363,8 +364,8 @@ private slots:
         mock_object<Akonadi::SerializerInterface> serializerMock;
         serializerMock(&Akonadi::SerializerInterface::isSelectedCollection).when(col).thenReturn(true);
 
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item).thenReturn(artifact.dynamicCast<Domain::Task>());
-        serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item).thenReturn(artifact.dynamicCast<Domain::Note>());
+        serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item)
+                                                                               .thenReturn(Domain::Artifact::List() << artifact);
 
         serializerMock(&Akonadi::SerializerInterface::relatedUidFromItem).when(item).thenReturn(QString());
         serializerMock(&Akonadi::SerializerInterface::hasContextTags).when(item).thenReturn(hasContexts);
@@ -464,6 +465,7 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::hasAkonadiTags).when(item).thenReturn(hasTags);
 
         monitor->addItem(item);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(serializerMock(&Akonadi::SerializerInterface::relatedUidFromItem).when(item).exactly(1));
@@ -512,7 +514,8 @@ private slots:
 
         serializerMock(&Akonadi::SerializerInterface::isTaskItem).when(item).thenReturn(true);
         serializerMock(&Akonadi::SerializerInterface::isNoteItem).when(item).thenReturn(false);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item).thenReturn(task);
+        serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item)
+                                                                               .thenReturn(Domain::Artifact::List() << task);
         serializerMock(&Akonadi::SerializerInterface::relatedUidFromItem).when(item).thenReturn(QString());
         serializerMock(&Akonadi::SerializerInterface::hasContextTags).when(item).thenReturn(false);
         serializerMock(&Akonadi::SerializerInterface::hasAkonadiTags).when(item).thenReturn(false);
@@ -531,6 +534,7 @@ private slots:
 
         // WHEN
         monitor->removeItem(item);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(result->data().isEmpty());
@@ -599,6 +603,8 @@ private slots:
 
         serializerMock(&Akonadi::SerializerInterface::isTaskItem).when(item).thenReturn(!artifact.dynamicCast<Domain::Task>().isNull());
         serializerMock(&Akonadi::SerializerInterface::isNoteItem).when(item).thenReturn(!artifact.dynamicCast<Domain::Note>().isNull());
+        serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item)
+                                                                               .thenReturn(Domain::Artifact::List() << artifact);
         serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item).thenReturn(artifact.dynamicCast<Domain::Task>());
         serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item).thenReturn(artifact.dynamicCast<Domain::Note>());
         serializerMock(&Akonadi::SerializerInterface::updateTaskFromItem).when(artifact.dynamicCast<Domain::Task>(), item).thenReturn();
@@ -627,6 +633,7 @@ private slots:
 
         // WHEN
         monitor->changeItem(item);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item).atMost(1));
@@ -695,14 +702,16 @@ private slots:
 
         serializerMock(&Akonadi::SerializerInterface::isTaskItem).when(item1).thenReturn(true);
         serializerMock(&Akonadi::SerializerInterface::isNoteItem).when(item1).thenReturn(false);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).thenReturn(task1);
+        serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item1)
+                                                                               .thenReturn(Domain::Artifact::List() << task1);
         serializerMock(&Akonadi::SerializerInterface::relatedUidFromItem).when(item1).thenReturn(QString());
         serializerMock(&Akonadi::SerializerInterface::hasContextTags).when(item1).thenReturn(false);
         serializerMock(&Akonadi::SerializerInterface::hasAkonadiTags).when(item1).thenReturn(false);
 
         serializerMock(&Akonadi::SerializerInterface::isTaskItem).when(item2).thenReturn(true);
         serializerMock(&Akonadi::SerializerInterface::isNoteItem).when(item2).thenReturn(false);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).thenReturn(task2);
+        serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item2)
+                                                                               .thenReturn(Domain::Artifact::List() << task2);
         serializerMock(&Akonadi::SerializerInterface::relatedUidFromItem).when(item2).thenReturn(QString());
         serializerMock(&Akonadi::SerializerInterface::hasContextTags).when(item2).thenReturn(false);
         serializerMock(&Akonadi::SerializerInterface::hasAkonadiTags).when(item2).thenReturn(false);
@@ -0,0 +1,393 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#include <QtTest>
+
+#include <Akonadi/Tag>
+
+#include "testlib/akonadimocks.h"
+
+#include "akonadi/akonadicache.h"
+#include "akonadi/akonadiitemfetchjobinterface.h"
+
+class AkonadiCacheTest : public QObject
+{
+    Q_OBJECT
+private:
+    Akonadi::Item createItem(Akonadi::Item::Id id, const Akonadi::Collection &collection, const QString &remoteId = QString())
+    {
+        Akonadi::Item item(id);
+        item.setParentCollection(collection);
+        item.setRemoteId(remoteId);
+        return item;
+    }
+
+    QList<Akonadi::Item::Id> ids(const Akonadi::Item::List &items)
+    {
+        QList<Akonadi::Item::Id> result;
+        for (const auto &item : items)
+            result << item.id();
+        return result;
+    }
+
+    Akonadi::Collection createCollection(Akonadi::Collection::Id id, const Akonadi::Collection &parent,
+                                         const QString &mimeType = QString("application/x-vnd.akonadi.calendar.todo"))
+    {
+        Akonadi::Collection collection(id);
+        collection.setParentCollection(parent);
+        collection.setName(QString::number(id));
+        collection.setContentMimeTypes(QStringList() << mimeType);
+        return collection;
+    }
+
+    QList<Akonadi::Collection::Id> ids(const Akonadi::Collection::List &collections)
+    {
+        QList<Akonadi::Collection::Id> result;
+        for (const auto &collection : collections)
+            result << collection.id();
+        return result;
+    }
+
+private slots:
+    void shouldNotKnowCollectionsBeforePopulation()
+    {
+        // GIVEN
+        MockMonitor monitor;
+        Akonadi::Cache cache(&monitor);
+        Akonadi::Collection col(42);
+
+        // WHEN
+        monitor.addItem(createItem(1, col));
+
+        // THEN
+        QVERIFY(!cache.isCollectionPopulated(col.id()));
+        QVERIFY(cache.items(col).isEmpty());
+    }
+
+    void shouldServePopulatedCollections()
+    {
+        // GIVEN
+        MockMonitor monitor;
+        Akonadi::Cache cache(&monitor);
+        Akonadi::Collection col1(42);
+        Akonadi::Collection col2(43);
+
+        // WHEN
+        cache.populateCollection(col1, Akonadi::Item::List() << createItem(1, col1) << createItem(2, col1));
+        cache.populateCollection(col2, Akonadi::Item::List());
+
+        // THEN
+        QVERIFY(cache.isCollectionPopulated(col1.id()));
+        QVERIFY(cache.isCollectionPopulated(col2.id()));
+        QCOMPARE(ids(cache.items(col1)), QList<Akonadi::Item::Id>() << 1 << 2);
+        QVERIFY(cache.items(col2).isEmpty());
+    }
+
+    void shouldFollowMonitorChanges()
+    {
+        // GIVEN
+        MockMonitor monitor;
+        Akonadi::Cache cache(&monitor);
+        Akonadi::Collection col1(42);
+        Akonadi::Collection col2(43);
+        Akonadi::Collection col3(44);
+        cache.populateCollection(col1, Akonadi::Item::List() << createItem(1, col1) << createItem(2, col1));
+        cache.populateCollection(col2, Akonadi::Item::List() << createItem(3, col2));
+
+        // WHEN
+        monitor.addItem(createItem(4, col1));
+        monitor.addItem(createItem(5, col3));
+        monitor.changeItem(createItem(2, col1, "changed"));
+        monitor.removeItem(createItem(1, col1));
+        monitor.moveItem(createItem(3, col1));
+
+        // THEN
+        QCOMPARE(ids(cache.items(col1)), QList<Akonadi::Item::Id>() << 2 << 4 << 3);
+        QVERIFY(cache.items(col2).isEmpty());
+        QVERIFY(!cache.isCollectionPopulated(col3.id()));
+        QCOMPARE(cache.items(col1).first().remoteId(), QString("changed"));
+
+        // WHEN
+        monitor.removeCollection(col1);
+
+        // THEN
+        QVERIFY(!cache.isCollectionPopulated(col1.id()));
+        QVERIFY(cache.isCollectionPopulated(col2.id()));
+    }
+
+    void shouldReplayChangesNotifiedDuringFetch()
+    {
+        // GIVEN
+        MockMonitor monitor;
+        Akonadi::Cache cache(&monitor);
+        Akonadi::Collection col1(42);
+        Akonadi::Collection col2(43);
+        cache.populateCollection(col2, Akonadi::Item::List() << createItem(5, col2));
+
+        // Changes seen before the fetch are older than its result
+        monitor.changeItem(createItem(1, col1, "too old"));
+
+        // WHEN
+        cache.beginCollectionFetch(col1.id());
+        monitor.addItem(createItem(4, col1));
+        monitor.changeItem(createItem(2, col1, "changed"));
+        monitor.removeItem(createItem(3, col1));
+        monitor.moveItem(createItem(1, col2));
+        cache.populateCollection(col1, Akonadi::Item::List() << createItem(1, col1, "fetched")
+                                                             << createItem(2, col1, "fetched")
+                                                             << createItem(3, col1, "fetched"));
+
+        // THEN
+        QCOMPARE(ids(cache.items(col1)), QList<Akonadi::Item::Id>() << 2 << 4);
+        QCOMPARE(cache.items(col1).first().remoteId(), QString("changed"));
+        QCOMPARE(ids(cache.items(col2)), QList<Akonadi::Item::Id>() << 5 << 1);
+
+        // WHEN
+        cache.beginCollectionFetch(col1.id());
+        monitor.changeItem(createItem(2, col1, "changed again"));
+        cache.abortCollectionFetch(col1.id());
+        cache.populateCollection(col1, Akonadi::Item::List() << createItem(2, col1, "fetched"));
+
+        // THEN
+        QCOMPARE(ids(cache.items(col1)), QList<Akonadi::Item::Id>() << 2);
+        QCOMPARE(cache.items(col1).first().remoteId(), QString("fetched"));
+    }
+
+    void shouldShareRunningCollectionFetches()
+    {
+        // GIVEN
+        MockMonitor monitor;
+        Akonadi::Cache cache(&monitor);
+        Akonadi::Collection col(42);
+
+        int startedFetches = 0;
+        auto starter = [&] () -> Akonadi::ItemFetchJobInterface* {
+            startedFetches++;
+            auto job = new MockItemFetchJob;
+            job->setItems(Akonadi::Item::List() << createItem(1, col) << createItem(2, col));
+            return job;
+        };
+
+        // WHEN
+        auto job1 = cache.joinCollectionFetch(col.id(), starter);
+        auto job2 = cache.joinCollectionFetch(col.id(), starter);
+        Akonadi::Item::List received1;
+        Akonadi::Item::List received2;
+        job1->installItemsReceivedHandler([&] (const Akonadi::Item::List &items) { received1 << items; });
+        job2->installItemsReceivedHandler([&] (const Akonadi::Item::List &items) { received2 << items; });
+        QSignalSpy spy1(job1->kjob(), SIGNAL(result(KJob*)));
+        QSignalSpy spy2(job2->kjob(), SIGNAL(result(KJob*)));
+        QTest::qWait(150);
+
+        // THEN
+        QCOMPARE(startedFetches, 1);
+        QCOMPARE(spy1.count(), 1);
+        QCOMPARE(spy2.count(), 1);
+        QCOMPARE(ids(received1), QList<Akonadi::Item::Id>() << 1 << 2);
+        QCOMPARE(ids(received2), QList<Akonadi::Item::Id>() << 1 << 2);
+
+        // WHEN
+        auto job3 = cache.joinCollectionFetch(col.id(), starter);
+        auto job4 = cache.joinCollectionFetch(col.id(), starter);
+        Akonadi::Item::List received4;
+        job4->installItemsReceivedHandler([&] (const Akonadi::Item::List &items) { received4 << items; });
+        QSignalSpy spy4(job4->kjob(), SIGNAL(result(KJob*)));
+        job3->kjob()->kill(KJob::EmitResult);
+        QTest::qWait(150);
+
+        // THEN
+        // The previous fetch is over, cancelling one of the waiters leaves the other one served
+        QCOMPARE(startedFetches, 2);
+        QCOMPARE(spy4.count(), 1);
+        QCOMPARE(ids(received4), QList<Akonadi::Item::Id>() << 1 << 2);
+    }
+
+    void shouldOnlyLetThroughItemsOfWatchedCollectionsOrTagged()
+    {
+        // GIVEN
+        MockMonitor monitor;
+        auto cache = new Akonadi::Cache(&monitor);
+        Akonadi::Collection watched(42);
+        Akonadi::Collection other(43);
+        cache->watchCollection(watched.id());
+
+        auto taggedItem = createItem(3, other);
+        taggedItem.setTags(Akonadi::Tag::List() << Akonadi::Tag(1));
+
+        // WHEN
+        auto filter = cache->itemFilter();
+
+        // THEN
+        QVERIFY(filter(createItem(1, watched)));
+        QVERIFY(!filter(createItem(2, other)));
+        QVERIFY(filter(taggedItem));
+
+        // WHEN
+        delete cache;
+
+        // THEN
+        QVERIFY(filter(createItem(2, other)));
+    }
+
+    void shouldServePopulatedCollectionTrees()
+    {
+        // GIVEN
+        MockMonitor monitor;
+        Akonadi::Cache cache(&monitor);
+        const QStringList tasks = QStringList() << "application/x-vnd.akonadi.calendar.todo";
+        const QStringList notes = QStringList() << "text/x-vnd.akonadi.note";
+
+        // A resource with two calendars, one nested in the other, and notes
+        Akonadi::Collection resource = createCollection(41, Akonadi::Collection::root(), "inode/directory");
+        Akonadi::Collection cal1 = createCollection(42, resource);
+        Akonadi::Collection cal2 = createCollection(43, cal1);
+        Akonadi::Collection notesCol = createCollection(44, resource, notes.first());
+
+        // WHEN
+        cache.populateCollectionTree(tasks, Akonadi::Cache::DisplayedCollections,
+                                     Akonadi::Collection::List() << cal1 << cal2);
+
+        // THEN
+        QVERIFY(cache.isCollectionTreePopulated(tasks, Akonadi::Cache::DisplayedCollections));
+        QVERIFY(!cache.isCollectionTreePopulated(tasks, Akonadi::Cache::AllCollections));
+        QVERIFY(!cache.isCollectionTreePopulated(notes, Akonadi::Cache::DisplayedCollections));
+
+        auto collections = cache.collections(Akonadi::Collection::root(), true,
+                                             tasks, Akonadi::Cache::DisplayedCollections);
+        QCOMPARE(ids(collections), QList<Akonadi::Collection::Id>() << 42 << 43);
+        QCOMPARE(collections.last().parentCollection().name(), QString("42"));
+        QCOMPARE(collections.last().parentCollection().parentCollection().name(), QString("41"));
+        QVERIFY(collections.last().parentCollection().parentCollection().parentCollection() == Akonadi::Collection::root());
+
+        collections = cache.collections(resource, false, tasks, Akonadi::Cache::DisplayedCollections);
+        QCOMPARE(ids(collections), QList<Akonadi::Collection::Id>() << 42);
+
+        collections = cache.collections(cal1, true, tasks, Akonadi::Cache::DisplayedCollections);
+        QCOMPARE(ids(collections), QList<Akonadi::Collection::Id>() << 43);
+
+        // WHEN
+        monitor.addCollection(notesCol);
+
+        // THEN
+        collections = cache.collections(Akonadi::Collection::root(), true,
+                                        tasks, Akonadi::Cache::DisplayedCollections);
+        QCOMPARE(ids(collections), QList<Akonadi::Collection::Id>() << 42 << 43);
+    }
+
+    void shouldFollowMonitorCollectionChanges()
+    {
+        // GIVEN
+        MockMonitor monitor;
+        Akonadi::Cache cache(&monitor);
+        const QStringList tasks = QStringList() << "application/x-vnd.akonadi.calendar.todo";
+
+        Akonadi::Collection cal1 = createCollection(42, Akonadi::Collection::root());
+        Akonadi::Collection cal2 = createCollection(43, cal1);
+        Akonadi::Collection cal3 = createCollection(44, Akonadi::Collection::root());
+        cache.populateCollectionTree(tasks, Akonadi::Cache::DisplayedCollections,
+                                     Akonadi::Collection::List() << cal1 << cal2);
+
+        // WHEN
+        monitor.addCollection(cal3);
+        cal2.setName("changed");
+        monitor.changeCollection(cal2);
+
+        // THEN
+        auto collections = cache.collections(Akonadi::Collection::root(), true,
+                                             tasks, Akonadi::Cache::DisplayedCollections);
+        QCOMPARE(ids(collections), QList<Akonadi::Collection::Id>() << 42 << 43 << 44);
+        QCOMPARE(collections.at(1).name(), QString("changed"));
+
+        // WHEN
+        cal1.setEnabled(false);
+        monitor.changeCollection(cal1);
+
+        // THEN
+        collections = cache.collections(Akonadi::Collection::root(), true,
+                                        tasks, Akonadi::Cache::DisplayedCollections);
+        QCOMPARE(ids(collections), QList<Akonadi::Collection::Id>() << 44);
+        collections = cache.collections(Akonadi::Collection::root(), true,
+                                        tasks, Akonadi::Cache::AllCollections);
+        QCOMPARE(ids(collections), QList<Akonadi::Collection::Id>() << 42 << 43 << 44);
+
+        // WHEN
+        cal1.setReferenced(true);
+        monitor.changeCollection(cal1);
+
+        // THEN
+        collections = cache.collections(Akonadi::Collection::root(), true,
+                                        tasks, Akonadi::Cache::DisplayedCollections);
+        QCOMPARE(ids(collections), QList<Akonadi::Collection::Id>() << 42 << 43 << 44);
+
+        // WHEN
+        monitor.removeCollection(cal1);
+
+        // THEN
+        collections = cache.collections(Akonadi::Collection::root(), true,
+                                        tasks, Akonadi::Cache::DisplayedCollections);
+        QCOMPARE(ids(collections), QList<Akonadi::Collection::Id>() << 44);
+    }
+
+    void shouldFollowMovesAndMimeTypeChanges()
+    {
+        // GIVEN
+        MockMonitor monitor;
+        Akonadi::Cache cache(&monitor);
+        const QStringList tasks = QStringList() << "application/x-vnd.akonadi.calendar.todo";
+
+        Akonadi::Collection cal1 = createCollection(42, Akonadi::Collection::root());
+        Akonadi::Collection cal2 = createCollection(43, cal1);
+        Akonadi::Collection cal3 = createCollection(44, Akonadi::Collection::root());
+        cache.populateCollectionTree(tasks, Akonadi::Cache::DisplayedCollections,
+                                     Akonadi::Collection::List() << cal1 << cal2 << cal3);
+
+        // WHEN
+        cal2.setParentCollection(cal3);
+        monitor.changeCollection(cal2);
+
+        // THEN
+        auto collections = cache.collections(cal1, true, tasks, Akonadi::Cache::DisplayedCollections);
+        QVERIFY(collections.isEmpty());
+        collections = cache.collections(cal3, true, tasks, Akonadi::Cache::DisplayedCollections);
+        QCOMPARE(ids(collections), QList<Akonadi::Collection::Id>() << 43);
+
+        // WHEN
+        cal1.setContentMimeTypes(QStringList() << "text/x-vnd.akonadi.note");
+        monitor.changeCollection(cal1);
+
+        // THEN
+        collections = cache.collections(Akonadi::Collection::root(), true,
+                                        tasks, Akonadi::Cache::DisplayedCollections);
+        QCOMPARE(ids(collections), QList<Akonadi::Collection::Id>() << 43 << 44);
+
+        // WHEN
+        monitor.changeCollection(createCollection(45, Akonadi::Collection(99)));
+
+        // THEN
+        QVERIFY(!cache.isCollectionTreePopulated(tasks, Akonadi::Cache::DisplayedCollections));
+    }
+};
+
+QTEST_MAIN(AkonadiCacheTest)
+
+#include "akonadicachetest.moc"
@@ -208,6 +208,7 @@ private slots:
 
         monitor->addTag(tag1);
         monitor->addTag(tag2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchTags).when().exactly(1));
@@ -264,6 +265,7 @@ private slots:
 
         // WHEN
         monitor->removeTag(tag2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchTags).when().exactly(1));
@@ -320,6 +322,7 @@ private slots:
         // WHEN
         tag2.setName("newContext43");
         monitor->changeTag(tag2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchTags).when().exactly(1));
@@ -358,8 +361,8 @@ private slots:
         // Serializer mock returning the objects from the items
         mock_object<Akonadi::SerializerInterface> serializerMock;
         serializerMock(&Akonadi::SerializerInterface::createTagFromContext).when(context).thenReturn(tag);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).thenReturn(task1);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).thenReturn(task2);
+        serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1 << item2)
+                                                                           .thenReturn(Domain::Task::List() << task1 << task2);
         serializerMock(&Akonadi::SerializerInterface::isContextChild).when(context, item1).thenReturn(true);
         serializerMock(&Akonadi::SerializerInterface::isContextChild).when(context, item2).thenReturn(true);
 
@@ -431,6 +434,7 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::isContextChild).when(context, item1).thenReturn(true);
 
         monitor->addItem(item1);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchTagItems).when(tag).exactly(1));
@@ -461,7 +465,8 @@ private slots:
         // Serializer mock
         mock_object<Akonadi::SerializerInterface> serializerMock;
         serializerMock(&Akonadi::SerializerInterface::createTagFromContext).when(context).thenReturn(tag);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).thenReturn(task1);
+        serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1)
+                                                                           .thenReturn(Domain::Task::List() << task1);
 
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(task1, item1).thenReturn(true);
         serializerMock(&Akonadi::SerializerInterface::isContextChild).when(context, item1).thenReturn(true);
@@ -484,6 +489,7 @@ private slots:
         // WHEN
         serializerMock(&Akonadi::SerializerInterface::updateTaskFromItem).when(task1, item1).thenReturn();
         monitor->changeItem(item1);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchTagItems).when(tag).exactly(1));
@@ -534,6 +540,7 @@ private slots:
 
         // WHEN
         monitor->changeItem(item1);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchTagItems).when(tag).exactly(1));
@@ -564,7 +571,8 @@ private slots:
         mock_object<Akonadi::SerializerInterface> serializerMock;
         serializerMock(&Akonadi::SerializerInterface::createTagFromContext).when(context).thenReturn(tag);
 
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).thenReturn(task1);
+        serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1)
+                                                                           .thenReturn(Domain::Task::List() << task1);
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(task1, item1).thenReturn(true);
 
         serializerMock(&Akonadi::SerializerInterface::isContextChild).when(context, item1).thenReturn(true)
@@ -584,6 +592,7 @@ private slots:
 
         // WHEN
         monitor->changeItem(item1);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchTagItems).when(tag).exactly(1));
@@ -619,6 +628,8 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::createTagFromContext).when(context1).thenReturn(tag1);
         serializerMock(&Akonadi::SerializerInterface::createTagFromContext).when(context2).thenReturn(tag2);
 
+        serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1)
+                                                                           .thenReturn(Domain::Task::List() << task1);
         serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).thenReturn(task1);
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(task1, item1).thenReturn(true);
 
@@ -643,6 +654,7 @@ private slots:
 
         // WHEN
         monitor->changeItem(item1); // Gets a different associated tag
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(result1->data().isEmpty());
@@ -671,7 +683,8 @@ private slots:
         // Serializer mock
         mock_object<Akonadi::SerializerInterface> serializerMock;
         serializerMock(&Akonadi::SerializerInterface::createTagFromContext).when(context).thenReturn(tag);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).thenReturn(task1);
+        serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1)
+                                                                           .thenReturn(Domain::Task::List() << task1);
 
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(task1, item1).thenReturn(true);
         serializerMock(&Akonadi::SerializerInterface::isContextChild).when(context, item1).thenReturn(true);
@@ -690,6 +703,7 @@ private slots:
 
         // WHEN
         monitor->removeItem(item1);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchTagItems).when(tag).exactly(1));
@@ -322,6 +322,7 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::isNoteCollection).when(col2).thenReturn(false);
         monitor->addCollection(col1);
         monitor->addCollection(col2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -402,6 +403,7 @@ private slots:
 
         // WHEN
         monitor->removeCollection(col3);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -487,6 +489,7 @@ private slots:
 
         // WHEN
         monitor->changeCollection(col2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -601,6 +604,7 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::createDataSourceFromCollection).when(col, Akonadi::SerializerInterface::BaseName).thenReturn(source);
 
         monitor->addCollection(col);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -656,6 +660,7 @@ private slots:
 
         // WHEN
         monitor->removeCollection(col2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -725,6 +730,7 @@ private slots:
         // WHEN
         monitor->changeCollection(col2);
         monitor->changeCollection(col3);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -786,6 +792,7 @@ private slots:
         // WHEN
         col2.setEnabled(false);
         monitor->changeCollection(col2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -979,6 +986,7 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::createDataSourceFromCollection).when(col, Akonadi::SerializerInterface::BaseName).thenReturn(source);
 
         monitor->addCollection(col);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -1040,6 +1048,7 @@ private slots:
 
         // WHEN
         monitor->removeCollection(col2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -1107,6 +1116,7 @@ private slots:
 
         // WHEN
         monitor->changeCollection(col2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -1174,6 +1184,7 @@ private slots:
         // WHEN
         col2.setEnabled(false);
         monitor->changeCollection(col2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -1245,6 +1256,7 @@ private slots:
         // WHEN
         col2.setEnabled(true);
         monitor->changeCollection(col2);
+        QTest::qWait(150);
 
         // THEN
         QCOMPARE(firstLevelResult->data().size(), 1);
@@ -1314,6 +1326,7 @@ private slots:
         // WHEN
         col2.setEnabled(false);
         monitor->changeCollection(col2);
+        QTest::qWait(150);
 
         // THEN
         QCOMPARE(firstLevelResult->data().size(), 0);
@@ -1520,6 +1533,7 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::createDataSourceFromCollection).when(col, Akonadi::SerializerInterface::BaseName).thenReturn(source);
 
         monitor->addCollection(col);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionSearchJobInterface* (Akonadi::StorageInterface::*)(QString)>(&Akonadi::StorageInterface::searchCollections)).when(searchTerm)
@@ -1574,6 +1588,7 @@ private slots:
 
         // WHEN
         monitor->removeCollection(col2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionSearchJobInterface* (Akonadi::StorageInterface::*)(QString)>(&Akonadi::StorageInterface::searchCollections)).when(searchTerm)
@@ -1641,6 +1656,7 @@ private slots:
         // WHEN
         monitor->changeCollection(col2);
         monitor->changeCollection(col3);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionSearchJobInterface* (Akonadi::StorageInterface::*)(QString)>(&Akonadi::StorageInterface::searchCollections)).when(searchTerm)
@@ -1889,6 +1905,7 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::createDataSourceFromCollection).when(col, Akonadi::SerializerInterface::BaseName).thenReturn(source);
 
         monitor->addCollection(col);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionSearchJobInterface* (Akonadi::StorageInterface::*)(QString)>(&Akonadi::StorageInterface::searchCollections)).when(searchTerm)
@@ -1949,6 +1966,7 @@ private slots:
 
         // WHEN
         monitor->removeCollection(col2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionSearchJobInterface* (Akonadi::StorageInterface::*)(QString)>(&Akonadi::StorageInterface::searchCollections)).when(searchTerm)
@@ -2013,6 +2031,7 @@ private slots:
 
         // WHEN
         monitor->changeCollection(col2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionSearchJobInterface* (Akonadi::StorageInterface::*)(QString)>(&Akonadi::StorageInterface::searchCollections)).when(searchTerm)
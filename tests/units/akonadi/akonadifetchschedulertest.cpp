@@ -0,0 +1,266 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include <QtTest>
+
+#include <KJob>
+
+#include "akonadi/akonadifetchscheduler.h"
+
+class ControlledJob : public KJob
+{
+public:
+    void start() {}
+    void finish() { emitResult(); }
+};
+
+class AkonadiFetchSchedulerTest : public QObject
+{
+    Q_OBJECT
+private:
+    Akonadi::FetchScheduler::JobStarter createStarter(const Akonadi::Collection &collection,
+                                                      QList<Akonadi::Collection::Id> *started,
+                                                      QList<ControlledJob*> *jobs)
+    {
+        return [collection, started, jobs] (KJob *) -> KJob* {
+            auto job = new ControlledJob;
+            *started << collection.id();
+            *jobs << job;
+            return job;
+        };
+    }
+
+private slots:
+    void shouldStartJobsUpToTheCap()
+    {
+        // GIVEN
+        Akonadi::FetchScheduler scheduler(2);
+        QList<Akonadi::Collection::Id> started;
+        QList<ControlledJob*> jobs;
+
+        // WHEN
+        for (int id = 1; id <= 5; id++) {
+            Akonadi::Collection collection(id);
+            scheduler.schedule(collection, createStarter(collection, &started, &jobs));
+        }
+
+        // THEN
+        QCOMPARE(started, QList<Akonadi::Collection::Id>() << 1 << 2);
+        QCOMPARE(scheduler.runningJobs(), 2);
+        QCOMPARE(scheduler.pendingJobs(), 3);
+
+        // WHEN
+        jobs.takeFirst()->finish();
+
+        // THEN
+        QCOMPARE(started, QList<Akonadi::Collection::Id>() << 1 << 2 << 3);
+        QCOMPARE(scheduler.runningJobs(), 2);
+        QCOMPARE(scheduler.pendingJobs(), 2);
+
+        // WHEN
+        scheduler.setMaximumRunningJobs(4);
+
+        // THEN
+        QCOMPARE(started, QList<Akonadi::Collection::Id>() << 1 << 2 << 3 << 4 << 5);
+        QCOMPARE(scheduler.runningJobs(), 4);
+        QCOMPARE(scheduler.pendingJobs(), 0);
+
+        // WHEN
+        while (!jobs.isEmpty())
+            jobs.takeFirst()->finish();
+
+        // THEN
+        QCOMPARE(scheduler.runningJobs(), 0);
+    }
+
+    void shouldStartPrioritizedCollectionsFirst()
+    {
+        // GIVEN
+        Akonadi::FetchScheduler scheduler(1);
+        QList<Akonadi::Collection::Id> started;
+        QList<ControlledJob*> jobs;
+
+        for (int id = 1; id <= 4; id++) {
+            Akonadi::Collection collection(id);
+            scheduler.schedule(collection, createStarter(collection, &started, &jobs));
+        }
+
+        // WHEN
+        scheduler.prioritize(Akonadi::Collection(3));
+        while (!jobs.isEmpty())
+            jobs.takeFirst()->finish();
+
+        // THEN
+        QCOMPARE(started, QList<Akonadi::Collection::Id>() << 1 << 3 << 2 << 4);
+    }
+
+    void shouldStartFetchesByPriority()
+    {
+        // GIVEN
+        Akonadi::FetchScheduler scheduler(1);
+        QList<Akonadi::Collection::Id> started;
+        QList<ControlledJob*> jobs;
+
+        Akonadi::Collection col1(1);
+        scheduler.schedule(col1, createStarter(col1, &started, &jobs));
+
+        // WHEN
+        {
+            Utils::JobHandler::Scope scope(0, Utils::JobHandler::BackgroundPriority);
+            Akonadi::Collection collection(2);
+            scheduler.schedule(collection, createStarter(collection, &started, &jobs));
+        }
+        {
+            Utils::JobHandler::Scope scope(0, Utils::JobHandler::PrefetchPriority);
+            Akonadi::Collection collection(3);
+            scheduler.schedule(collection, createStarter(collection, &started, &jobs));
+        }
+        {
+            Akonadi::Collection collection(4);
+            scheduler.schedule(collection, createStarter(collection, &started, &jobs));
+        }
+        {
+            Utils::JobHandler::Scope scope(0, Utils::JobHandler::PrefetchPriority);
+            Akonadi::Collection collection(5);
+            scheduler.schedule(collection, createStarter(collection, &started, &jobs));
+        }
+
+        while (!jobs.isEmpty())
+            jobs.takeFirst()->finish();
+
+        // THEN
+        QCOMPARE(started, QList<Akonadi::Collection::Id>() << 1 << 4 << 3 << 5 << 2);
+    }
+
+    void shouldSkipFetchesNobodyWaitsFor()
+    {
+        // GIVEN
+        Akonadi::FetchScheduler scheduler(1);
+        QList<Akonadi::Collection::Id> started;
+        QList<ControlledJob*> jobs;
+
+        Akonadi::Collection col1(1);
+        scheduler.schedule(col1, createStarter(col1, &started, &jobs));
+        scheduler.schedule(Akonadi::Collection(2), [] (KJob *) -> KJob* { return 0; });
+        Akonadi::Collection col3(3);
+        scheduler.schedule(col3, createStarter(col3, &started, &jobs));
+
+        // WHEN
+        jobs.takeFirst()->finish();
+
+        // THEN
+        QCOMPARE(started, QList<Akonadi::Collection::Id>() << 1 << 3);
+        QCOMPARE(scheduler.runningJobs(), 1);
+        QCOMPARE(scheduler.pendingJobs(), 0);
+        jobs.takeFirst()->finish();
+    }
+
+    void shouldShareTheSlotOfAWaitingFetchOfTheSameCollection()
+    {
+        // GIVEN
+        Akonadi::FetchScheduler scheduler(1);
+        QList<Akonadi::Collection::Id> started;
+        QList<ControlledJob*> jobs;
+
+        Akonadi::Collection col1(1);
+        scheduler.schedule(col1, createStarter(col1, &started, &jobs));
+        {
+            Utils::JobHandler::Scope scope(0, Utils::JobHandler::BackgroundPriority);
+            Akonadi::Collection col3(3);
+            scheduler.schedule(col3, createStarter(col3, &started, &jobs));
+            Akonadi::Collection col2(2);
+            scheduler.schedule(col2, createStarter(col2, &started, &jobs));
+        }
+
+        // WHEN
+        QList<KJob*> joinedJobs;
+        scheduler.schedule(Akonadi::Collection(2), [&joinedJobs] (KJob *runningJob) -> KJob* {
+            joinedJobs << runningJob;
+            return runningJob;
+        });
+
+        // THEN
+        QCOMPARE(scheduler.pendingJobs(), 2);
+
+        // WHEN
+        jobs.takeFirst()->finish();
+
+        // THEN
+        QCOMPARE(started, QList<Akonadi::Collection::Id>() << 1 << 2);
+        QCOMPARE(joinedJobs.size(), 1);
+        QCOMPARE(joinedJobs.first(), static_cast<KJob*>(jobs.first()));
+        QCOMPARE(scheduler.runningJobs(), 1);
+        QCOMPARE(scheduler.pendingJobs(), 1);
+
+        // WHEN
+        while (!jobs.isEmpty())
+            jobs.takeFirst()->finish();
+
+        // THEN
+        QCOMPARE(started, QList<Akonadi::Collection::Id>() << 1 << 2 << 3);
+        QCOMPARE(scheduler.runningJobs(), 0);
+    }
+
+    void shouldReportOverallProgress()
+    {
+        // GIVEN
+        Akonadi::FetchScheduler scheduler(1);
+        QSignalSpy spy(&scheduler, SIGNAL(progress(int,int)));
+        QList<Akonadi::Collection::Id> started;
+        QList<ControlledJob*> jobs;
+
+        // WHEN
+        for (int id = 1; id <= 2; id++) {
+            Akonadi::Collection collection(id);
+            scheduler.schedule(collection, createStarter(collection, &started, &jobs));
+        }
+        while (!jobs.isEmpty())
+            jobs.takeFirst()->finish();
+
+        // THEN
+        QCOMPARE(spy.size(), 4);
+        QCOMPARE(spy.at(0).at(0).toInt(), 0);
+        QCOMPARE(spy.at(0).at(1).toInt(), 1);
+        QCOMPARE(spy.at(1).at(0).toInt(), 0);
+        QCOMPARE(spy.at(1).at(1).toInt(), 2);
+        QCOMPARE(spy.at(2).at(0).toInt(), 1);
+        QCOMPARE(spy.at(2).at(1).toInt(), 2);
+        QCOMPARE(spy.at(3).at(0).toInt(), 2);
+        QCOMPARE(spy.at(3).at(1).toInt(), 2);
+
+        // WHEN
+        Akonadi::Collection collection(3);
+        scheduler.schedule(collection, createStarter(collection, &started, &jobs));
+
+        // THEN
+        QCOMPARE(spy.size(), 5);
+        QCOMPARE(spy.at(4).at(0).toInt(), 0);
+        QCOMPARE(spy.at(4).at(1).toInt(), 1);
+        jobs.takeFirst()->finish();
+    }
+};
+
+QTEST_MAIN(AkonadiFetchSchedulerTest)
+
+#include "akonadifetchschedulertest.moc"
@@ -0,0 +1,142 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include <QtTest>
+
+#include "testlib/akonadimocks.h"
+
+#include "akonadi/akonadimonitorproxy.h"
+
+class AkonadiMonitorProxyTest : public QObject
+{
+    Q_OBJECT
+public:
+    explicit AkonadiMonitorProxyTest(QObject *parent = 0)
+        : QObject(parent)
+    {
+        qRegisterMetaType<Akonadi::Collection>();
+        qRegisterMetaType<Akonadi::Item>();
+        qRegisterMetaType<Akonadi::Tag>();
+    }
+
+private slots:
+    void shouldForwardNotificationsOfTheSource()
+    {
+        // GIVEN
+        MockMonitor source;
+        Akonadi::MonitorProxy proxy(&source);
+        QCOMPARE(proxy.source(), &source);
+
+        QSignalSpy collectionAddedSpy(&proxy, SIGNAL(collectionAdded(Akonadi::Collection)));
+        QSignalSpy collectionRemovedSpy(&proxy, SIGNAL(collectionRemoved(Akonadi::Collection)));
+        QSignalSpy collectionChangedSpy(&proxy, SIGNAL(collectionChanged(Akonadi::Collection)));
+        QSignalSpy collectionSelectionChangedSpy(&proxy, SIGNAL(collectionSelectionChanged(Akonadi::Collection)));
+        QSignalSpy itemAddedSpy(&proxy, SIGNAL(itemAdded(Akonadi::Item)));
+        QSignalSpy itemRemovedSpy(&proxy, SIGNAL(itemRemoved(Akonadi::Item)));
+        QSignalSpy itemChangedSpy(&proxy, SIGNAL(itemChanged(Akonadi::Item)));
+        QSignalSpy itemMovedSpy(&proxy, SIGNAL(itemMoved(Akonadi::Item)));
+        QSignalSpy tagAddedSpy(&proxy, SIGNAL(tagAdded(Akonadi::Tag)));
+        QSignalSpy tagRemovedSpy(&proxy, SIGNAL(tagRemoved(Akonadi::Tag)));
+        QSignalSpy tagChangedSpy(&proxy, SIGNAL(tagChanged(Akonadi::Tag)));
+
+        Akonadi::Collection collection(42);
+        Akonadi::Item item(43);
+        Akonadi::Tag tag(44);
+
+        // WHEN
+        source.addCollection(collection);
+        source.removeCollection(collection);
+        source.changeCollection(collection);
+        source.changeCollectionSelection(collection);
+        source.addItem(item);
+        source.removeItem(item);
+        source.changeItem(item);
+        source.moveItem(item);
+        source.addTag(tag);
+        source.removeTag(tag);
+        source.changeTag(tag);
+
+        // THEN
+        QCOMPARE(collectionAddedSpy.size(), 1);
+        QCOMPARE(collectionAddedSpy.first().first().value<Akonadi::Collection>(), collection);
+        QCOMPARE(collectionRemovedSpy.size(), 1);
+        QCOMPARE(collectionRemovedSpy.first().first().value<Akonadi::Collection>(), collection);
+        QCOMPARE(collectionChangedSpy.size(), 1);
+        QCOMPARE(collectionChangedSpy.first().first().value<Akonadi::Collection>(), collection);
+        QCOMPARE(collectionSelectionChangedSpy.size(), 1);
+        QCOMPARE(collectionSelectionChangedSpy.first().first().value<Akonadi::Collection>(), collection);
+        QCOMPARE(itemAddedSpy.size(), 1);
+        QCOMPARE(itemAddedSpy.first().first().value<Akonadi::Item>(), item);
+        QCOMPARE(itemRemovedSpy.size(), 1);
+        QCOMPARE(itemRemovedSpy.first().first().value<Akonadi::Item>(), item);
+        QCOMPARE(itemChangedSpy.size(), 1);
+        QCOMPARE(itemChangedSpy.first().first().value<Akonadi::Item>(), item);
+        QCOMPARE(itemMovedSpy.size(), 1);
+        QCOMPARE(itemMovedSpy.first().first().value<Akonadi::Item>(), item);
+        QCOMPARE(tagAddedSpy.size(), 1);
+        QCOMPARE(tagAddedSpy.first().first().value<Akonadi::Tag>(), tag);
+        QCOMPARE(tagRemovedSpy.size(), 1);
+        QCOMPARE(tagRemovedSpy.first().first().value<Akonadi::Tag>(), tag);
+        QCOMPARE(tagChangedSpy.size(), 1);
+        QCOMPARE(tagChangedSpy.first().first().value<Akonadi::Tag>(), tag);
+    }
+
+    void shouldFanOutOneNotificationToAllProxies()
+    {
+        // GIVEN
+        MockMonitor source;
+        Akonadi::MonitorProxy proxy1(&source);
+        Akonadi::MonitorProxy proxy2(&source);
+        QSignalSpy spy1(&proxy1, SIGNAL(itemChanged(Akonadi::Item)));
+        QSignalSpy spy2(&proxy2, SIGNAL(itemChanged(Akonadi::Item)));
+
+        // WHEN
+        source.changeItem(Akonadi::Item(42));
+
+        // THEN
+        QCOMPARE(spy1.size(), 1);
+        QCOMPARE(spy2.size(), 1);
+    }
+
+    void shouldLeaveTheSourceAloneWhenDestroyed()
+    {
+        // GIVEN
+        MockMonitor source;
+        QSignalSpy sourceSpy(&source, SIGNAL(itemAdded(Akonadi::Item)));
+        auto proxy = new Akonadi::MonitorProxy(&source);
+        QSignalSpy destroyedSpy(&source, SIGNAL(destroyed()));
+
+        // WHEN
+        delete proxy;
+        source.addItem(Akonadi::Item(42));
+
+        // THEN
+        QVERIFY(destroyedSpy.isEmpty());
+        QCOMPARE(sourceSpy.size(), 1);
+    }
+};
+
+QTEST_MAIN(AkonadiMonitorProxyTest)
+
+#include "akonadimonitorproxytest.moc"
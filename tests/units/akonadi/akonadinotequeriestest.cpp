@@ -85,9 +85,10 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::isNoteItem).when(item2).thenReturn(true);
         serializerMock(&Akonadi::SerializerInterface::isNoteItem).when(item3).thenReturn(true);
 
-        serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item1).thenReturn(note1);
-        serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item2).thenReturn(note2);
-        serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item3).thenReturn(note3);
+        serializerMock(&Akonadi::SerializerInterface::createNotesFromItems).when(Akonadi::Item::List() << item1)
+                                                                           .thenReturn(Domain::Note::List() << note1);
+        serializerMock(&Akonadi::SerializerInterface::createNotesFromItems).when(Akonadi::Item::List() << item2 << item3)
+                                                                           .thenReturn(Domain::Note::List() << note2 << note3);
 
         // WHEN
         QScopedPointer<Domain::NoteQueries> queries(new Akonadi::NoteQueries(&storageMock.getInstance(),
@@ -105,11 +106,10 @@ private slots:
                                                                                Akonadi::StorageInterface::Notes)
                                                                          .exactly(1));
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col1).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item1).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createNotesFromItems).when(Akonadi::Item::List() << item1).exactly(1));
 
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col2).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item2).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item3).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createNotesFromItems).when(Akonadi::Item::List() << item2 << item3).exactly(1));
 
 
         QCOMPARE(result->data().size(), 3);
@@ -153,6 +153,8 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::isNoteItem).when(item1).thenReturn(true);
         serializerMock(&Akonadi::SerializerInterface::isNoteItem).when(item2).thenReturn(false);
 
+        serializerMock(&Akonadi::SerializerInterface::createNotesFromItems).when(Akonadi::Item::List() << item1)
+                                                                           .thenReturn(Domain::Note::List() << note1);
         serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item1).thenReturn(note1);
         serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item2).thenReturn(note2);
 
@@ -170,7 +172,8 @@ private slots:
                                                                                Akonadi::StorageInterface::Notes)
                                                                          .exactly(1));
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item1).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createNotesFromItems).when(Akonadi::Item::List() << item1).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item1).exactly(0));
         QVERIFY(serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item2).exactly(0));
 
         QCOMPARE(result->data().size(), 1);
@@ -215,6 +218,7 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item2).thenReturn(note2);
         monitor->addItem(item1);
         monitor->addItem(item2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -266,9 +270,8 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::isNoteItem).when(item2).thenReturn(true);
         serializerMock(&Akonadi::SerializerInterface::isNoteItem).when(item3).thenReturn(true);
 
-        serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item1).thenReturn(note1);
-        serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item2).thenReturn(note2);
-        serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item3).thenReturn(note3);
+        serializerMock(&Akonadi::SerializerInterface::createNotesFromItems).when(Akonadi::Item::List() << item1 << item2 << item3)
+                                                                           .thenReturn(Domain::Note::List() << note1 << note2 << note3);
 
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(note1, item2).thenReturn(false);
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(note2, item2).thenReturn(true);
@@ -286,6 +289,7 @@ private slots:
 
         // WHEN
         monitor->removeItem(item2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -293,9 +297,7 @@ private slots:
                                                                                Akonadi::StorageInterface::Notes)
                                                                          .exactly(1));
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item1).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item2).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item3).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createNotesFromItems).when(Akonadi::Item::List() << item1 << item2 << item3).exactly(1));
 
         QCOMPARE(result->data().size(), 2);
         QCOMPARE(result->data().at(0), note1);
@@ -340,9 +342,8 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::isNoteItem).when(item2).thenReturn(true);
         serializerMock(&Akonadi::SerializerInterface::isNoteItem).when(item3).thenReturn(true);
 
-        serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item1).thenReturn(note1);
-        serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item2).thenReturn(note2);
-        serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item3).thenReturn(note3);
+        serializerMock(&Akonadi::SerializerInterface::createNotesFromItems).when(Akonadi::Item::List() << item1 << item2 << item3)
+                                                                           .thenReturn(Domain::Note::List() << note1 << note2 << note3);
         serializerMock(&Akonadi::SerializerInterface::updateNoteFromItem).when(note2, item2).thenReturn();
 
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(note1, item2).thenReturn(false);
@@ -367,6 +368,7 @@ private slots:
 
         // WHEN
         monitor->changeItem(item2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -374,9 +376,7 @@ private slots:
                                                                                Akonadi::StorageInterface::Notes)
                                                                          .exactly(1));
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item1).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item2).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item3).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createNotesFromItems).when(Akonadi::Item::List() << item1 << item2 << item3).exactly(1));
         QVERIFY(serializerMock(&Akonadi::SerializerInterface::updateNoteFromItem).when(note2, item2).exactly(1));
 
         QCOMPARE(result->data().size(), 3);
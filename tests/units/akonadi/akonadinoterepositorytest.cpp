@@ -25,11 +25,15 @@
 
 #include <Akonadi/Collection>
 #include <Akonadi/Item>
+#include <Akonadi/Notes/NoteUtils>
+
+#include <KMime/Message>
 
 #include <mockitopp/mockitopp.hpp>
 #include "testlib/akonadimocks.h"
 
 #include "akonadi/akonadinoterepository.h"
+#include "akonadi/akonadiserializer.h"
 #include "akonadi/akonadiserializerinterface.h"
 #include "akonadi/akonadistorageinterface.h"
 #include "akonadi/akonadistoragesettings.h"
@@ -199,6 +203,125 @@ private slots:
         QVERIFY(storageMock(&Akonadi::StorageInterface::updateItem).when(item, 0).exactly(1));
     }
 
+    void shouldLoadPartialNotesBeforeSave()
+    {
+        // GIVEN
+
+        // A note for which only the headers got loaded
+        Akonadi::Item item(42);
+        Domain::Note::Ptr note(new Domain::Note);
+        note->backendIdentity().setPartial(true);
+
+        // The full item in storage
+        Akonadi::Item fullItem(42);
+        auto itemFetchJob = new MockItemFetchJob(this);
+        itemFetchJob->setItems(Akonadi::Item::List() << fullItem);
+
+        // A mock modify job
+        auto itemModifyJob = new MockAkonadiJob(this);
+
+        // Storage mock returning the fetch and modify jobs
+        mock_object<Akonadi::StorageInterface> storageMock;
+        storageMock(&Akonadi::StorageInterface::fetchItem).when(item)
+                                                          .thenReturn(itemFetchJob);
+        storageMock(&Akonadi::StorageInterface::updateItem).when(item, 0)
+                                                           .thenReturn(itemModifyJob);
+
+        // Serializer mock returning the item for the note and filling it back
+        mock_object<Akonadi::SerializerInterface> serializerMock;
+        serializerMock(&Akonadi::SerializerInterface::createItemFromNote).when(note).thenReturn(item);
+        serializerMock(&Akonadi::SerializerInterface::updateNoteFromItem).when(note, fullItem).thenReturn();
+
+        // WHEN
+        QScopedPointer<Akonadi::NoteRepository> repository(new Akonadi::NoteRepository(&storageMock.getInstance(),
+                                                                                       &serializerMock.getInstance()));
+        repository->save(note)->exec();
+
+        // THEN
+        QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItem).when(item).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::updateNoteFromItem).when(note, fullItem).exactly(1));
+        QVERIFY(storageMock(&Akonadi::StorageInterface::updateItem).when(item, 0).exactly(1));
+    }
+
+    void shouldKeepTheTextOfPartialNotesOnSave()
+    {
+        // GIVEN
+
+        // A note for which only the headers got loaded, edited before its body came
+        Domain::Note::Ptr note(new Domain::Note);
+        note->backendIdentity().setId(42);
+        note->backendIdentity().setPartial(true);
+        note->setTitle("new title");
+        note->setText("new text");
+
+        // The full item in storage
+        KMime::Message::Ptr message(new KMime::Message);
+        message->subject(true)->fromUnicodeString("old title", "utf-8");
+        message->mainBodyPart()->fromUnicodeString("old text");
+
+        Akonadi::Item fullItem(42);
+        fullItem.setMimeType(Akonadi::NoteUtils::noteMimeType());
+        fullItem.setPayload<KMime::Message::Ptr>(message);
+        auto itemFetchJob = new MockItemFetchJob(this);
+        itemFetchJob->setItems(Akonadi::Item::List() << fullItem);
+
+        // A mock modify job
+        auto itemModifyJob = new MockAkonadiJob(this);
+
+        // Storage mock returning the fetch and modify jobs
+        Akonadi::Item item(42);
+        mock_object<Akonadi::StorageInterface> storageMock;
+        storageMock(&Akonadi::StorageInterface::fetchItem).when(item)
+                                                          .thenReturn(itemFetchJob);
+        storageMock(&Akonadi::StorageInterface::updateItem).when(item, 0)
+                                                           .thenReturn(itemModifyJob);
+
+        // A real serializer to fill the note back with the server copy
+        Akonadi::Serializer serializer;
+
+        // WHEN
+        QScopedPointer<Akonadi::NoteRepository> repository(new Akonadi::NoteRepository(&storageMock.getInstance(),
+                                                                                       &serializer));
+        repository->save(note)->exec();
+
+        // THEN
+        QCOMPARE(note->title(), QString("new title"));
+        QCOMPARE(note->text(), QString("new text"));
+        QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItem).when(item).exactly(1));
+        QVERIFY(storageMock(&Akonadi::StorageInterface::updateItem).when(item, 0).exactly(1));
+    }
+
+    void shouldLoadANote()
+    {
+        // GIVEN
+        Akonadi::Item item(42);
+        Domain::Note::Ptr note(new Domain::Note);
+
+        // The full item in storage
+        Akonadi::Item fullItem(42);
+        auto itemFetchJob = new MockItemFetchJob(this);
+        itemFetchJob->setItems(Akonadi::Item::List() << fullItem);
+
+        // Storage mock returning the fetch job
+        mock_object<Akonadi::StorageInterface> storageMock;
+        storageMock(&Akonadi::StorageInterface::fetchItem).when(item)
+                                                          .thenReturn(itemFetchJob);
+
+        // Serializer mock returning the item for the note and filling it back
+        mock_object<Akonadi::SerializerInterface> serializerMock;
+        serializerMock(&Akonadi::SerializerInterface::createItemFromNote).when(note).thenReturn(item);
+        serializerMock(&Akonadi::SerializerInterface::updateNoteFromItem).when(note, fullItem).thenReturn();
+
+        // WHEN
+        QScopedPointer<Akonadi::NoteRepository> repository(new Akonadi::NoteRepository(&storageMock.getInstance(),
+                                                                                       &serializerMock.getInstance()));
+        repository->load(note)->exec();
+
+        // THEN
+        QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItem).when(item).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::updateNoteFromItem).when(note, fullItem).exactly(1));
+    }
+
     void shouldRemoveANote()
     {
         // GIVEN
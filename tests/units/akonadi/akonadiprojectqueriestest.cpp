@@ -221,6 +221,7 @@ private slots:
 
         monitor->addItem(item1);
         monitor->addItem(item2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -294,6 +295,7 @@ private slots:
 
         // WHEN
         monitor->removeItem(item2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -377,6 +379,7 @@ private slots:
 
         // WHEN
         monitor->changeItem(item2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -531,11 +534,12 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::isNoteItem).when(item5).thenReturn(true);
 
         serializerMock(&Akonadi::SerializerInterface::createItemFromProject).when(project1).thenReturn(item1);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).thenReturn(task2);
+        serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item2)
+                                                                               .thenReturn(Domain::Artifact::List() << task2);
+        serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item4)
+                                                                               .thenReturn(Domain::Artifact::List() << note4);
         serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item3).thenReturn(task3);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item4).thenReturn(Domain::Task::Ptr());
         serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item5).thenReturn(Domain::Task::Ptr());
-        serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item4).thenReturn(note4);
         serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item5).thenReturn(note5);
 
         // Serializer mock returning if project1 is parent of items
@@ -702,6 +706,7 @@ private slots:
 
         monitor->addItem(item2);
         monitor->addItem(item3);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).exactly(1));
@@ -755,10 +760,9 @@ private slots:
 
         serializerMock(&Akonadi::SerializerInterface::createItemFromProject).when(project1).thenReturn(item1);
         serializerMock(&Akonadi::SerializerInterface::createProjectFromItem).when(item2).thenReturn(Domain::Project::Ptr());
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).thenReturn(task2);
+        serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item2 << item3)
+                                                                               .thenReturn(Domain::Artifact::List() << task2 << note3);
         serializerMock(&Akonadi::SerializerInterface::createProjectFromItem).when(item3).thenReturn(Domain::Project::Ptr());
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item3).thenReturn(Domain::Task::Ptr());
-        serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item3).thenReturn(note3);
 
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(task2, item2).thenReturn(true);
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(note3, item2).thenReturn(false);
@@ -786,6 +790,7 @@ private slots:
         // WHEN
         serializerMock(&Akonadi::SerializerInterface::updateTaskFromItem).when(task2, item2).thenReturn();
         monitor->changeItem(item2);
+        QTest::qWait(150);
 
         // Then
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
@@ -840,10 +845,9 @@ private slots:
 
         serializerMock(&Akonadi::SerializerInterface::createItemFromProject).when(project1).thenReturn(item1);
         serializerMock(&Akonadi::SerializerInterface::createProjectFromItem).when(item2).thenReturn(Domain::Project::Ptr());
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).thenReturn(task2);
+        serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item2 << item3)
+                                                                               .thenReturn(Domain::Artifact::List() << task2 << note3);
         serializerMock(&Akonadi::SerializerInterface::createProjectFromItem).when(item3).thenReturn(Domain::Project::Ptr());
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item3).thenReturn(Domain::Task::Ptr());
-        serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item3).thenReturn(note3);
 
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(task2, item2).thenReturn(true);
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(note3, item2).thenReturn(false);
@@ -870,6 +874,7 @@ private slots:
         // WHEN
         serializerMock(&Akonadi::SerializerInterface::updateTaskFromItem).when(task2, item2).thenReturn();
         monitor->changeItem(item2);
+        QTest::qWait(150);
 
         // Then
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
@@ -921,10 +926,10 @@ private slots:
 
         serializerMock(&Akonadi::SerializerInterface::createItemFromProject).when(project1).thenReturn(item1);
         serializerMock(&Akonadi::SerializerInterface::createProjectFromItem).when(item2).thenReturn(Domain::Project::Ptr());
+        serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item3)
+                                                                               .thenReturn(Domain::Artifact::List() << note3);
         serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).thenReturn(task2);
         serializerMock(&Akonadi::SerializerInterface::createProjectFromItem).when(item3).thenReturn(Domain::Project::Ptr());
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item3).thenReturn(Domain::Task::Ptr());
-        serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item3).thenReturn(note3);
 
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(task2, item2).thenReturn(true);
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(note3, item2).thenReturn(false);
@@ -948,6 +953,7 @@ private slots:
 
         // WHEN
         monitor->changeItem(item2);
+        QTest::qWait(150);
 
         // Then
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
@@ -1009,6 +1015,8 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::createItemFromProject).when(project2).thenReturn(item2);
 
         serializerMock(&Akonadi::SerializerInterface::createProjectFromItem).when(item3).thenReturn(Domain::Project::Ptr());
+        serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item3)
+                                                                               .thenReturn(Domain::Artifact::List() << task3);
         serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item3).thenReturn(task3);
 
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(task3, item3).thenReturn(true);
@@ -1041,6 +1049,7 @@ private slots:
 
         // WHEN
         monitor->changeItem(item3); // Now gets a different related id
+        QTest::qWait(150);
 
         // Then
         QCOMPARE(result1->data().size(), 0);
@@ -1091,10 +1100,9 @@ private slots:
 
         serializerMock(&Akonadi::SerializerInterface::createItemFromProject).when(project1).thenReturn(item1);
         serializerMock(&Akonadi::SerializerInterface::createProjectFromItem).when(item2).thenReturn(Domain::Project::Ptr());
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).thenReturn(task2);
+        serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item2 << item3)
+                                                                               .thenReturn(Domain::Artifact::List() << task2 << note3);
         serializerMock(&Akonadi::SerializerInterface::createProjectFromItem).when(item3).thenReturn(Domain::Project::Ptr());
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item3).thenReturn(Domain::Task::Ptr());
-        serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item3).thenReturn(note3);
 
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(task2, item2).thenReturn(true);
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(note3, item2).thenReturn(false);
@@ -1118,6 +1126,7 @@ private slots:
 
         // WHEN
         monitor->removeItem(item2);
+        QTest::qWait(150);
 
         // Then
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
@@ -1125,6 +1134,85 @@ private slots:
         QCOMPARE(result->data().size(), 1);
         QCOMPARE(result->data().at(0).objectCast<Domain::Note>(), note3);
     }
+
+    void shouldOnlyWakeTopLevelArtifactsOfTheAffectedProject()
+    {
+        // GIVEN
+
+        // One top level collection
+        Akonadi::Collection col(42);
+        col.setParentCollection(Akonadi::Collection::root());
+        auto collectionFetchJob = new MockCollectionFetchJob(this);
+        collectionFetchJob->setCollections(Akonadi::Collection::List() << col);
+
+        // One project in the collection
+        Akonadi::Item item1(42);
+        item1.setParentCollection(col);
+        auto project1 = Domain::Project::Ptr::create();
+        project1->backendIdentity().setUid("project1");
+        auto itemFetchJob = new MockItemFetchJob(this);
+        itemFetchJob->setItems(Akonadi::Item::List() << item1);
+
+        // Storage mock returning the fetch jobs
+        mock_object<Akonadi::StorageInterface> storageMock;
+        storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
+                                                                       Akonadi::StorageInterface::Recursive,
+                                                                       Akonadi::StorageInterface::Tasks | Akonadi::StorageInterface::Notes)
+                                                                 .thenReturn(collectionFetchJob);
+        storageMock(&Akonadi::StorageInterface::fetchItems).when(col)
+                                                           .thenReturn(itemFetchJob);
+
+        // Serializer mock
+        mock_object<Akonadi::SerializerInterface> serializerMock;
+        serializerMock(&Akonadi::SerializerInterface::isSelectedCollection).when(col).thenReturn(true);
+        serializerMock(&Akonadi::SerializerInterface::createItemFromProject).when(project1).thenReturn(item1);
+        serializerMock(&Akonadi::SerializerInterface::relatedUidFromItem).when(item1).thenReturn(QString());
+        serializerMock(&Akonadi::SerializerInterface::isProjectChild).when(project1, item1).thenReturn(false);
+
+        // Monitor mock
+        MockMonitor *monitor = new MockMonitor(this);
+
+        QScopedPointer<Domain::ProjectQueries> queries(new Akonadi::ProjectQueries(&storageMock.getInstance(),
+                                                                                   &serializerMock.getInstance(),
+                                                                                   monitor));
+        Domain::QueryResult<Domain::Artifact::Ptr>::Ptr result = queries->findTopLevelArtifacts(project1);
+        QTest::qWait(150);
+        QVERIFY(result->data().isEmpty());
+
+        // WHEN
+        // One task belonging to another project and one task of project1
+        Akonadi::Item item2(43);
+        item2.setParentCollection(col);
+        Akonadi::Item item3(44);
+        item3.setParentCollection(col);
+        auto task3 = Domain::Task::Ptr::create();
+        serializerMock(&Akonadi::SerializerInterface::relatedUidFromItem).when(item2).thenReturn(QString("project2"));
+        serializerMock(&Akonadi::SerializerInterface::relatedUidFromItem).when(item3).thenReturn(QString("project1"))
+                                                                                    .thenReturn(QString("project2"));
+        serializerMock(&Akonadi::SerializerInterface::isProjectChild).when(project1, item3).thenReturn(true)
+                                                                                           .thenReturn(false);
+        serializerMock(&Akonadi::SerializerInterface::isTaskItem).when(item3).thenReturn(true);
+        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item3).thenReturn(task3);
+
+        monitor->addItem(item2);
+        monitor->addItem(item3);
+        QTest::qWait(150);
+
+        // THEN
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::isProjectChild).when(project1, item2).exactly(0));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::isProjectChild).when(project1, item3).exactly(1));
+        QCOMPARE(result->data().size(), 1);
+        QCOMPARE(result->data().at(0).objectCast<Domain::Task>(), task3);
+
+        // WHEN
+        // The task moves to the other project
+        monitor->changeItem(item3);
+        QTest::qWait(150);
+
+        // THEN
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::isProjectChild).when(project1, item3).exactly(2));
+        QVERIFY(result->data().isEmpty());
+    }
 };
 
 QTEST_MAIN(AkonadiProjectQueriesTest)
@@ -44,7 +44,7 @@ private slots:
     {
         // GIVEN
         Akonadi::Serializer serializer;
-        auto object = Akonadi::Serializer::QObjectPtr::create();
+        auto object = Domain::DataSource::Ptr::create();
         Akonadi::Collection collection(42);
 
         // WHEN
@@ -52,15 +52,16 @@ private slots:
 
         // THEN
         QVERIFY(!serializer.representsCollection(object, collection));
+        QVERIFY(!serializer.representsCollection(object, Akonadi::Collection()));
 
         // WHEN
-        object->setProperty("collectionId", 42);
+        object->backendIdentity().setId(42);
 
         // THEN
         QVERIFY(serializer.representsCollection(object, collection));
 
         // WHEN
-        object->setProperty("collectionId", 43);
+        object->backendIdentity().setId(43);
 
         // THEN
         QVERIFY(!serializer.representsCollection(object, collection));
@@ -70,7 +71,7 @@ private slots:
     {
         // GIVEN
         Akonadi::Serializer serializer;
-        auto object = Akonadi::Serializer::QObjectPtr::create();
+        auto object = Domain::Task::Ptr::create();
         Akonadi::Item item(42);
 
         // WHEN
@@ -78,15 +79,16 @@ private slots:
 
         // THEN
         QVERIFY(!serializer.representsItem(object, item));
+        QVERIFY(!serializer.representsItem(object, Akonadi::Item()));
 
         // WHEN
-        object->setProperty("itemId", 42);
+        object->backendIdentity().setId(42);
 
         // THEN
         QVERIFY(serializer.representsItem(object, item));
 
         // WHEN
-        object->setProperty("itemId", 43);
+        object->backendIdentity().setId(43);
 
         // THEN
         QVERIFY(!serializer.representsItem(object, item));
@@ -103,15 +105,16 @@ private slots:
         // Nothing yet
         // THEN
         QVERIFY(!serializer.representsAkonadiTag(tag, akondiTag));
+        QVERIFY(!serializer.representsAkonadiTag(tag, Akonadi::Tag()));
 
         // WHEN
-        tag->setProperty("tagId", 42);
+        tag->backendIdentity().setId(42);
 
         // THEN
         QVERIFY(serializer.representsAkonadiTag(tag, akondiTag));
 
         // WHEN
-        tag->setProperty("tagId", 43);
+        tag->backendIdentity().setId(43);
 
         // THEN
         QVERIFY(!serializer.representsAkonadiTag(tag, akondiTag));
@@ -121,10 +124,10 @@ private slots:
     {
         // GIVEN
         Akonadi::Serializer serializer;
-        auto object = Akonadi::Serializer::QObjectPtr::create();
+        auto object = Domain::Task::Ptr::create();
 
         // WHEN
-        object->setProperty("todoUid", "my-uid");
+        object->backendIdentity().setUid("my-uid");
 
         // THEN
         QCOMPARE(serializer.objectUid(object), QString("my-uid"));
@@ -208,7 +211,7 @@ private slots:
         QCOMPARE(dataSource->iconName(), iconName);
         QCOMPARE(dataSource->contentTypes(), expectedContentTypes);
         QCOMPARE(dataSource->isSelected(), !hasSelectedAttribute || isSelected);
-        QCOMPARE(dataSource->property("collectionId").value<Akonadi::Collection::Id>(), collection.id());
+        QCOMPARE(dataSource->backendIdentity().id(), collection.id());
         QCOMPARE((dataSource->listStatus() & Domain::DataSource::Listed) != 0, isReferenced || isEnabled);
         QCOMPARE((dataSource->listStatus() == Domain::DataSource::Bookmarked), isEnabled);
     }
@@ -380,14 +383,14 @@ private slots:
         source->setContentTypes(contentTypes);
         source->setListStatus(listStatus);
         source->setSelected(isSelected);
-        source->setProperty("collectionId", 42);
+        source->backendIdentity().setId(42);
 
         // WHEN
         Akonadi::Serializer serializer;
         auto collection = serializer.createCollectionFromDataSource(source);
 
         // THEN
-        QCOMPARE(collection.id(), source->property("collectionId").value<Akonadi::Collection::Id>());
+        QCOMPARE(collection.id(), source->backendIdentity().id());
         QVERIFY(collection.hasAttribute<Akonadi::ApplicationSelectedAttribute>());
         QCOMPARE(collection.attribute<Akonadi::ApplicationSelectedAttribute>()->isSelected(), isSelected);
         QVERIFY(collection.hasAttribute<Akonadi::TimestampAttribute>());
@@ -606,9 +609,9 @@ private slots:
         QCOMPARE(task->text(), content);
         QCOMPARE(task->startDate(), startDate);
         QCOMPARE(task->dueDate(), dueDate);
-        QCOMPARE(task->property("todoUid").toString(), todo->uid());
-        QCOMPARE(task->property("relatedUid").toString(), todo->relatedTo());
-        QCOMPARE(task->property("itemId").toLongLong(), item.id());
+        QCOMPARE(task->backendIdentity().uid(), todo->uid());
+        QCOMPARE(task->backendIdentity().relatedUid(), todo->relatedTo());
+        QCOMPARE(task->backendIdentity().id(), item.id());
         QCOMPARE(task->delegate().name(), delegateName);
         QCOMPARE(task->delegate().email(), delegateEmail);
     }
@@ -648,6 +651,73 @@ private slots:
         QVERIFY(task.isNull());
     }
 
+    void shouldCreateTasksFromItems_data()
+    {
+        QTest::addColumn<int>("count");
+
+        QTest::newRow("small batch") << 10;
+        QTest::newRow("large batch") << 200;
+    }
+
+    void shouldCreateTasksFromItems()
+    {
+        // GIVEN
+
+        // Todos, a project and an invalid item...
+        QFETCH(int, count);
+        Akonadi::Item::List items;
+        for (int i = 0; i < count; i++) {
+            KCalCore::Todo::Ptr todo(new KCalCore::Todo);
+            if (i == 1)
+                todo->setCustomProperty("Zanshin", "Project", "1");
+            todo->setSummary(QString("summary %1").arg(i));
+            todo->setDescription(QString("content %1").arg(i));
+            todo->setDtDue(KDateTime(QDate(2014, 03, 01).addDays(i)));
+            todo->setRelatedTo(QString("uid-%1").arg(i));
+            if (i % 5 == 0)
+                todo->recurrence()->setDaily(i + 1);
+
+            // ... as payload of items
+            Akonadi::Item item(i + 1);
+            if (i != 2) {
+                item.setMimeType("application/x-vnd.akonadi.calendar.todo");
+                item.setPayload<KCalCore::Todo::Ptr>(todo);
+            }
+            items << item;
+        }
+
+        // WHEN
+        Akonadi::Serializer serializer;
+        Domain::Task::List tasks = serializer.createTasksFromItems(items);
+
+        // THEN
+        QCOMPARE(tasks.size(), count);
+        for (int i = 0; i < count; i++) {
+            auto task = tasks.at(i);
+            if (i == 1 || i == 2) {
+                QVERIFY(task.isNull());
+                continue;
+            }
+
+            auto expected = serializer.createTaskFromItem(items.at(i));
+            QCOMPARE(task->title(), expected->title());
+            QCOMPARE(task->text(), expected->text());
+            QCOMPARE(task->dueDate(), expected->dueDate());
+            QCOMPARE(task->backendIdentity().id(), items.at(i).id());
+            QCOMPARE(task->backendIdentity().uid(), expected->backendIdentity().uid());
+            QCOMPARE(task->backendIdentity().relatedUid(), expected->backendIdentity().relatedUid());
+
+            if (i % 5 == 0) {
+                QVERIFY(task->recurrence());
+                QCOMPARE(task->recurrence()->frequency(), Domain::Recurrence::Daily);
+                QCOMPARE(task->recurrence()->interval(), i + 1);
+                QCOMPARE(task->recurrence()->thread(), QThread::currentThread());
+            } else {
+                QVERIFY(!task->recurrence());
+            }
+        }
+    }
+
     void shouldUpdateTaskFromItem_data()
     {
         QTest::addColumn<QString>("updatedSummary");
@@ -727,9 +797,9 @@ private slots:
         QCOMPARE(task->text(), updatedContent);
         QCOMPARE(task->startDate(), updatedStartDate);
         QCOMPARE(task->dueDate(), updatedDueDate);
-        QCOMPARE(task->property("todoUid").toString(), updatedTodo->uid());
-        QCOMPARE(task->property("relatedUid").toString(), updatedTodo->relatedTo());
-        QCOMPARE(task->property("itemId").toLongLong(), updatedItem.id());
+        QCOMPARE(task->backendIdentity().uid(), updatedTodo->uid());
+        QCOMPARE(task->backendIdentity().relatedUid(), updatedTodo->relatedTo());
+        QCOMPARE(task->backendIdentity().id(), updatedItem.id());
         QCOMPARE(task->delegate().name(), updatedDelegateName);
         QCOMPARE(task->delegate().email(), updatedDelegateEmail);
     }
@@ -769,7 +839,7 @@ private slots:
         QCOMPARE(task->text(), content);
         QCOMPARE(task->startDate(), startDate);
         QCOMPARE(task->dueDate(), dueDate);
-        QCOMPARE(task->property("itemId").toLongLong(), originalItem.id());
+        QCOMPARE(task->backendIdentity().id(), originalItem.id());
     }
 
     void shouldNotUpdateTaskFromProjectItem()
@@ -815,7 +885,7 @@ private slots:
         QCOMPARE(task->text(), content);
         QCOMPARE(task->startDate(), startDate);
         QCOMPARE(task->dueDate(), dueDate);
-        QCOMPARE(task->property("itemId").toLongLong(), originalItem.id());
+        QCOMPARE(task->backendIdentity().id(), originalItem.id());
     }
 
     void shouldCreateItemFromTask_data()
@@ -869,12 +939,12 @@ private slots:
         task->setDelegate(delegate);
 
         if (itemId > 0)
-            task->setProperty("itemId", itemId);
+            task->backendIdentity().setId(itemId);
 
         if (!todoUid.isEmpty())
-            task->setProperty("todoUid", todoUid);
+            task->backendIdentity().setUid(todoUid);
 
-        task->setProperty("relatedUid", "parent-uid");
+        task->backendIdentity().setRelatedUid("parent-uid");
 
         // WHEN
         Akonadi::Serializer serializer;
@@ -887,6 +957,7 @@ private slots:
         if (itemId > 0) {
             QCOMPARE(item.id(), itemId);
         }
+        QCOMPARE(item.parentCollection().id(), Akonadi::Collection::Id(0));
 
         auto todo = item.payload<KCalCore::Todo::Ptr>();
         QCOMPARE(todo->summary(), summary);
@@ -926,7 +997,7 @@ private slots:
         task->setText(content);
         task->setStartDate(startDate);
         task->setDueDate(dueDate);
-        task->setProperty("todoUid", "1");
+        task->backendIdentity().setUid("1");
 
         // Create Child item
         KCalCore::Todo::Ptr childTodo(new KCalCore::Todo);
@@ -1082,8 +1153,74 @@ private slots:
         // THEN
         QCOMPARE(note->title(), title);
         QCOMPARE(note->text(), text);
-        QCOMPARE(note->property("itemId").toLongLong(), item.id());
-        QCOMPARE(note->property("relatedUid").toString(), relatedUid);
+        QCOMPARE(note->backendIdentity().id(), item.id());
+        QCOMPARE(note->backendIdentity().relatedUid(), relatedUid);
+    }
+
+    void shouldFlagNotesLoadedWithoutTheirBody()
+    {
+        // GIVEN
+
+        // A message with only its headers loaded...
+        KMime::Message::Ptr message(new KMime::Message);
+        message->subject(true)->fromUnicodeString("A note title", "utf-8");
+
+        // ... as payload of an item.
+        Akonadi::Item item;
+        item.setMimeType(Akonadi::NoteUtils::noteMimeType());
+        item.setPayload<KMime::Message::Ptr>(message);
+
+        // WHEN
+        Akonadi::Serializer serializer;
+        Domain::Note::Ptr note = serializer.createNoteFromItem(item);
+
+        // THEN
+        QCOMPARE(note->title(), QString("A note title"));
+        QVERIFY(note->text().isEmpty());
+        QVERIFY(note->backendIdentity().isPartial());
+
+        // WHEN (the body got loaded)
+        message->mainBodyPart()->fromUnicodeString("A note content");
+        item.setPayload<KMime::Message::Ptr>(message);
+        serializer.updateNoteFromItem(note, item);
+
+        // THEN
+        QCOMPARE(note->text(), QString("A note content"));
+        QVERIFY(!note->backendIdentity().isPartial());
+    }
+
+    void shouldKeepTheLoadedBodyOnPartialUpdates()
+    {
+        // GIVEN
+
+        // A note loaded in full...
+        KMime::Message::Ptr message(new KMime::Message);
+        message->subject(true)->fromUnicodeString("A note title", "utf-8");
+        message->mainBodyPart()->fromUnicodeString("A note content");
+
+        Akonadi::Item item(42);
+        item.setMimeType(Akonadi::NoteUtils::noteMimeType());
+        item.setPayload<KMime::Message::Ptr>(message);
+
+        Akonadi::Serializer serializer;
+        Domain::Note::Ptr note = serializer.createNoteFromItem(item);
+        QVERIFY(!note->backendIdentity().isPartial());
+
+        // ... and the same item coming back with only its headers
+        KMime::Message::Ptr headers(new KMime::Message);
+        headers->subject(true)->fromUnicodeString("A new title", "utf-8");
+
+        Akonadi::Item partialItem(42);
+        partialItem.setMimeType(Akonadi::NoteUtils::noteMimeType());
+        partialItem.setPayload<KMime::Message::Ptr>(headers);
+
+        // WHEN
+        serializer.updateNoteFromItem(note, partialItem);
+
+        // THEN
+        QCOMPARE(note->title(), QString("A new title"));
+        QCOMPARE(note->text(), QString("A note content"));
+        QVERIFY(!note->backendIdentity().isPartial());
     }
 
     void shouldCreateNullNoteFromInvalidItem()
@@ -1099,6 +1236,103 @@ private slots:
         QVERIFY(note.isNull());
     }
 
+    void shouldCreateArtifactsFromItems_data()
+    {
+        QTest::addColumn<int>("count");
+
+        QTest::newRow("small batch") << 10;
+        QTest::newRow("large batch") << 200;
+    }
+
+    void shouldCreateArtifactsFromItems()
+    {
+        // GIVEN
+
+        // Interleaved todos and messages, plus an invalid item...
+        QFETCH(int, count);
+        Akonadi::Item::List items;
+        for (int i = 0; i < count; i++) {
+            Akonadi::Item item(i + 1);
+            if (i == 2) {
+                // Left without payload
+            } else if (i % 2 == 0) {
+                KCalCore::Todo::Ptr todo(new KCalCore::Todo);
+                todo->setSummary(QString("task %1").arg(i));
+                item.setMimeType("application/x-vnd.akonadi.calendar.todo");
+                item.setPayload<KCalCore::Todo::Ptr>(todo);
+            } else {
+                KMime::Message::Ptr message(new KMime::Message);
+                message->subject(true)->fromUnicodeString(QString("note %1").arg(i), "utf-8");
+                message->mainBodyPart()->fromUnicodeString(QString("text %1").arg(i));
+                item.setMimeType(Akonadi::NoteUtils::noteMimeType());
+                item.setPayload<KMime::Message::Ptr>(message);
+            }
+            items << item;
+        }
+
+        // WHEN
+        Akonadi::Serializer serializer;
+        Domain::Artifact::List artifacts = serializer.createArtifactsFromItems(items);
+
+        // THEN
+        QCOMPARE(artifacts.size(), count);
+        for (int i = 0; i < count; i++) {
+            auto artifact = artifacts.at(i);
+            if (i == 2) {
+                QVERIFY(artifact.isNull());
+            } else if (i % 2 == 0) {
+                QVERIFY(artifact.objectCast<Domain::Task>());
+                QCOMPARE(artifact->title(), QString("task %1").arg(i));
+                QCOMPARE(artifact->backendIdentity().id(), items.at(i).id());
+            } else {
+                QVERIFY(artifact.objectCast<Domain::Note>());
+                QCOMPARE(artifact->title(), QString("note %1").arg(i));
+                QCOMPARE(artifact->text(), QString("text %1").arg(i));
+                QCOMPARE(artifact->backendIdentity().id(), items.at(i).id());
+            }
+        }
+    }
+
+    void shouldCreateNotesFromItems()
+    {
+        // GIVEN
+
+        // Messages and a todo...
+        Akonadi::Item::List items;
+        for (int i = 0; i < 4; i++) {
+            Akonadi::Item item(i + 1);
+            if (i == 2) {
+                item.setMimeType("application/x-vnd.akonadi.calendar.todo");
+                item.setPayload<KCalCore::Todo::Ptr>(KCalCore::Todo::Ptr(new KCalCore::Todo));
+            } else {
+                KMime::Message::Ptr message(new KMime::Message);
+                message->subject(true)->fromUnicodeString(QString("note %1").arg(i), "utf-8");
+                message->mainBodyPart()->fromUnicodeString(QString("text %1").arg(i));
+                item.setMimeType(Akonadi::NoteUtils::noteMimeType());
+                item.setPayload<KMime::Message::Ptr>(message);
+            }
+            items << item;
+        }
+
+        // WHEN
+        Akonadi::Serializer serializer;
+        Domain::Note::List notes = serializer.createNotesFromItems(items);
+
+        // THEN
+        QCOMPARE(notes.size(), 4);
+        for (int i = 0; i < 4; i++) {
+            auto note = notes.at(i);
+            if (i == 2) {
+                QVERIFY(note.isNull());
+                continue;
+            }
+
+            QCOMPARE(note->title(), QString("note %1").arg(i));
+            QCOMPARE(note->text(), QString("text %1").arg(i));
+            QCOMPARE(note->backendIdentity().id(), items.at(i).id());
+        }
+    }
+
     void shouldUpdateNoteFromItem_data()
     {
         QTest::addColumn<QString>("updatedTitle");
@@ -1159,8 +1393,8 @@ private slots:
         // THEN
         QCOMPARE(note->title(), updatedTitle);
         QCOMPARE(note->text(), updatedText);
-        QCOMPARE(note->property("itemId").toLongLong(), updatedItem.id());
-        QCOMPARE(note->property("relatedUid").toString(), updatedRelatedUid);
+        QCOMPARE(note->backendIdentity().id(), updatedItem.id());
+        QCOMPARE(note->backendIdentity().relatedUid(), updatedRelatedUid);
     }
 
     void shouldNotUpdateNoteFromInvalidItem()
@@ -1193,7 +1427,7 @@ private slots:
         //THEN
         QCOMPARE(note->title(), title);
         QCOMPARE(note->text(), text);
-        QCOMPARE(note->property("itemId").toLongLong(), item.id());
+        QCOMPARE(note->backendIdentity().id(), item.id());
     }
 
     void shouldCreateItemFromNote_data()
@@ -1228,10 +1462,10 @@ private slots:
         note->setText(content);
 
         if (itemId > 0)
-            note->setProperty("itemId", itemId);
+            note->backendIdentity().setId(itemId);
 
         if (!relatedUid.isEmpty())
-            note->setProperty("relatedUid", relatedUid);
+            note->backendIdentity().setRelatedUid(relatedUid);
 
         // WHEN
         Akonadi::Serializer serializer;
@@ -1295,9 +1529,9 @@ private slots:
 
         // THEN
         QCOMPARE(project->name(), summary);
-        QCOMPARE(project->property("itemId").toLongLong(), item.id());
-        QCOMPARE(project->property("parentCollectionId").toLongLong(), collection.id());
-        QCOMPARE(project->property("todoUid").toString(), todo->uid());
+        QCOMPARE(project->backendIdentity().id(), item.id());
+        QCOMPARE(project->backendIdentity().parentId(), collection.id());
+        QCOMPARE(project->backendIdentity().uid(), todo->uid());
     }
 
     void shouldCreateNullProjectFromInvalidItem()
@@ -1388,9 +1622,9 @@ private slots:
 
         // THEN
         QCOMPARE(project->name(), updatedSummary);
-        QCOMPARE(project->property("itemId").toLongLong(), updatedItem.id());
-        QCOMPARE(project->property("parentCollectionId").toLongLong(), updatedCollection.id());
-        QCOMPARE(project->property("todoUid").toString(), updatedTodo->uid());
+        QCOMPARE(project->backendIdentity().id(), updatedItem.id());
+        QCOMPARE(project->backendIdentity().parentId(), updatedCollection.id());
+        QCOMPARE(project->backendIdentity().uid(), updatedTodo->uid());
     }
 
     void shouldNotUpdateProjectFromInvalidItem()
@@ -1484,13 +1718,13 @@ private slots:
         // ... stored in a project
         auto project = Domain::Project::Ptr::create();
         project->setName(summary);
-        project->setProperty("todoUid", todoUid);
+        project->backendIdentity().setUid(todoUid);
 
         if (itemId > 0)
-            project->setProperty("itemId", itemId);
+            project->backendIdentity().setId(itemId);
 
         if (parentCollectionId > 0)
-            project->setProperty("parentCollectionId", parentCollectionId);
+            project->backendIdentity().setParentId(parentCollectionId);
 
         // WHEN
         Akonadi::Serializer serializer;
@@ -1524,7 +1758,7 @@ private slots:
         // Create project
         auto project = Domain::Project::Ptr::create();
         project->setName("project");
-        project->setProperty("todoUid", "1");
+        project->backendIdentity().setUid("1");
 
         // Create unrelated todo
         auto unrelatedTodo = KCalCore::Todo::Ptr::create();
@@ -1600,7 +1834,7 @@ private slots:
         item1.setPayload<KCalCore::Todo::Ptr>(todo1);
 
         Domain::Task::Ptr parent(new Domain::Task);
-        parent->setProperty("todoUid", "1");
+        parent->backendIdentity().setUid("1");
 
         QTest::newRow("nominal case") << item1 << parent << "1";
 
@@ -1641,7 +1875,7 @@ private slots:
         todoItem.setPayload<KCalCore::Todo::Ptr>(todo);
 
         auto parent = Domain::Project::Ptr::create();
-        parent->setProperty("todoUid", "1");
+        parent->backendIdentity().setUid("1");
 
         QTest::newRow("nominal todo case") << todoItem << parent << "1";
 
@@ -1731,6 +1965,10 @@ private slots:
         Akonadi::Item::List items5;
         items5 << item << item2 << item3 << item4;
         QTest::newRow("list with filter in list") << item << items5 << 2;
+
+        Akonadi::Item::List items6;
+        items6 << item4 << item2 << item3;
+        QTest::newRow("list with grandchild before child") << item << items6 << 2;
     }
 
     void shouldFilterChildrenItem()
@@ -1809,7 +2047,7 @@ private slots:
 
         // THEN
         QCOMPARE(context->name(), tag.name());
-        QCOMPARE(context->property("tagId").toLongLong(), tag.id());
+        QCOMPARE(context->backendIdentity().id(), tag.id());
     }
 
     void shouldNotCreateContextFromWrongTagType()
@@ -1855,7 +2093,7 @@ private slots:
 
         // THEN
         QCOMPARE(context->name(), tag.name());
-        QCOMPARE(context->property("tagId").toLongLong(), tag.id());
+        QCOMPARE(context->backendIdentity().id(), tag.id());
     }
 
     void shouldNotUpdateContextFromWrongTagType()
@@ -1876,7 +2114,7 @@ private slots:
 
         // THEN
         QCOMPARE(context->name(), originalTag.name());
-        QCOMPARE(context->property("tagId").toLongLong(), originalTag.id());
+        QCOMPARE(context->backendIdentity().id(), originalTag.id());
     }
 
     void shouldVerifyIfAnItemIsAContextChild_data()
@@ -1887,7 +2125,7 @@ private slots:
 
         // Create a context
         auto context = Domain::Context::Ptr::create();
-        context->setProperty("tagId", qint64(43));
+        context->backendIdentity().setId(qint64(43));
         Akonadi::Tag tag(Akonadi::Tag::Id(43));
 
         Akonadi::Item unrelatedItem;
@@ -1989,7 +2227,7 @@ private slots:
 
         // WHEN
         auto context = Domain::Context::Ptr::create();
-        context->setProperty("tagId", tagId);
+        context->backendIdentity().setId(tagId);
         context->setName(name);
 
         Akonadi::Serializer serializer;
@@ -2039,7 +2277,7 @@ private slots:
 
         // THEN
         QCOMPARE(resultTag->name(), akonadiTag.name());
-        QCOMPARE(resultTag->property("tagId").toLongLong(), akonadiTag.id());
+        QCOMPARE(resultTag->backendIdentity().id(), akonadiTag.id());
     }
 
     void shouldUpdateTagFromAkonadiTag_data()
@@ -2068,7 +2306,7 @@ private slots:
 
         // THEN
         QCOMPARE(tag->name(), akonadiTag.name());
-        QCOMPARE(tag->property("tagId").toLongLong(), akonadiTag.id());
+        QCOMPARE(tag->backendIdentity().id(), akonadiTag.id());
     }
 
     void shouldCreateAkonadiTagFromTag_data()
@@ -2095,7 +2333,7 @@ private slots:
 
         // WHEN
         auto tag = Domain::Tag::Ptr::create();
-        tag->setProperty("tagId", tagId);
+        tag->backendIdentity().setId(tagId);
         tag->setName(name);
 
         Akonadi::Serializer serializer;
@@ -2120,7 +2358,7 @@ private slots:
 
         // Create a Tag
         auto tag = Domain::Tag::Ptr::create();
-        tag->setProperty("tagId", qint64(43));
+        tag->backendIdentity().setId(qint64(43));
         Akonadi::Tag akonadiTag(Akonadi::Tag::Id(43));
 
         Akonadi::Item unrelatedItem;
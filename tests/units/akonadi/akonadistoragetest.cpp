@@ -29,6 +29,7 @@
 
 #include <KCalCore/Todo>
 #include <KCalCore/ICalFormat>
+#include <KMime/Message>
 
 #include "akonadi/qtest_akonadi.h"
 
@@ -36,12 +37,15 @@
 #include <Akonadi/CollectionCreateJob>
 #include <Akonadi/CollectionDeleteJob>
 #include <Akonadi/CollectionModifyJob>
+#include <Akonadi/CollectionMoveJob>
 #include <Akonadi/CollectionStatistics>
 #include <Akonadi/EntityDisplayAttribute>
 #include <Akonadi/ItemCreateJob>
 #include <Akonadi/ItemDeleteJob>
 #include <Akonadi/ItemModifyJob>
 #include <Akonadi/ItemFetchJob>
+#include <Akonadi/KMime/MessageParts>
+#include <Akonadi/Notes/NoteUtils>
 #include <Akonadi/Tag>
 #include <Akonadi/TagCreateJob>
 #include <Akonadi/TagDeleteJob>
@@ -227,7 +231,7 @@ private slots:
                                                 "{7824df00-2fd6-47a4-8319-52659dc82005}" };
 
         // WHEN
-        auto job = storage.fetchItems(calendar2());
+        auto job = storage.fetchFullItems(calendar2());
         AKVERIFYEXEC(job->kjob());
 
         // THEN
@@ -259,6 +263,93 @@ private slots:
         QCOMPARE(itemRemoteIds, expectedRemoteIds);
     }
 
+    void shouldListTasksInFullForLists()
+    {
+        // GIVEN
+        Akonadi::Storage storage;
+
+        // WHEN
+        auto job = storage.fetchItems(calendar2());
+        AKVERIFYEXEC(job->kjob());
+
+        // THEN
+        auto items = job->items();
+        QCOMPARE(items.size(), 4);
+        for (const auto &item : items) {
+            QVERIFY(item.loadedPayloadParts().contains(Akonadi::Item::FullPayload));
+            QVERIFY(!item.tags().isEmpty());
+            QVERIFY(!item.tags().first().type().isEmpty());
+            QCOMPARE(item.parentCollection().id(), calendar2().id());
+        }
+    }
+
+    void shouldHandOverItemsWhileTheyArrive()
+    {
+        // GIVEN
+        Akonadi::Storage storage;
+        storage.setItemBatchSize(1);
+        Akonadi::Item::List receivedItems;
+        int batchCount = 0;
+        bool receivedBeforeResult = true;
+
+        // WHEN
+        auto job = storage.fetchFullItems(calendar2());
+        QSignalSpy resultSpy(job->kjob(), SIGNAL(result(KJob*)));
+        job->installItemsReceivedHandler([&] (const Akonadi::Item::List &items) {
+            receivedItems << items;
+            batchCount++;
+            receivedBeforeResult = receivedBeforeResult && resultSpy.isEmpty();
+        });
+        AKVERIFYEXEC(job->kjob());
+
+        // THEN
+        QVERIFY(receivedBeforeResult);
+        QCOMPARE(batchCount, 4);
+        QCOMPARE(receivedItems.size(), 4);
+        QCOMPARE(job->items().size(), 4);
+    }
+
+    void shouldKeepAttributesAndTodoPayloadsInTheListScope()
+    {
+        // WHEN
+        auto todoScope = Akonadi::Storage::listFetchScope(QStringList() << KCalCore::Todo::todoMimeType());
+        auto noteScope = Akonadi::Storage::listFetchScope(QStringList() << Akonadi::NoteUtils::noteMimeType());
+
+        // THEN
+        QVERIFY(todoScope.allAttributes());
+        QVERIFY(todoScope.fullPayload());
+        QVERIFY(noteScope.allAttributes());
+        QVERIFY(!noteScope.fullPayload());
+    }
+
+    void shouldListNoteHeadersOnlyForLists()
+    {
+        // GIVEN
+        Akonadi::Storage storage;
+
+        // WHEN
+        auto job = storage.fetchItems(notes());
+        AKVERIFYEXEC(job->kjob());
+
+        // THEN
+        auto items = job->items();
+        QCOMPARE(items.size(), 1);
+        auto item = items.first();
+        QVERIFY(item.loadedPayloadParts().contains(Akonadi::MessagePart::Header));
+        QVERIFY(!item.loadedPayloadParts().contains(Akonadi::MessagePart::Body));
+        QCOMPARE(item.payload<KMime::Message::Ptr>()->subject()->asUnicodeString(), QString("21/03/2014 13:49"));
+        QVERIFY(!item.tags().isEmpty());
+
+        // WHEN
+        job = storage.fetchItem(item);
+        AKVERIFYEXEC(job->kjob());
+
+        // THEN
+        QCOMPARE(job->items().size(), 1);
+        item = job->items().first();
+        QVERIFY(item.loadedPayloadParts().contains(Akonadi::MessagePart::Body));
+        QCOMPARE(item.payload<KMime::Message::Ptr>()->body().trimmed(), QByteArray("This is a note"));
+    }
 
     void shouldListTags()
     {
@@ -308,7 +399,7 @@ private slots:
             itemRemoteIds << item.remoteId();
 
             QVERIFY(item.loadedPayloadParts().contains(Akonadi::Item::FullPayload));
-            QVERIFY(!item.attributes().isEmpty());
+            QVERIFY(item.parentCollection().isValid());
             QVERIFY(item.modificationTime().isValid());
             QVERIFY(!item.flags().isEmpty());
         }
@@ -402,6 +493,38 @@ private slots:
         }
     }
 
+    void shouldNotifyCollectionMovedAsChanged()
+    {
+        // GIVEN
+
+        // A collection
+        Akonadi::Collection collection;
+        collection.setParentCollection(calendar2());
+        collection.setName("Moved!");
+        collection.setContentMimeTypes(QStringList() << "application/x-vnd.akonadi.calendar.todo");
+        auto create = new Akonadi::CollectionCreateJob(collection);
+        AKVERIFYEXEC(create);
+        collection = create->collection();
+
+        // A spied monitor
+        Akonadi::MonitorImpl monitor;
+        QSignalSpy spy(&monitor, SIGNAL(collectionChanged(Akonadi::Collection)));
+
+        // WHEN
+        auto job = new Akonadi::CollectionMoveJob(collection, calendar1());
+        AKVERIFYEXEC(job);
+        QTRY_VERIFY(!spy.isEmpty());
+
+        // THEN
+        QCOMPARE(spy.size(), 1);
+        auto notifiedCollection = spy.takeFirst().takeFirst().value<Akonadi::Collection>();
+        QCOMPARE(notifiedCollection.id(), collection.id());
+        QCOMPARE(notifiedCollection.parentCollection().id(), calendar1().id());
+
+        // Restore proper DB state
+        auto remove = new Akonadi::CollectionDeleteJob(collection);
+        AKVERIFYEXEC(remove);
+    }
 
     void shouldNotifyItemAdded()
     {
@@ -434,13 +557,9 @@ private slots:
         QCOMPARE(spy.size(), 1);
         auto notifiedItem = spy.takeFirst().takeFirst().value<Akonadi::Item>();
         QCOMPARE(*notifiedItem.payload<KCalCore::Todo::Ptr>(), *todo);
-        QVERIFY(notifiedItem.hasAttribute<Akonadi::EntityDisplayAttribute>());
 
-        auto parent = notifiedItem.parentCollection();
-        while (parent != Akonadi::Collection::root()) {
-            QVERIFY(parent.isValid());
-            parent = parent.parentCollection();
-        }
+        // Same scope as the lists, only the parent comes along
+        QCOMPARE(notifiedItem.parentCollection(), calendar2());
     }
 
     void shouldNotifyItemRemoved()
@@ -499,13 +618,9 @@ private slots:
         auto notifiedItem = spy.takeFirst().takeFirst().value<Akonadi::Item>();
         QCOMPARE(notifiedItem.id(), item.id());
         QCOMPARE(*notifiedItem.payload<KCalCore::Todo::Ptr>(), *todo);
-        QVERIFY(notifiedItem.hasAttribute<Akonadi::EntityDisplayAttribute>());
 
-        auto parent = notifiedItem.parentCollection();
-        while (parent != Akonadi::Collection::root()) {
-            QVERIFY(parent.isValid());
-            parent = parent.parentCollection();
-        }
+        // Same scope as the lists, only the parent comes along
+        QCOMPARE(notifiedItem.parentCollection(), calendar2());
     }
 
     void shouldNotifyItemTagAdded()
@@ -545,13 +660,112 @@ private slots:
             QVERIFY(!tag.type().isEmpty());
         }
 
-        auto parent = notifiedItem.parentCollection();
-        while (parent != Akonadi::Collection::root()) {
-            QVERIFY(parent.isValid());
-            parent = parent.parentCollection();
+        // Same scope as the lists, only the parent comes along
+        QCOMPARE(notifiedItem.parentCollection(), calendar2());
+    }
+
+
+    void shouldNotifyItemFlagsChanged()
+    {
+        // GIVEN
+
+        // A spied monitor
+        Akonadi::MonitorImpl monitor;
+        QSignalSpy spy(&monitor, SIGNAL(itemChanged(Akonadi::Item)));
+
+        // An existing item (if we trust the test data)...
+        Akonadi::Item item = fetchItemByRID("{1d33862f-f274-4c67-ab6c-362d56521ff5}", calendar2());
+        QVERIFY(item.isValid());
+
+        // WHEN
+        item.setFlag("$ZANSHINTEST");
+        auto job = new Akonadi::ItemModifyJob(item);
+        AKVERIFYEXEC(job);
+        QTRY_VERIFY(!spy.isEmpty());
+
+        // THEN
+        // Notified with its payload like any other change
+        QCOMPARE(spy.size(), 1);
+        auto notifiedItem = spy.takeFirst().takeFirst().value<Akonadi::Item>();
+        QCOMPARE(notifiedItem.id(), item.id());
+        QVERIFY(notifiedItem.hasFlag("$ZANSHINTEST"));
+        QVERIFY(notifiedItem.hasPayload<KCalCore::Todo::Ptr>());
+    }
+
+    void shouldNotNotifyItemsRejectedByTheFilter()
+    {
+        // GIVEN
+
+        // A spied monitor not interested in anything
+        Akonadi::MonitorImpl monitor;
+        monitor.setItemFilter([] (const Akonadi::Item &) { return false; });
+        QSignalSpy spy(&monitor, SIGNAL(itemChanged(Akonadi::Item)));
+
+        // A todo...
+        KCalCore::Todo::Ptr todo(new KCalCore::Todo);
+        todo->setSummary("summary");
+        todo->setDescription("content");
+        todo->setCompleted(false);
+        todo->setDtStart(KDateTime(QDate(2013, 11, 24)));
+        todo->setDtDue(KDateTime(QDate(2014, 03, 01)));
+
+        // ... as payload of an existing item (if we trust the test data)...
+        Akonadi::Item item = fetchItemByRID("{1d33862f-f274-4c67-ab6c-362d56521ff6}", calendar2());
+        QVERIFY(item.isValid());
+        item.setMimeType("application/x-vnd.akonadi.calendar.todo");
+        item.setPayload<KCalCore::Todo::Ptr>(todo);
+
+        // WHEN
+        auto job = new Akonadi::ItemModifyJob(item);
+        AKVERIFYEXEC(job);
+
+        for (int i = 0; i < 10; i++) {
+            if (!spy.isEmpty()) break;
+            QTest::qWait(50);
         }
+
+        // THEN
+        QVERIFY(spy.isEmpty());
     }
 
+    void shouldNotifyKeptItemsWithTheirPayload()
+    {
+        // GIVEN
+
+        // A spied monitor only interested in the second calendar
+        Akonadi::MonitorImpl monitor;
+        const auto collectionId = calendar2().id();
+        monitor.setItemFilter([collectionId] (const Akonadi::Item &item) {
+            return item.parentCollection().id() == collectionId;
+        });
+        QSignalSpy spy(&monitor, SIGNAL(itemChanged(Akonadi::Item)));
+
+        // A todo...
+        KCalCore::Todo::Ptr todo(new KCalCore::Todo);
+        todo->setSummary("summary");
+        todo->setDescription("content");
+        todo->setCompleted(false);
+        todo->setDtStart(KDateTime(QDate(2013, 11, 24)));
+        todo->setDtDue(KDateTime(QDate(2014, 03, 01)));
+
+        // ... as payload of an existing item of that calendar (if we trust the test data)...
+        Akonadi::Item item = fetchItemByRID("{1d33862f-f274-4c67-ab6c-362d56521ff6}", calendar2());
+        QVERIFY(item.isValid());
+        item.setMimeType("application/x-vnd.akonadi.calendar.todo");
+        item.setPayload<KCalCore::Todo::Ptr>(todo);
+
+        // WHEN
+        auto job = new Akonadi::ItemModifyJob(item);
+        AKVERIFYEXEC(job);
+        QTRY_VERIFY(!spy.isEmpty());
+
+        // THEN
+        QCOMPARE(spy.size(), 1);
+        auto notifiedItem = spy.takeFirst().takeFirst().value<Akonadi::Item>();
+        QCOMPARE(notifiedItem.id(), item.id());
+        QVERIFY(notifiedItem.hasPayload<KCalCore::Todo::Ptr>());
+        QCOMPARE(*notifiedItem.payload<KCalCore::Todo::Ptr>(), *todo);
+    }
 
     void shouldNotifyTagAdded()
     {
@@ -1316,6 +1530,11 @@ private:
     {
         return fetchCollectionByRID("{14096930-7bfe-46ca-8fba-7c04d3b62ec8}");
     }
+
+    Akonadi::Collection notes()
+    {
+        return fetchCollectionByRID("{f5e3f1be-b998-4c56-aa3d-e3a6e7e5493a}");
+    }
 };
 
 QTEST_MAIN(AkonadiStorageTest)
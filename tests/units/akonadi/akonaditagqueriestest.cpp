@@ -135,6 +135,7 @@ private slots:
 
         monitor->addTag(akonadiTag1);
         monitor->addTag(akonadiTag2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchTags).when().exactly(1));
@@ -191,6 +192,7 @@ private slots:
 
         // WHEN
         monitor->removeTag(akonadiTag2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchTags).when().exactly(1));
@@ -247,6 +249,7 @@ private slots:
         // WHEN
         akonadiTag2.setName("newTag43");
         monitor->changeTag(akonadiTag2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchTags).when().exactly(1));
@@ -317,12 +320,10 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::isNoteItem).when(item4).thenReturn(true);
 
         serializerMock(&Akonadi::SerializerInterface::createAkonadiTagFromTag).when(tag).thenReturn(akonadiTag);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).thenReturn(task1);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).thenReturn(task2);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item3).thenReturn(Domain::Task::Ptr());
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item4).thenReturn(Domain::Task::Ptr());
-        serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item3).thenReturn(note3);
-        serializerMock(&Akonadi::SerializerInterface::createNoteFromItem).when(item4).thenReturn(note4);
+        serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item1)
+                                                                               .thenReturn(Domain::Artifact::List() << task1);
+        serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item3)
+                                                                               .thenReturn(Domain::Artifact::List() << note3);
 
         // Serializer mock returning if tag is hold by the items
         serializerMock(&Akonadi::SerializerInterface::isTagChild).when(tag, item1).thenReturn(true);
@@ -344,6 +345,8 @@ private slots:
         QTest::qWait(150);
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col1).exactly(1));
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col2).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item1).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createArtifactsFromItems).when(Akonadi::Item::List() << item3).exactly(1));
 
         QCOMPARE(result->data().size(), 2);
         QCOMPARE(result->data().at(0).objectCast<Domain::Task>(), task1);
@@ -410,6 +413,7 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::isNoteItem).when(item1).thenReturn(false);
 
         monitor->addItem(item1);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col1).exactly(1));
@@ -479,6 +483,7 @@ private slots:
 
         // WHEN
         monitor->changeItem(item1);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(serializerMock(&Akonadi::SerializerInterface::isTagChild).when(tag, item1).exactly(2));
@@ -75,7 +75,7 @@ private slots:
         // GIVEN
         Akonadi::Tag akonadiTag(42);
         auto tag = Domain::Tag::Ptr::create();
-        tag->setProperty("tagId", qint64(42)); // must be set
+        tag->backendIdentity().setId(42); // must be set
         tag->setName("42");
 
         // A mock of removal job
@@ -25,6 +25,8 @@
 
 #include <mockitopp/mockitopp.hpp>
 
+#include <KCalCore/Todo>
+
 #include "testlib/akonadimocks.h"
 
 #include "akonadi/akonaditaskqueries.h"
@@ -86,9 +88,10 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::isTaskItem).when(item2).thenReturn(true);
         serializerMock(&Akonadi::SerializerInterface::isTaskItem).when(item3).thenReturn(true);
 
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).thenReturn(task1);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).thenReturn(task2);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item3).thenReturn(task3);
+        serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1)
+                                                                           .thenReturn(Domain::Task::List() << task1);
+        serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item2 << item3)
+                                                                           .thenReturn(Domain::Task::List() << task2 << task3);
 
         // WHEN
         QScopedPointer<Domain::TaskQueries> queries(new Akonadi::TaskQueries(&storageMock.getInstance(),
@@ -107,9 +110,8 @@ private slots:
                                                                          .exactly(1));
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col1).exactly(1));
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col2).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item3).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item2 << item3).exactly(1));
 
         QCOMPARE(result->data().size(), 3);
         QCOMPARE(result->data().at(0), task1);
@@ -155,6 +157,10 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).thenReturn(task1);
         serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).thenReturn(task2);
 
+        // Only the tasks get converted, all in one go
+        serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1)
+                                                                           .thenReturn(Domain::Task::List() << task1);
+
         // Serializer mock returning if the item has a relatedItem
         serializerMock(&Akonadi::SerializerInterface::relatedUidFromItem).when(item1).thenReturn(QString());
 
@@ -172,7 +178,8 @@ private slots:
                                                                                Akonadi::StorageInterface::Tasks)
                                                                          .exactly(1));
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).exactly(0));
         QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).exactly(0));
 
         QCOMPARE(result->data().size(), 1);
@@ -219,6 +226,7 @@ private slots:
 
         monitor->addItem(item1);
         monitor->addItem(item2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -270,9 +278,8 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::isTaskItem).when(item2).thenReturn(true);
         serializerMock(&Akonadi::SerializerInterface::isTaskItem).when(item3).thenReturn(true);
 
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).thenReturn(task1);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).thenReturn(task2);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item3).thenReturn(task3);
+        serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1 << item2 << item3)
+                                                                           .thenReturn(Domain::Task::List() << task1 << task2 << task3);
 
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(task1, item2).thenReturn(false);
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(task2, item2).thenReturn(true);
@@ -290,6 +297,7 @@ private slots:
 
         // WHEN
         monitor->removeItem(item2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -297,9 +305,7 @@ private slots:
                                                                                Akonadi::StorageInterface::Tasks)
                                                                          .exactly(1));
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item3).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1 << item2 << item3).exactly(1));
 
         QCOMPARE(result->data().size(), 2);
         QCOMPARE(result->data().at(0), task1);
@@ -344,9 +350,8 @@ private slots:
         serializerMock(&Akonadi::SerializerInterface::isTaskItem).when(item2).thenReturn(true);
         serializerMock(&Akonadi::SerializerInterface::isTaskItem).when(item3).thenReturn(true);
 
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).thenReturn(task1);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).thenReturn(task2);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item3).thenReturn(task3);
+        serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1 << item2 << item3)
+                                                                           .thenReturn(Domain::Task::List() << task1 << task2 << task3);
         serializerMock(&Akonadi::SerializerInterface::updateTaskFromItem).when(task2, item2).thenReturn();
 
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(task1, item2).thenReturn(false);
@@ -376,6 +381,7 @@ private slots:
 
         // WHEN
         monitor->changeItem(item2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -383,9 +389,7 @@ private slots:
                                                                                Akonadi::StorageInterface::Tasks)
                                                                          .exactly(1));
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item3).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1 << item2 << item3).exactly(1));
         QVERIFY(serializerMock(&Akonadi::SerializerInterface::updateTaskFromItem).when(task2, item2).exactly(1));
 
         QCOMPARE(result->data().size(), 3);
@@ -585,6 +589,7 @@ private slots:
 
         monitor->addItem(item2);
         monitor->addItem(item3);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).exactly(1));
@@ -658,6 +663,7 @@ private slots:
         // WHEN
         serializerMock(&Akonadi::SerializerInterface::updateTaskFromItem).when(task2, item2).thenReturn();
         monitor->changeItem(item2);
+        QTest::qWait(150);
 
         // Then
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
@@ -731,6 +737,7 @@ private slots:
 
         // WHEN
         monitor->changeItem(item2);
+        QTest::qWait(150);
 
         // Then
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
@@ -806,6 +813,7 @@ private slots:
         // WHEN
         serializerMock(&Akonadi::SerializerInterface::relatedUidFromItem).when(item2).thenReturn("1");
         monitor->changeItem(item2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
@@ -906,6 +914,7 @@ private slots:
 
         // WHEN
         monitor->changeItem(item3); // Now gets a different related id
+        QTest::qWait(150);
 
         // Then
         QCOMPARE(result1->data().size(), 0);
@@ -971,6 +980,7 @@ private slots:
         // WHEN
         serializerMock(&Akonadi::SerializerInterface::updateTaskFromItem).when(task2, item2).thenReturn();
         monitor->removeItem(item2);
+        QTest::qWait(150);
 
         // Then
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
@@ -982,6 +992,80 @@ private slots:
         QCOMPARE(result->data().at(0), task3);
     }
 
+    void shouldHintWhichTasksMayHaveChildren()
+    {
+        // GIVEN
+
+        // One top level collections
+        Akonadi::Collection col(42);
+        col.setParentCollection(Akonadi::Collection::root());
+
+        // Two tasks in the collection, the second one being a child of the first one
+        KCalCore::Todo::Ptr todo1(new KCalCore::Todo);
+        todo1->setUid("uid1");
+        Akonadi::Item item1(42);
+        item1.setParentCollection(col);
+        item1.setPayload<KCalCore::Todo::Ptr>(todo1);
+        Domain::Task::Ptr task1(new Domain::Task);
+        task1->backendIdentity().setParentId(col.id());
+        task1->backendIdentity().setUid("uid1");
+
+        KCalCore::Todo::Ptr todo2(new KCalCore::Todo);
+        todo2->setUid("uid2");
+        todo2->setRelatedTo("uid1");
+        Akonadi::Item item2(43);
+        item2.setParentCollection(col);
+        item2.setPayload<KCalCore::Todo::Ptr>(todo2);
+        Domain::Task::Ptr task2(new Domain::Task);
+        task2->backendIdentity().setParentId(col.id());
+        task2->backendIdentity().setUid("uid2");
+
+        // One task which was never stored
+        Domain::Task::Ptr task3(new Domain::Task);
+
+        MockItemFetchJob *itemFetchJob = new MockItemFetchJob(this);
+        itemFetchJob->setItems(Akonadi::Item::List() << item1 << item2);
+
+        // Storage mock returning the fetch jobs
+        mock_object<Akonadi::StorageInterface> storageMock;
+        storageMock(&Akonadi::StorageInterface::fetchItems).when(col)
+                                                           .thenReturn(itemFetchJob);
+
+        // Serializer mock
+        mock_object<Akonadi::SerializerInterface> serializerMock;
+
+        // Monitor mock
+        MockMonitor *monitor = new MockMonitor(this);
+
+        QScopedPointer<Domain::TaskQueries> queries(new Akonadi::TaskQueries(&storageMock.getInstance(),
+                                                                             &serializerMock.getInstance(),
+                                                                             monitor));
+
+        // WHEN
+        const bool task1MayHaveChildrenBeforeFetch = queries->mayHaveChildren(task1);
+        const bool task2MayHaveChildrenBeforeFetch = queries->mayHaveChildren(task2);
+
+        // THEN
+        QVERIFY(task1MayHaveChildrenBeforeFetch);
+        QVERIFY(task2MayHaveChildrenBeforeFetch);
+        QVERIFY(!queries->mayHaveChildren(task3));
+
+        // WHEN
+        QTest::qWait(150);
+
+        // THEN
+        QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
+        QVERIFY(queries->mayHaveChildren(task1));
+        QVERIFY(!queries->mayHaveChildren(task2));
+
+        // WHEN
+        monitor->removeItem(item2);
+
+        // THEN
+        QVERIFY(!queries->mayHaveChildren(task1));
+        QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
+    }
+
     void shouldLookInAllReportedForTopLevelTasks()
     {
         // GIVEN
@@ -1024,8 +1108,10 @@ private slots:
 
         // Serializer mock returning the tasks from the items
         mock_object<Akonadi::SerializerInterface> serializerMock;
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).thenReturn(task1);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).thenReturn(task2);
+        serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1)
+                                                                           .thenReturn(Domain::Task::List() << task1);
+        serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item2)
+                                                                           .thenReturn(Domain::Task::List() << task2);
 
         // Serializer mock returning if the item has a relatedItem
         serializerMock(&Akonadi::SerializerInterface::relatedUidFromItem).when(item1).thenReturn(QString());
@@ -1049,8 +1135,8 @@ private slots:
                                                                          .exactly(1));
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col1).exactly(1));
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col2).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item2).exactly(1));
 
         QCOMPARE(result->data().size(), 2);
         QCOMPARE(result->data().at(0), task1);
@@ -1097,6 +1183,7 @@ private slots:
 
         monitor->addItem(item1);
         monitor->addItem(item2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -1144,8 +1231,8 @@ private slots:
 
         // Serializer mock returning the tasks from the items
         mock_object<Akonadi::SerializerInterface> serializerMock;
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).thenReturn(task1);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).thenReturn(task2);
+        serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1 << item2)
+                                                                           .thenReturn(Domain::Task::List() << task1 << task2);
 
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(task1, item2).thenReturn(false);
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(task2, item2).thenReturn(true);
@@ -1168,6 +1255,7 @@ private slots:
 
         // WHEN
         monitor->removeItem(item2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -1175,8 +1263,7 @@ private slots:
                                                                                Akonadi::StorageInterface::Tasks)
                                                                          .exactly(1));
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1 << item2).exactly(1));
 
         QCOMPARE(result->data().size(), 1);
     }
@@ -1215,8 +1302,8 @@ private slots:
 
         // Serializer mock returning the tasks from the items
         mock_object<Akonadi::SerializerInterface> serializerMock;
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).thenReturn(task1);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).thenReturn(task2);
+        serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1 << item2)
+                                                                           .thenReturn(Domain::Task::List() << task1 << task2);
         serializerMock(&Akonadi::SerializerInterface::updateTaskFromItem).when(task2, item2).thenReturn();
 
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(task1, item2).thenReturn(false);
@@ -1246,6 +1333,7 @@ private slots:
 
         // WHEN
         monitor->changeItem(item2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -1253,8 +1341,7 @@ private slots:
                                                                                Akonadi::StorageInterface::Tasks)
                                                                          .exactly(1));
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1 << item2).exactly(1));
         QVERIFY(serializerMock(&Akonadi::SerializerInterface::updateTaskFromItem).when(task2, item2).exactly(1));
 
         QCOMPARE(result->data().size(), 2);
@@ -1297,8 +1384,8 @@ private slots:
 
         // Serializer mock returning the tasks from the items
         mock_object<Akonadi::SerializerInterface> serializerMock;
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).thenReturn(task1);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).thenReturn(task2);
+        serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1 << item2)
+                                                                           .thenReturn(Domain::Task::List() << task1 << task2);
 
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(task1, item2).thenReturn(false);
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(task2, item2).thenReturn(true);
@@ -1321,6 +1408,7 @@ private slots:
 
         // WHEN
         monitor->changeItem(item2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -1328,8 +1416,7 @@ private slots:
                                                                                Akonadi::StorageInterface::Tasks)
                                                                          .exactly(1));
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1 << item2).exactly(1));
 
         QCOMPARE(result->data().size(), 1);
         QCOMPARE(result->data().at(0), task1);
@@ -1369,7 +1456,8 @@ private slots:
 
         // Serializer mock returning the tasks from the items
         mock_object<Akonadi::SerializerInterface> serializerMock;
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).thenReturn(task1);
+        serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1)
+                                                                           .thenReturn(Domain::Task::List() << task1);
         serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).thenReturn(task2);
 
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(task1, item2).thenReturn(false);
@@ -1393,6 +1481,7 @@ private slots:
 
         // WHEN
         monitor->changeItem(item2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -1400,7 +1489,7 @@ private slots:
                                                                                Akonadi::StorageInterface::Tasks)
                                                                          .exactly(1));
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1).exactly(1));
         QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).exactly(1));
 
         QCOMPARE(result->data().size(), 2);
@@ -1450,8 +1539,8 @@ private slots:
         // Serializer mock returning the tasks from the items
         mock_object<Akonadi::SerializerInterface> serializerMock;
         serializerMock(&Akonadi::SerializerInterface::createItemFromTask).when(task2).thenReturn(item2);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).thenReturn(task1);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).thenReturn(task2);
+        serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1 << item2)
+                                                                           .thenReturn(Domain::Task::List() << task1 << task2);
         serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item3).thenReturn(task3);
 
         serializerMock(&Akonadi::SerializerInterface::representsItem).when(task1, item2).thenReturn(false);
@@ -1484,6 +1573,7 @@ private slots:
 
         // WHEN
         monitor->removeItem(item2);
+        QTest::qWait(150);
 
         // THEN
         QVERIFY(storageMock(static_cast<Akonadi::CollectionFetchJobInterface* (Akonadi::StorageInterface::*)(Akonadi::Collection, Akonadi::StorageInterface::FetchDepth, Akonadi::StorageInterface::FetchContentTypes)>(&Akonadi::StorageInterface::fetchCollections)).when(Akonadi::Collection::root(),
@@ -1491,8 +1581,7 @@ private slots:
                                                                                Akonadi::StorageInterface::Tasks)
                                                                          .exactly(1));
         QVERIFY(storageMock(&Akonadi::StorageInterface::fetchItems).when(col).exactly(2));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item1).exactly(1));
-        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(item2).exactly(1));
+        QVERIFY(serializerMock(&Akonadi::SerializerInterface::createTasksFromItems).when(Akonadi::Item::List() << item1 << item2).exactly(1));
 
         QCOMPARE(resultChild->data().size(), 0);
         QCOMPARE(result->data().size(), 1); // FIXME: Should become 2 once we got a proper cache in place
@@ -0,0 +1,82 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include <QtTest>
+
+#include "domain/backendidentity.h"
+#include "domain/task.h"
+
+using namespace Domain;
+
+class BackendIdentityTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void shouldHaveEmptyPropertiesByDefault()
+    {
+        BackendIdentity identity;
+        QVERIFY(!identity.hasId());
+        QCOMPARE(identity.id(), qint64(-1));
+        QVERIFY(!identity.hasParentId());
+        QCOMPARE(identity.parentId(), qint64(-1));
+        QVERIFY(identity.uid().isNull());
+        QVERIFY(identity.relatedUid().isNull());
+    }
+
+    void shouldStoreValues()
+    {
+        BackendIdentity identity;
+        identity.setId(42);
+        identity.setParentId(0);
+        identity.setUid("foo");
+        identity.setRelatedUid("bar");
+
+        QVERIFY(identity.hasId());
+        QCOMPARE(identity.id(), qint64(42));
+        QVERIFY(identity.hasParentId());
+        QCOMPARE(identity.parentId(), qint64(0));
+        QCOMPARE(identity.uid(), QString("foo"));
+        QCOMPARE(identity.relatedUid(), QString("bar"));
+    }
+
+    void shouldNotBeCopiedWithTasks()
+    {
+        Task t1;
+        t1.backendIdentity().setId(42);
+        t1.backendIdentity().setUid("foo");
+
+        Task t2(t1);
+        QVERIFY(!t2.backendIdentity().hasId());
+        QVERIFY(t2.backendIdentity().uid().isNull());
+
+        Task t3;
+        t3 = t1;
+        QVERIFY(!t3.backendIdentity().hasId());
+        QVERIFY(t3.backendIdentity().uid().isNull());
+    }
+};
+
+QTEST_MAIN(BackendIdentityTest)
+
+#include "backendidentitytest.moc"
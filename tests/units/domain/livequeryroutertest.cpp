@@ -0,0 +1,260 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include <QtTest>
+
+#include "domain/livequeryrouter.h"
+
+using namespace Domain;
+
+typedef Domain::LiveQuery<QObject*, QString> ObjectQuery;
+typedef Domain::LiveQueryRouter<QObject*, QString, QString> ObjectRouter;
+
+class LiveQueryRouterTest : public QObject
+{
+    Q_OBJECT
+private:
+    QObject *createObject(int id, const QString &name, const QString &parentName)
+    {
+        QObject *obj = new QObject(this);
+        obj->setObjectName(name);
+        obj->setProperty("objectId", id);
+        obj->setProperty("parentName", parentName);
+        return obj;
+    }
+
+    ObjectQuery::Ptr createQuery(const QString &parentName, int *predicateCalls,
+                                 const QList<QObject*> &initialObjects = QList<QObject*>())
+    {
+        auto query = ObjectQuery::Ptr::create();
+        query->setFetchFunction([initialObjects] (const ObjectQuery::AddFunction &add) {
+            for (auto object : initialObjects)
+                add(object);
+        });
+        query->setConvertFunction([] (QObject *object) {
+            return object->objectName();
+        });
+        query->setUpdateFunction([] (QObject *object, QString &output) {
+            output = object->objectName();
+        });
+        query->setPredicateFunction([parentName, predicateCalls] (QObject *object) {
+            (*predicateCalls)++;
+            return parentName.isEmpty() || object->property("parentName").toString() == parentName;
+        });
+        query->setKeyFunction([] (QObject *object) {
+            return object->property("objectId").toLongLong();
+        });
+        return query;
+    }
+
+    void setupRouter(ObjectRouter &router)
+    {
+        router.setRouteFunction([] (QObject *object) {
+            return object->property("parentName").toString();
+        });
+        router.setKeyFunction([] (QObject *object) {
+            return object->property("objectId").toLongLong();
+        });
+    }
+
+private slots:
+    void shouldOnlyWakeTheQueryOfTheRoute()
+    {
+        // GIVEN
+        int callsA = 0, callsB = 0;
+        ObjectRouter router;
+        setupRouter(router);
+        auto queryA = createQuery("A", &callsA);
+        auto queryB = createQuery("B", &callsB);
+        router.addQuery("A", queryA);
+        router.addQuery("B", queryB);
+        auto resultA = queryA->result();
+        auto resultB = queryB->result();
+
+        // WHEN
+        router.onAdded(createObject(1, "1", "A"));
+        router.onAdded(createObject(2, "2", "C"));
+
+        // THEN
+        QCOMPARE(callsA, 1);
+        QCOMPARE(callsB, 0);
+        QCOMPARE(resultA->data(), QList<QString>() << "1");
+        QVERIFY(resultB->data().isEmpty());
+        QCOMPARE(router.query("A"), queryA);
+        QCOMPARE(router.query("B"), queryB);
+        QVERIFY(!router.query("C"));
+    }
+
+    void shouldNotifyThePreviousRouteWhenAnInputMoves()
+    {
+        // GIVEN
+        int callsA = 0, callsB = 0;
+        ObjectRouter router;
+        setupRouter(router);
+        auto queryA = createQuery("A", &callsA);
+        auto queryB = createQuery("B", &callsB);
+        router.addQuery("A", queryA);
+        router.addQuery("B", queryB);
+        auto resultA = queryA->result();
+        auto resultB = queryB->result();
+        auto object = createObject(1, "1", "A");
+        router.onAdded(object);
+
+        // WHEN
+        object->setProperty("parentName", "B");
+        router.onChanged(object);
+
+        // THEN
+        QVERIFY(resultA->data().isEmpty());
+        QCOMPARE(resultB->data(), QList<QString>() << "1");
+
+        // WHEN
+        object->setObjectName("1'");
+        router.onChanged(object);
+
+        // THEN
+        QCOMPARE(callsA, 2);
+        QCOMPARE(callsB, 2);
+        QVERIFY(resultA->data().isEmpty());
+        QCOMPARE(resultB->data(), QList<QString>() << "1'");
+    }
+
+    void shouldRemoveFromTheQueryHoldingTheInput()
+    {
+        // GIVEN
+        int callsA = 0, callsB = 0;
+        ObjectRouter router;
+        setupRouter(router);
+        auto queryA = createQuery("A", &callsA);
+        auto queryB = createQuery("B", &callsB);
+        router.addQuery("A", queryA);
+        router.addQuery("B", queryB);
+        auto resultA = queryA->result();
+        auto resultB = queryB->result();
+        router.onAdded(createObject(1, "1", "A"));
+        router.onAdded(createObject(2, "2", "B"));
+
+        // WHEN
+        // Removal notifications don't necessarily carry the route anymore
+        router.onRemoved(createObject(1, "1", QString()));
+
+        // THEN
+        QVERIFY(resultA->data().isEmpty());
+        QCOMPARE(resultB->data(), QList<QString>() << "2");
+    }
+
+    void shouldFollowTrackedInputs()
+    {
+        // GIVEN
+        int callsA = 0, callsB = 0;
+        ObjectRouter router;
+        setupRouter(router);
+        auto object = createObject(1, "1", "A");
+        auto queryA = createQuery("A", &callsA, QList<QObject*>() << object);
+        auto queryB = createQuery("B", &callsB);
+        router.addQuery("A", queryA);
+        router.addQuery("B", queryB);
+        auto resultA = queryA->result();
+        auto resultB = queryB->result();
+        router.track(object);
+        QCOMPARE(resultA->data(), QList<QString>() << "1");
+
+        // WHEN
+        object->setProperty("parentName", "B");
+        router.onChanged(object);
+
+        // THEN
+        QVERIFY(resultA->data().isEmpty());
+        QCOMPARE(resultB->data(), QList<QString>() << "1");
+    }
+
+    void shouldRouteExplicitly()
+    {
+        // GIVEN
+        int callsA = 0, callsB = 0;
+        ObjectRouter router;
+        router.setKeyFunction([] (QObject *object) {
+            return object->property("objectId").toLongLong();
+        });
+        auto queryA = createQuery("A", &callsA);
+        auto queryB = createQuery("B", &callsB);
+        router.addQuery("A", queryA);
+        router.addQuery("B", queryB);
+        auto resultA = queryA->result();
+        auto resultB = queryB->result();
+        auto object = createObject(1, "1", "A");
+
+        // WHEN
+        router.onAdded(object, "A");
+        object->setProperty("parentName", "B");
+        router.onChanged(object, "B");
+
+        // THEN
+        QVERIFY(resultA->data().isEmpty());
+        QCOMPARE(resultB->data(), QList<QString>() << "1");
+
+        // WHEN
+        router.onRemoved(object);
+
+        // THEN
+        QVERIFY(resultB->data().isEmpty());
+    }
+
+    void shouldNotifyUnroutedQueriesOfEverything()
+    {
+        // GIVEN
+        int calls = 0, callsA = 0;
+        ObjectRouter router;
+        setupRouter(router);
+        auto query = createQuery(QString(), &calls);
+        auto queryA = createQuery("A", &callsA);
+        router.addQuery(query);
+        router.addQuery("A", queryA);
+        auto result = query->result();
+        auto resultA = queryA->result();
+        auto object1 = createObject(1, "1", "A");
+        auto object2 = createObject(2, "2", "B");
+
+        // WHEN
+        router.onAdded(object1);
+        router.onAdded(object2);
+
+        // THEN
+        QCOMPARE(result->data(), QList<QString>() << "1" << "2");
+        QCOMPARE(resultA->data(), QList<QString>() << "1");
+        QCOMPARE(router.queries().size(), 2);
+
+        // WHEN
+        router.onRemoved(object1);
+        router.onRemoved(object2);
+
+        // THEN
+        QVERIFY(result->data().isEmpty());
+        QVERIFY(resultA->data().isEmpty());
+    }
+};
+
+QTEST_MAIN(LiveQueryRouterTest)
+
+#include "livequeryroutertest.moc"
@@ -25,6 +25,7 @@
 
 #include "domain/livequery.h"
 
+#include "utils/delayedcall.h"
 #include "utils/jobhandler.h"
 
 #include "testlib/fakejob.h"
@@ -383,6 +384,531 @@ private slots:
         QVERIFY(!replaceHandlerCalled);
     }
 
+    void shouldUseKeyIndexInsteadOfRepresentsWhenAvailable()
+    {
+        // GIVEN
+        Domain::LiveQuery<QObject*, QPair<int, QString>> query;
+        query.setFetchFunction([this] (const Domain::LiveQuery<QObject*, QString>::AddFunction &add) {
+            Utils::JobHandler::install(new FakeJob, [this, add] {
+                add(createObject(0, "0A"));
+                add(createObject(1, "1A"));
+                add(createObject(2, "0B"));
+                add(createObject(3, "0C"));
+                add(createObject(4, "0D"));
+            });
+        });
+        query.setConvertFunction([] (QObject *object) {
+            return QPair<int, QString>(object->property("objectId").toInt(), object->objectName());
+        });
+        query.setUpdateFunction([] (QObject *object, QPair<int, QString> &output) {
+            output.second = object->objectName();
+        });
+        query.setPredicateFunction([] (QObject *object) {
+            return object->objectName().startsWith('0');
+        });
+        int representsCount = 0;
+        query.setRepresentsFunction([&representsCount] (QObject *object, const QPair<int, QString> &output) {
+            representsCount++;
+            return object->property("objectId").toInt() == output.first;
+        });
+        query.setKeyFunction([] (QObject *object) {
+            return object->property("objectId").toLongLong();
+        });
+
+        Domain::QueryResult<QPair<int, QString>>::Ptr result = query.result();
+        QTest::qWait(150);
+        QList<QPair<int, QString>> expected;
+        expected << QPair<int, QString>(0, "0A")
+                 << QPair<int, QString>(2, "0B")
+                 << QPair<int, QString>(3, "0C")
+                 << QPair<int, QString>(4, "0D");
+        QCOMPARE(result->data(), expected);
+
+        // WHEN
+        query.onRemoved(createObject(2, "0B"));
+        query.onChanged(createObject(4, "0DD"));
+        query.onChanged(createObject(3, "1C"));
+        query.onChanged(createObject(5, "0E"));
+        query.onAdded(createObject(0, "0AA"));
+        query.onRemoved(createObject(1, "1A"));
+
+        // THEN
+        expected.clear();
+        expected << QPair<int, QString>(0, "0AA")
+                 << QPair<int, QString>(4, "0DD")
+                 << QPair<int, QString>(5, "0E");
+        QCOMPARE(result->data(), expected);
+        QCOMPARE(representsCount, 0);
+
+        // WHEN
+        query.onRemoved(createObject(0, "0AA"));
+        query.onChanged(createObject(5, "0EE"));
+
+        // THEN
+        expected.clear();
+        expected << QPair<int, QString>(4, "0DD")
+                 << QPair<int, QString>(5, "0EE");
+        QCOMPARE(result->data(), expected);
+        QCOMPARE(representsCount, 0);
+    }
+
+    void shouldInsertFetchedBatchesInOneGo()
+    {
+        // GIVEN
+        Domain::LiveQuery<QObject*, QPair<int, QString>> query;
+        query.setRangeFetchFunction([this] (const Domain::LiveQuery<QObject*, QPair<int, QString>>::AddRangeFunction &add) {
+            Utils::JobHandler::install(new FakeJob, [this, add] {
+                add(QList<QObject*>() << createObject(0, "0A")
+                                      << createObject(1, "1A")
+                                      << createObject(2, "0B"));
+            });
+            Utils::JobHandler::install(new FakeJob, [this, add] {
+                add(QList<QObject*>() << createObject(3, "0C")
+                                      << createObject(0, "0AA")
+                                      << createObject(4, "0D"));
+            });
+        });
+        query.setConvertFunction([] (QObject *object) {
+            return QPair<int, QString>(object->property("objectId").toInt(), object->objectName());
+        });
+        query.setUpdateFunction([] (QObject *object, QPair<int, QString> &output) {
+            output.second = object->objectName();
+        });
+        query.setPredicateFunction([] (QObject *object) {
+            return object->objectName().startsWith('0');
+        });
+        query.setKeyFunction([] (QObject *object) {
+            return object->property("objectId").toLongLong();
+        });
+
+        QList<int> insertedCounts;
+        QList<int> insertedPositions;
+        Domain::QueryResult<QPair<int, QString>>::Ptr result = query.result();
+        result->addPostInsertRangeHandler([&] (const Domain::QueryResultRange<QPair<int, QString>> &outputs, int pos) {
+            insertedCounts << outputs.size();
+            insertedPositions << pos;
+        });
+
+        // WHEN
+        QTest::qWait(150);
+
+        // THEN
+        QList<QPair<int, QString>> expected;
+        expected << QPair<int, QString>(0, "0AA")
+                 << QPair<int, QString>(2, "0B")
+                 << QPair<int, QString>(3, "0C")
+                 << QPair<int, QString>(4, "0D");
+        QCOMPARE(result->data(), expected);
+        QCOMPARE(insertedCounts, QList<int>() << 2 << 2);
+        QCOMPARE(insertedPositions, QList<int>() << 0 << 2);
+
+        // WHEN
+        query.onRemoved(createObject(3, "0C"));
+
+        // THEN
+        expected.removeAt(2);
+        QCOMPARE(result->data(), expected);
+    }
+
+    void shouldConvertFetchedBatchesInOneGo()
+    {
+        // GIVEN
+        Domain::LiveQuery<QObject*, QPair<int, QString>> query;
+        query.setRangeFetchFunction([this] (const Domain::LiveQuery<QObject*, QPair<int, QString>>::AddRangeFunction &add) {
+            Utils::JobHandler::install(new FakeJob, [this, add] {
+                add(QList<QObject*>() << createObject(0, "0A")
+                                      << createObject(1, "1A")
+                                      << createObject(2, "0B")
+                                      << createObject(0, "0AA"));
+            });
+        });
+        int convertCount = 0;
+        query.setConvertFunction([&convertCount] (QObject *object) {
+            convertCount++;
+            return QPair<int, QString>(object->property("objectId").toInt(), object->objectName());
+        });
+        QList<int> rangeConvertCounts;
+        query.setRangeConvertFunction([&rangeConvertCounts] (const QList<QObject*> &objects) {
+            rangeConvertCounts << objects.size();
+            QList<QPair<int, QString>> outputs;
+            for (auto object : objects)
+                outputs << QPair<int, QString>(object->property("objectId").toInt(), object->objectName());
+            return outputs;
+        });
+        query.setUpdateFunction([] (QObject *object, QPair<int, QString> &output) {
+            output.second = object->objectName();
+        });
+        query.setPredicateFunction([] (QObject *object) {
+            return object->objectName().startsWith('0');
+        });
+        query.setKeyFunction([] (QObject *object) {
+            return object->property("objectId").toLongLong();
+        });
+
+        Domain::QueryResult<QPair<int, QString>>::Ptr result = query.result();
+
+        // WHEN
+        QTest::qWait(150);
+
+        // THEN
+        QList<QPair<int, QString>> expected;
+        expected << QPair<int, QString>(0, "0AA")
+                 << QPair<int, QString>(2, "0B");
+        QCOMPARE(result->data(), expected);
+        QCOMPARE(rangeConvertCounts, QList<int>() << 2);
+        QCOMPARE(convertCount, 0);
+
+        // WHEN
+        query.onAdded(createObject(3, "0C"));
+
+        // THEN
+        expected << QPair<int, QString>(3, "0C");
+        QCOMPARE(result->data(), expected);
+        QCOMPARE(rangeConvertCounts, QList<int>() << 2);
+        QCOMPARE(convertCount, 1);
+    }
+
+    void shouldShowFetchedBatchesAsTheyArrive()
+    {
+        // GIVEN
+        Domain::LiveQuery<QObject*, QPair<int, QString>> query;
+        query.setRangeFetchFunction([this] (const Domain::LiveQuery<QObject*, QPair<int, QString>>::AddRangeFunction &add) {
+            Utils::JobHandler::install(new FakeJob, [this, add] {
+                add(QList<QObject*>() << createObject(0, "0A")
+                                      << createObject(1, "0B"));
+
+                Utils::JobHandler::install(new FakeJob, [this, add] {
+                    add(QList<QObject*>() << createObject(2, "0C")
+                                          << createObject(0, "0AA"));
+                });
+            });
+        });
+        query.setConvertFunction([] (QObject *object) {
+            return QPair<int, QString>(object->property("objectId").toInt(), object->objectName());
+        });
+        query.setUpdateFunction([] (QObject *object, QPair<int, QString> &output) {
+            output.second = object->objectName();
+        });
+        query.setPredicateFunction([] (QObject *object) {
+            return object->objectName().startsWith('0');
+        });
+        query.setKeyFunction([] (QObject *object) {
+            return object->property("objectId").toLongLong();
+        });
+
+        Domain::QueryResult<QPair<int, QString>>::Ptr result = query.result();
+
+        // WHEN
+        QTest::qWait(150);
+
+        // THEN
+        QList<QPair<int, QString>> expected;
+        expected << QPair<int, QString>(0, "0A")
+                 << QPair<int, QString>(1, "0B");
+        QCOMPARE(result->data(), expected);
+
+        // WHEN
+        QTest::qWait(100);
+
+        // THEN
+        expected.clear();
+        expected << QPair<int, QString>(0, "0AA")
+                 << QPair<int, QString>(1, "0B")
+                 << QPair<int, QString>(2, "0C");
+        QCOMPARE(result->data(), expected);
+    }
+
+    void shouldBatchNotificationsUntilNextEventLoopTurn()
+    {
+        // GIVEN
+        Domain::LiveQuery<QObject*, QPair<int, QString>> query;
+        query.setFetchFunction([this] (const Domain::LiveQuery<QObject*, QString>::AddFunction &add) {
+            Utils::JobHandler::install(new FakeJob, [this, add] {
+                add(createObject(0, "0A"));
+                add(createObject(1, "0B"));
+                add(createObject(2, "0C"));
+                add(createObject(3, "0D"));
+                add(createObject(4, "0E"));
+            });
+        });
+        query.setConvertFunction([] (QObject *object) {
+            return QPair<int, QString>(object->property("objectId").toInt(), object->objectName());
+        });
+        query.setUpdateFunction([] (QObject *object, QPair<int, QString> &output) {
+            output.second = object->objectName();
+        });
+        query.setPredicateFunction([] (QObject *object) {
+            return object->objectName().startsWith('0');
+        });
+        query.setRepresentsFunction([] (QObject *object, const QPair<int, QString> &output) {
+            return object->property("objectId").toInt() == output.first;
+        });
+        query.setKeyFunction([] (QObject *object) {
+            return object->property("objectId").toLongLong();
+        });
+        query.setPostFunction([] (const std::function<void()> &callback) {
+            Utils::DelayedCall::post(callback);
+        });
+        query.setBatchingEnabled(true);
+
+        Domain::QueryResult<QPair<int, QString>>::Ptr result = query.result();
+        QTest::qWait(150);
+        QList<QPair<int, QString>> expected;
+        expected << QPair<int, QString>(0, "0A")
+                 << QPair<int, QString>(1, "0B")
+                 << QPair<int, QString>(2, "0C")
+                 << QPair<int, QString>(3, "0D")
+                 << QPair<int, QString>(4, "0E");
+        QCOMPARE(result->data(), expected);
+
+        int insertCount = 0;
+        int removeCount = 0;
+        int replaceCount = 0;
+        result->addPostInsertRangeHandler([&] (const Domain::QueryResultRange<QPair<int, QString>> &, int) { insertCount++; });
+        result->addPostRemoveRangeHandler([&] (const Domain::QueryResultRange<QPair<int, QString>> &, int) { removeCount++; });
+        result->addPostReplaceHandler([&] (const QPair<int, QString> &, int) { replaceCount++; });
+
+        // WHEN
+        query.onChanged(createObject(0, "0AA"));
+        query.onChanged(createObject(0, "0AAA"));
+        query.onRemoved(createObject(1, "0B"));
+        query.onChanged(createObject(2, "1C"));
+        query.onAdded(createObject(5, "0F"));
+        query.onChanged(createObject(5, "0FF"));
+        query.onAdded(createObject(6, "0G"));
+        query.onAdded(createObject(7, "0H"));
+        query.onRemoved(createObject(7, "0H"));
+
+        // THEN
+        QCOMPARE(result->data(), expected);
+
+        // WHEN
+        QTest::qWait(10);
+
+        // THEN
+        expected.clear();
+        expected << QPair<int, QString>(0, "0AAA")
+                 << QPair<int, QString>(3, "0D")
+                 << QPair<int, QString>(4, "0E")
+                 << QPair<int, QString>(5, "0FF")
+                 << QPair<int, QString>(6, "0G");
+        QCOMPARE(result->data(), expected);
+        QCOMPARE(replaceCount, 1);
+        QCOMPARE(removeCount, 1);
+        QCOMPARE(insertCount, 1);
+
+        // WHEN
+        query.onRemoved(createObject(6, "0G"));
+        query.onChanged(createObject(4, "0EE"));
+        QTest::qWait(10);
+
+        // THEN
+        expected.removeLast();
+        expected[2].second = "0EE";
+        QCOMPARE(result->data(), expected);
+    }
+
+    void shouldDropBatchedNotificationsOnReset()
+    {
+        // GIVEN
+        Domain::LiveQuery<QObject*, QPair<int, QString>> query;
+        query.setFetchFunction([this] (const Domain::LiveQuery<QObject*, QString>::AddFunction &add) {
+            Utils::JobHandler::install(new FakeJob, [this, add] {
+                add(createObject(0, "0A"));
+                add(createObject(1, "0B"));
+            });
+        });
+        query.setConvertFunction([] (QObject *object) {
+            return QPair<int, QString>(object->property("objectId").toInt(), object->objectName());
+        });
+        query.setUpdateFunction([] (QObject *object, QPair<int, QString> &output) {
+            output.second = object->objectName();
+        });
+        query.setPredicateFunction([] (QObject *object) {
+            return object->objectName().startsWith('0');
+        });
+        query.setRepresentsFunction([] (QObject *object, const QPair<int, QString> &output) {
+            return object->property("objectId").toInt() == output.first;
+        });
+        query.setKeyFunction([] (QObject *object) {
+            return object->property("objectId").toLongLong();
+        });
+        query.setPostFunction([] (const std::function<void()> &callback) {
+            Utils::DelayedCall::post(callback);
+        });
+        query.setBatchingEnabled(true);
+
+        Domain::QueryResult<QPair<int, QString>>::Ptr result = query.result();
+        QTest::qWait(150);
+        QCOMPARE(result->data().size(), 2);
+
+        // WHEN
+        query.onAdded(createObject(2, "0C"));
+        query.onChanged(createObject(0, "0AA"));
+        query.reset();
+        QTest::qWait(150);
+
+        // THEN
+        QList<QPair<int, QString>> expected;
+        expected << QPair<int, QString>(0, "0A")
+                 << QPair<int, QString>(1, "0B");
+        QCOMPARE(result->data(), expected);
+    }
+
+    void shouldKeepArrivalOrderOfBatchedNotificationsWithAndWithoutKey()
+    {
+        // GIVEN
+        Domain::LiveQuery<QObject*, QPair<int, QString>> query;
+        query.setFetchFunction([this] (const Domain::LiveQuery<QObject*, QString>::AddFunction &add) {
+            Utils::JobHandler::install(new FakeJob, [this, add] {
+                add(createObject(0, "0A"));
+                add(createObject(1, "0B"));
+            });
+        });
+        query.setConvertFunction([] (QObject *object) {
+            return QPair<int, QString>(object->property("objectId").toInt(), object->objectName());
+        });
+        query.setUpdateFunction([] (QObject *object, QPair<int, QString> &output) {
+            output.second = object->objectName();
+        });
+        query.setPredicateFunction([] (QObject *object) {
+            return object->objectName().startsWith('0');
+        });
+        query.setRepresentsFunction([] (QObject *object, const QPair<int, QString> &output) {
+            return object->property("objectId").toInt() == output.first;
+        });
+        // Objects from 10 onward have no key
+        query.setKeyFunction([] (QObject *object) {
+            const qint64 id = object->property("objectId").toLongLong();
+            return id < 10 ? id : -1;
+        });
+        query.setPostFunction([] (const std::function<void()> &callback) {
+            Utils::DelayedCall::post(callback);
+        });
+        query.setBatchingEnabled(true);
+
+        Domain::QueryResult<QPair<int, QString>>::Ptr result = query.result();
+        QTest::qWait(150);
+        QCOMPARE(result->data().size(), 2);
+
+        // WHEN
+        query.onAdded(createObject(2, "0C"));
+        query.onAdded(createObject(10, "0K"));
+        query.onChanged(createObject(2, "0CC"));
+        query.onAdded(createObject(3, "0D"));
+        query.onChanged(createObject(10, "0KK"));
+        query.onRemoved(createObject(0, "0A"));
+        query.onAdded(createObject(11, "0L"));
+        QTest::qWait(10);
+
+        // THEN
+        QList<QPair<int, QString>> expected;
+        expected << QPair<int, QString>(1, "0B")
+                 << QPair<int, QString>(10, "0KK")
+                 << QPair<int, QString>(2, "0CC")
+                 << QPair<int, QString>(3, "0D")
+                 << QPair<int, QString>(11, "0L");
+        QCOMPARE(result->data(), expected);
+    }
+
+    void shouldLetTheBackendHoldAndScopeTheFetches()
+    {
+        // GIVEN
+        int holdCount = 0;
+        QStringList calls;
+
+        Domain::LiveQuery<QObject*, QPair<int, QString>> query;
+        query.setFetchFunction([&calls] (const Domain::LiveQuery<QObject*, QString>::AddFunction &) {
+            calls << "fetch";
+        });
+        query.setConvertFunction([] (QObject *object) {
+            return QPair<int, QString>(object->property("objectId").toInt(), object->objectName());
+        });
+        query.setPredicateFunction([] (QObject *) {
+            return true;
+        });
+        query.setHoldFunction([&holdCount] {
+            holdCount++;
+        });
+        query.setScopeFunction([&calls] (const std::function<void()> &fetch) {
+            calls << "enter";
+            fetch();
+            calls << "leave";
+        });
+
+        // WHEN
+        auto result = query.result();
+        result = query.result();
+
+        // THEN
+        QCOMPARE(holdCount, 2);
+        QCOMPARE(calls, QStringList() << "enter" << "fetch" << "leave");
+    }
+
+    void shouldKeepKeyIndexConsistentWhenRemovingFromTheFront()
+    {
+        // GIVEN
+        const int count = 1000;
+        Domain::LiveQuery<QObject*, QPair<int, QString>> query;
+        query.setFetchFunction([this, count] (const Domain::LiveQuery<QObject*, QString>::AddFunction &add) {
+            Utils::JobHandler::install(new FakeJob, [this, count, add] {
+                for (int i = 0; i < count; i++)
+                    add(createObject(i, QString("0%1").arg(i)));
+            });
+        });
+        query.setConvertFunction([] (QObject *object) {
+            return QPair<int, QString>(object->property("objectId").toInt(), object->objectName());
+        });
+        query.setUpdateFunction([] (QObject *object, QPair<int, QString> &output) {
+            output.second = object->objectName();
+        });
+        query.setPredicateFunction([] (QObject *object) {
+            return object->objectName().startsWith('0');
+        });
+        query.setRepresentsFunction([] (QObject *object, const QPair<int, QString> &output) {
+            return object->property("objectId").toInt() == output.first;
+        });
+        query.setKeyFunction([] (QObject *object) {
+            return object->property("objectId").toLongLong();
+        });
+
+        Domain::QueryResult<QPair<int, QString>>::Ptr result = query.result();
+        QTest::qWait(150);
+        QCOMPARE(result->data().size(), count);
+
+        // WHEN
+        for (int i = 0; i < count / 2; i++)
+            query.onRemoved(createObject(i, QString("0%1").arg(i)));
+
+        // THEN
+        QCOMPARE(result->data().size(), count / 2);
+        QCOMPARE(result->data().first().first, count / 2);
+
+        // WHEN
+        for (int i = count / 2; i < count; i++)
+            query.onChanged(createObject(i, QString("0%1-changed").arg(i)));
+        query.onChanged(createObject(count - 1, "1 not matching anymore"));
+        query.onAdded(createObject(count, "0new"));
+
+        // THEN
+        QCOMPARE(result->data().size(), count / 2);
+        for (int row = 0; row < count / 2 - 1; row++) {
+            const int id = count / 2 + row;
+            QCOMPARE(result->data().at(row), QPair<int, QString>(id, QString("0%1-changed").arg(id)));
+        }
+        QCOMPARE(result->data().last(), QPair<int, QString>(count, "0new"));
+
+        // WHEN
+        query.onRemoved(createObject(count, "0new"));
+        query.onRemoved(createObject(count / 2 + 1, "0"));
+
+        // THEN
+        QCOMPARE(result->data().size(), count / 2 - 2);
+        QCOMPARE(result->data().at(0).first, count / 2);
+        QCOMPARE(result->data().at(1).first, count / 2 + 2);
+        QCOMPARE(result->data().last().first, count - 2);
+    }
+
     void shouldEmptyAndFetchAgainOnReset()
     {
         // GIVEN
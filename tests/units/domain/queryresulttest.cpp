@@ -120,6 +120,36 @@ private slots:
         QCOMPARE(otherResult->data(), baseList);
     }
 
+    void shouldGiveReadOnlyAccessWithoutCopying()
+    {
+        auto provider = QueryResultProvider<Derived::Ptr>::Ptr::create();
+        auto result = QueryResult<Derived::Ptr>::create(provider);
+        auto baseResult = QueryResult<Derived::Ptr, Base::Ptr>::copy(result);
+        QueryResultInterface<Base::Ptr>::Ptr baseInterface = baseResult;
+
+        QVERIFY(result->isEmpty());
+        QVERIFY(baseInterface->isEmpty());
+        QVERIFY(baseInterface->begin() == baseInterface->end());
+
+        provider->append(Derived::Ptr::create());
+        provider->append(Derived::Ptr::create());
+        provider->append(Derived::Ptr::create());
+
+        QCOMPARE(provider->constData(), provider->data());
+        QCOMPARE(result->size(), 3);
+        QCOMPARE(baseInterface->size(), 3);
+        QVERIFY(!baseInterface->isEmpty());
+
+        QList<Base::Ptr> iterated;
+        for (int i = 0; i < baseInterface->size(); i++) {
+            QCOMPARE(result->at(i), provider->data().at(i));
+            QCOMPARE(baseInterface->at(i), Base::Ptr(provider->data().at(i)));
+        }
+        for (auto base : *baseInterface)
+            iterated << base;
+        QCOMPARE(iterated, baseResult->data());
+    }
+
     void shouldProperlyCopyNullPointers()
     {
         QueryResult<QString>::Ptr result;
@@ -339,6 +369,121 @@ private slots:
         QCOMPARE(postReplaces, expectedPostReplaces);
         QCOMPARE(postReplacesPos, expectedReplacesPos);
     }
+
+    void shouldNotifyRangeInsertsAndRemovesInOneGo()
+    {
+        QList<QList<QString>> preInserts, postInserts, preRemoves, postRemoves;
+        QList<int> preInsertsPos, postInsertsPos, preRemovesPos, postRemovesPos;
+
+        QueryResultProvider<QString>::Ptr provider(new QueryResultProvider<QString>);
+        *provider << "Foo";
+
+        QueryResult<QString>::Ptr result = QueryResult<QString>::create(provider);
+
+        result->addPreInsertRangeHandler(
+            [&](const QueryResultRange<QString> &values, int pos)
+            {
+                preInserts << values.toList();
+                preInsertsPos << pos;
+            }
+        );
+
+        result->addPostInsertRangeHandler(
+            [&](const QueryResultRange<QString> &values, int pos)
+            {
+                postInserts << values.toList();
+                postInsertsPos << pos;
+            }
+        );
+
+        result->addPreRemoveRangeHandler(
+            [&](const QueryResultRange<QString> &values, int pos)
+            {
+                preRemoves << values.toList();
+                preRemovesPos << pos;
+            }
+        );
+
+        result->addPostRemoveRangeHandler(
+            [&](const QueryResultRange<QString> &values, int pos)
+            {
+                postRemoves << values.toList();
+                postRemovesPos << pos;
+            }
+        );
+
+        provider->appendRange(QList<QString>() << "Bar" << "Baz");
+        provider->insertRange(1, QList<QString>() << "Bazz" << "Qux");
+        provider->removeRange(2, 2);
+        provider->append("Quux");
+
+        const QList<QList<QString>> expectedInserts = {
+            QList<QString>() << "Bar" << "Baz",
+            QList<QString>() << "Bazz" << "Qux",
+            QList<QString>() << "Quux"
+        };
+        const QList<int> expectedInsertsPos = {1, 1, 3};
+        QCOMPARE(preInserts, expectedInserts);
+        QCOMPARE(preInsertsPos, expectedInsertsPos);
+        QCOMPARE(postInserts, expectedInserts);
+        QCOMPARE(postInsertsPos, expectedInsertsPos);
+
+        const QList<QList<QString>> expectedRemoves = { QList<QString>() << "Qux" << "Bar" };
+        const QList<int> expectedRemovesPos = {2};
+        QCOMPARE(preRemoves, expectedRemoves);
+        QCOMPARE(preRemovesPos, expectedRemovesPos);
+        QCOMPARE(postRemoves, expectedRemoves);
+        QCOMPARE(postRemovesPos, expectedRemovesPos);
+
+        const QList<QString> expectedData = {"Foo", "Bazz", "Baz", "Quux"};
+        QCOMPARE(provider->data(), expectedData);
+    }
+
+    void shouldNotifyRangesItemByItemIfPerItemHandlersAreRegistered()
+    {
+        QList<QString> inserts, removes;
+        QList<QList<QString>> rangeInserts;
+
+        QueryResultProvider<QString>::Ptr provider(new QueryResultProvider<QString>);
+        QueryResult<QString>::Ptr result = QueryResult<QString>::create(provider);
+        QueryResult<QString>::Ptr rangeResult = QueryResult<QString>::create(provider);
+
+        result->addPostInsertHandler(
+            [&](const QString &value, int)
+            {
+                inserts << value;
+            }
+        );
+
+        result->addPostRemoveHandler(
+            [&](const QString &value, int)
+            {
+                removes << value;
+            }
+        );
+
+        rangeResult->addPostInsertRangeHandler(
+            [&](const QueryResultRange<QString> &values, int)
+            {
+                rangeInserts << values.toList();
+            }
+        );
+
+        provider->appendRange(QList<QString>() << "Foo" << "Bar" << "Baz");
+        provider->removeRange(0, 2);
+
+        const QList<QString> expectedInserts = {"Foo", "Bar", "Baz"};
+        QCOMPARE(inserts, expectedInserts);
+        const QList<QList<QString>> expectedRangeInserts = {
+            QList<QString>() << "Foo",
+            QList<QString>() << "Bar",
+            QList<QString>() << "Baz"
+        };
+        QCOMPARE(rangeInserts, expectedRangeInserts);
+        const QList<QString> expectedRemoves = {"Foo", "Bar"};
+        QCOMPARE(removes, expectedRemoves);
+        QCOMPARE(provider->data(), QList<QString>() << "Baz");
+    }
 };
 
 QTEST_MAIN(QueryResultTest)
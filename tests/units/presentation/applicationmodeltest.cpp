@@ -38,6 +38,8 @@
 #include "presentation/datasourcelistmodel.h"
 #include "presentation/inboxpagemodel.h"
 
+#include "utils/jobhandler.h"
+
 #include "testlib/fakejob.h"
 
 using namespace mockitopp;
@@ -87,6 +89,30 @@ private slots:
         QCOMPARE(spy.takeFirst().takeFirst().value<QObject*>(), page);
     }
 
+    void shouldCancelTheJobsOfTheReplacedPage()
+    {
+        // GIVEN
+        Presentation::ApplicationModel app(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+        auto page = new Presentation::InboxPageModel(0, 0, 0, 0, this);
+        QPointer<QAbstractItemModel> model = page->centralListModel();
+        app.setCurrentPage(page);
+
+        QList<int> errors;
+        FakeJob *job = new FakeJob(this);
+        {
+            Utils::JobHandler::Scope scope(model, Utils::JobHandler::VisiblePriority);
+            Utils::JobHandler::install(job, [&errors, job] { errors << job->error(); });
+        }
+
+        // WHEN
+        app.setCurrentPage(new QObject(this));
+
+        // THEN
+        QCOMPARE(errors, QList<int>() << int(KJob::KilledJobError));
+        QVERIFY(model);
+        QCOMPARE(page->centralListModel(), model.data());
+    }
+
     void shouldAllowChangingPage()
     {
         // GIVEN
@@ -153,6 +153,57 @@ private slots:
         QVERIFY(model.property("delegateText").toString().isEmpty());
     }
 
+    void shouldLoadPartialNotes()
+    {
+        // GIVEN
+
+        // A note for which only the title got loaded
+        auto note = Domain::Note::Ptr::create();
+        note->setTitle("title");
+        note->backendIdentity().setPartial(true);
+
+        mock_object<Domain::NoteRepository> noteRepositoryMock;
+        noteRepositoryMock(&Domain::NoteRepository::load).when(note).thenReturn(new FakeJob(this));
+
+        Presentation::ArtifactEditorModel model(0, &noteRepositoryMock.getInstance());
+
+        // WHEN
+        model.setArtifact(note);
+
+        // THEN
+        QVERIFY(noteRepositoryMock(&Domain::NoteRepository::load).when(note).exactly(1));
+        QVERIFY(model.text().isEmpty());
+
+        // WHEN (the body got loaded)
+        QSignalSpy textSpy(&model, SIGNAL(textChanged(QString)));
+        note->setText("description");
+
+        // THEN
+        QCOMPARE(textSpy.size(), 1);
+        QCOMPARE(textSpy.takeFirst().takeFirst().toString(), note->text());
+        QCOMPARE(model.text(), note->text());
+    }
+
+    void shouldNotLoadCompleteNotes()
+    {
+        // GIVEN
+        auto note = Domain::Note::Ptr::create();
+        note->setText("description");
+        note->setTitle("title");
+
+        mock_object<Domain::NoteRepository> noteRepositoryMock;
+        noteRepositoryMock(&Domain::NoteRepository::load).when(note).thenReturn(new FakeJob(this));
+
+        Presentation::ArtifactEditorModel model(0, &noteRepositoryMock.getInstance());
+
+        // WHEN
+        model.setArtifact(note);
+
+        // THEN
+        QVERIFY(noteRepositoryMock(&Domain::NoteRepository::load).when(note).exactly(0));
+        QCOMPARE(model.text(), note->text());
+    }
+
     void shouldReactToArtifactPropertyChanges_data()
     {
         QTest::addColumn<Domain::Artifact::Ptr>("artifact");
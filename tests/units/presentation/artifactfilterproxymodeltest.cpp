@@ -29,7 +29,7 @@
 #include "domain/task.h"
 
 #include "presentation/artifactfilterproxymodel.h"
-#include "presentation/querytreemodelbase.h"
+#include "presentation/querytreemodel.h"
 
 Q_DECLARE_METATYPE(QList<QStandardItem*>)
 
@@ -132,6 +132,160 @@ private slots:
         QCOMPARE(output.index(1, 0, parent).data().toString(), QString("23. find me"));
     }
 
+    void shouldNotFetchChildrenToFilter()
+    {
+        // GIVEN
+        auto parentTask = Domain::Task::Ptr::create();
+        parentTask->setTitle("1. baz");
+        auto childTask = Domain::Task::Ptr::create();
+        childTask->setTitle("11. find me");
+
+        auto provider = Domain::QueryResultProvider<Domain::Artifact::Ptr>::Ptr::create();
+        provider->append(parentTask);
+        auto childProvider = Domain::QueryResultProvider<Domain::Artifact::Ptr>::Ptr::create();
+        childProvider->append(childTask);
+
+        QList<Domain::Artifact::Ptr> queriedArtifacts;
+        auto queryGenerator = [&](const Domain::Artifact::Ptr &artifact) {
+            queriedArtifacts << artifact;
+            if (!artifact)
+                return Domain::QueryResult<Domain::Artifact::Ptr>::create(provider);
+            else if (artifact == parentTask)
+                return Domain::QueryResult<Domain::Artifact::Ptr>::create(childProvider);
+            else
+                return Domain::QueryResult<Domain::Artifact::Ptr>::Ptr();
+        };
+        auto flagsFunction = [](const Domain::Artifact::Ptr &) {
+            return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+        };
+        auto dataFunction = [](const Domain::Artifact::Ptr &artifact, int role) -> QVariant {
+            if (role != Qt::DisplayRole)
+                return QVariant();
+            return artifact->title();
+        };
+        auto setDataFunction = [](const Domain::Artifact::Ptr &, const QVariant &, int) {
+            return false;
+        };
+        Presentation::QueryTreeModel<Domain::Artifact::Ptr> input(queryGenerator, flagsFunction, dataFunction, setDataFunction, 0);
+        input.fetchMore(QModelIndex());
+
+        Presentation::ArtifactFilterProxyModel output;
+        output.setSourceModel(&input);
+        QCOMPARE(output.rowCount(), 1);
+
+        // WHEN
+        output.setFilterFixedString("find me");
+
+        // THEN
+        QCOMPARE(output.rowCount(), 0);
+        QCOMPARE(queriedArtifacts, QList<Domain::Artifact::Ptr>() << Domain::Artifact::Ptr());
+
+        // WHEN
+        output.setFilterFixedString(QString());
+        input.fetchMore(input.index(0, 0));
+        output.setFilterFixedString("find me");
+
+        // THEN
+        QCOMPARE(queriedArtifacts, QList<Domain::Artifact::Ptr>() << Domain::Artifact::Ptr() << parentTask);
+        QCOMPARE(output.rowCount(), 1);
+        const QModelIndex parent = output.index(0, 0);
+        QCOMPARE(parent.data().toString(), QString("1. baz"));
+        QCOMPARE(output.rowCount(parent), 1);
+        QCOMPARE(output.index(0, 0, parent).data().toString(), QString("11. find me"));
+    }
+
+    void shouldFollowFilterRefinements()
+    {
+        // GIVEN
+        QStandardItemModel input;
+        input.appendRow(createTaskItem("1. foo", "find me"));
+        input.appendRow(createTaskItem("2. Find", "bar"));
+        QStandardItem *item = createTaskItem("3. baz", "baz");
+        item->appendRow(createNoteItem("31. FIND ME", "foo"));
+        input.appendRow(item);
+
+        Presentation::ArtifactFilterProxyModel output;
+        output.setSourceModel(&input);
+        output.setFilterFixedString("find");
+        QCOMPARE(output.rowCount(), 3);
+
+        // WHEN
+        output.setFilterFixedString("find me");
+
+        // THEN
+        QCOMPARE(output.rowCount(), 2);
+        QCOMPARE(output.index(0, 0).data().toString(), QString("1. foo"));
+        QCOMPARE(output.index(1, 0).data().toString(), QString("3. baz"));
+        QCOMPARE(output.rowCount(output.index(1, 0)), 1);
+
+        // WHEN
+        output.setFilterFixedString("find");
+
+        // THEN
+        QCOMPARE(output.rowCount(), 3);
+    }
+
+    void shouldFollowFilterChangesMadeThroughTheBaseClass()
+    {
+        // GIVEN
+        QStandardItemModel input;
+        input.appendRow(createTaskItem("1. foo", "find me"));
+        input.appendRow(createTaskItem("2. Find", "bar"));
+        input.appendRow(createNoteItem("3. baz", "baz"));
+
+        Presentation::ArtifactFilterProxyModel output;
+        output.setSourceModel(&input);
+        QSortFilterProxyModel *base = &output;
+
+        // WHEN
+        base->setFilterFixedString("find me");
+
+        // THEN
+        QCOMPARE(output.rowCount(), 1);
+        QCOMPARE(output.index(0, 0).data().toString(), QString("1. foo"));
+
+        // WHEN
+        base->setFilterWildcard("*ba?");
+
+        // THEN
+        QCOMPARE(output.rowCount(), 2);
+        QCOMPARE(output.index(0, 0).data().toString(), QString("2. Find"));
+        QCOMPARE(output.index(1, 0).data().toString(), QString("3. baz"));
+
+        // WHEN
+        QMetaObject::invokeMethod(base, "setFilterRegExp", Q_ARG(QString, "^f"));
+
+        // THEN
+        QCOMPARE(output.rowCount(), 1);
+        QCOMPARE(output.index(0, 0).data().toString(), QString("1. foo"));
+    }
+
+    void shouldFilterAgainWhenArtifactChanges()
+    {
+        // GIVEN
+        QStandardItemModel input;
+        input.appendRow(createTaskItem("1. foo", "find me"));
+        QStandardItem *item = createTaskItem("2. bar", "bar");
+        input.appendRow(item);
+
+        Presentation::ArtifactFilterProxyModel output;
+        output.setSourceModel(&input);
+        output.setFilterFixedString("find me");
+        QCOMPARE(output.rowCount(), 1);
+
+        // WHEN
+        auto artifact = item->data(Presentation::QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>();
+        artifact->setTitle("2. find me");
+        item->setData(artifact->title(), Qt::DisplayRole);
+        input.appendRow(createNoteItem("3. find me", "bar"));
+
+        // THEN
+        QCOMPARE(output.rowCount(), 3);
+        QCOMPARE(output.index(0, 0).data().toString(), QString("1. foo"));
+        QCOMPARE(output.index(1, 0).data().toString(), QString("2. find me"));
+        QCOMPARE(output.index(2, 0).data().toString(), QString("3. find me"));
+    }
+
     void shouldSortFollowingType_data()
     {
         QTest::addColumn<int>("sortType");
@@ -248,6 +402,136 @@ private slots:
         // THEN
         QCOMPARE(outputTitles, expectedOutputTitles);
     }
+
+    void shouldSortAgainWhenTaskChanges()
+    {
+        // GIVEN
+        QStandardItem *first = createTaskItem("A", "foo");
+        auto firstTask = first->data(Presentation::QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>().objectCast<Domain::Task>();
+        firstTask->setProgress(10);
+        QStandardItem *second = createTaskItem("B", "foo");
+        auto secondTask = second->data(Presentation::QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>().objectCast<Domain::Task>();
+        secondTask->setProgress(50);
+
+        QStandardItemModel input;
+        input.appendRow(first);
+        input.appendRow(second);
+
+        Presentation::ArtifactFilterProxyModel output;
+        output.setSourceModel(&input);
+        output.setSortType(Presentation::ArtifactFilterProxyModel::ProgressSort);
+        output.setSortOrder(Qt::AscendingOrder);
+        QCOMPARE(output.index(0, 0).data().toString(), QString("A"));
+        QCOMPARE(output.index(1, 0).data().toString(), QString("B"));
+
+        // WHEN
+        firstTask->setProgress(90);
+        first->setData(firstTask->progress(), Qt::UserRole); // Triggers dataChanged()
+
+        // THEN
+        QCOMPARE(output.index(0, 0).data().toString(), QString("B"));
+        QCOMPARE(output.index(1, 0).data().toString(), QString("A"));
+    }
+
+    void shouldKeepSortKeysInSyncWithSourceRows()
+    {
+        // GIVEN
+        QStandardItem *first = createTaskItem("A", "foo");
+        auto firstTask = first->data(Presentation::QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>().objectCast<Domain::Task>();
+        firstTask->setProgress(10);
+        QStandardItem *second = createTaskItem("B", "foo");
+        auto secondTask = second->data(Presentation::QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>().objectCast<Domain::Task>();
+        secondTask->setProgress(50);
+
+        QStandardItemModel input;
+        input.appendRow(first);
+        input.appendRow(second);
+
+        Presentation::ArtifactFilterProxyModel output;
+        output.setSourceModel(&input);
+        output.setSortType(Presentation::ArtifactFilterProxyModel::ProgressSort);
+        output.setSortOrder(Qt::AscendingOrder);
+
+        // WHEN
+        QStandardItem *third = createTaskItem("C", "foo");
+        auto thirdTask = third->data(Presentation::QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>().objectCast<Domain::Task>();
+        thirdTask->setProgress(30);
+        input.insertRow(0, third);
+
+        // THEN
+        QCOMPARE(output.rowCount(), 3);
+        QCOMPARE(output.index(0, 0).data().toString(), QString("A"));
+        QCOMPARE(output.index(1, 0).data().toString(), QString("C"));
+        QCOMPARE(output.index(2, 0).data().toString(), QString("B"));
+
+        // WHEN
+        input.removeRow(first->row());
+        secondTask->setProgress(0);
+        second->setData(secondTask->progress(), Qt::UserRole); // Triggers dataChanged()
+
+        // THEN
+        QCOMPARE(output.rowCount(), 2);
+        QCOMPARE(output.index(0, 0).data().toString(), QString("B"));
+        QCOMPARE(output.index(1, 0).data().toString(), QString("C"));
+    }
+
+    void shouldKeepSortKeysPerParent()
+    {
+        // GIVEN
+        QStandardItem *parent1 = createTaskItem("1", "foo");
+        QStandardItem *parent2 = createTaskItem("2", "foo");
+        QList<Domain::Task::Ptr> tasks;
+        QList<QStandardItem*> children;
+        for (int i = 0; i < 4; i++) {
+            QStandardItem *child = createTaskItem(QString("%1%2").arg(i < 2 ? 1 : 2).arg(i), "foo");
+            auto task = child->data(Presentation::QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>().objectCast<Domain::Task>();
+            task->setProgress(10 * (i % 2));
+            tasks << task;
+            children << child;
+        }
+        parent1->appendRow(children.at(0));
+        parent1->appendRow(children.at(1));
+        parent2->appendRow(children.at(2));
+        parent2->appendRow(children.at(3));
+
+        QStandardItemModel input;
+        input.appendRow(parent1);
+        input.appendRow(parent2);
+
+        Presentation::ArtifactFilterProxyModel output;
+        output.setSourceModel(&input);
+        output.setSortType(Presentation::ArtifactFilterProxyModel::ProgressSort);
+        output.setSortOrder(Qt::AscendingOrder);
+
+        const QPersistentModelIndex output1 = output.mapFromSource(parent1->index());
+        const QPersistentModelIndex output2 = output.mapFromSource(parent2->index());
+        QCOMPARE(output.index(0, 0, output1).data().toString(), QString("10"));
+        QCOMPARE(output.index(0, 0, output2).data().toString(), QString("22"));
+
+        // WHEN
+        tasks[2]->setProgress(50);
+        children.at(2)->setData(tasks.at(2)->progress(), Qt::UserRole); // Triggers dataChanged()
+        parent1->removeRow(0);
+
+        // THEN
+        QCOMPARE(output.rowCount(output1), 1);
+        QCOMPARE(output.index(0, 0, output1).data().toString(), QString("11"));
+        QCOMPARE(output.index(0, 0, output2).data().toString(), QString("23"));
+        QCOMPARE(output.index(1, 0, output2).data().toString(), QString("22"));
+
+        // WHEN
+        tasks[1]->setProgress(90);
+        children.at(1)->setData(tasks.at(1)->progress(), Qt::UserRole);
+        input.removeRow(parent1->row());
+        tasks[3]->setProgress(90);
+        children.at(3)->setData(tasks.at(3)->progress(), Qt::UserRole);
+
+        // THEN
+        const QModelIndex remaining = output.index(0, 0);
+        QCOMPARE(remaining.data().toString(), QString("2"));
+        QCOMPARE(output.index(0, 0, remaining).data().toString(), QString("22"));
+        QCOMPARE(output.index(1, 0, remaining).data().toString(), QString("23"));
+    }
 };
 
 QTEST_MAIN(ArtifactFilterProxyModelTest)
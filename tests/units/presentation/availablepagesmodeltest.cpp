@@ -43,6 +43,7 @@
 #include "presentation/querytreemodelbase.h"
 
 #include "testlib/fakejob.h"
+#include "testlib/modelutils.h"
 
 using namespace mockitopp;
 using namespace mockitopp::matcher;
@@ -110,6 +111,7 @@ private slots:
 
         // WHEN
         QAbstractItemModel *model = pages.pageListModel();
+        TestLib::ModelUtils::fetchAll(model);
 
         // THEN
         const QModelIndex inboxIndex = model->index(0, 0);
@@ -329,6 +331,7 @@ private slots:
 
         // WHEN
         QAbstractItemModel *model = pages.pageListModel();
+        TestLib::ModelUtils::fetchAll(model);
 
         // THEN
         const QModelIndex inboxIndex = model->index(0, 0);
@@ -386,6 +389,7 @@ private slots:
 
         // WHEN
         QAbstractItemModel *model = pages.pageListModel();
+        TestLib::ModelUtils::fetchAll(model);
 
         // THEN
         const QModelIndex projectsIndex = model->index(1, 0);
@@ -455,6 +459,7 @@ private slots:
 
         // WHEN
         QAbstractItemModel *model = pages.pageListModel();
+        TestLib::ModelUtils::fetchAll(model);
 
         // THEN
         const QModelIndex contextsIndex = model->index(2, 0);
@@ -579,6 +584,7 @@ private slots:
                                                 0);
 
         QAbstractItemModel *model = pages.pageListModel();
+        TestLib::ModelUtils::fetchAll(model);
 
         const QModelIndex projectsIndex = model->index(1, 0);
         const QModelIndex project1Index = model->index(0, 0, projectsIndex);
@@ -636,6 +642,7 @@ private slots:
                                                 0);
 
         QAbstractItemModel *model = pages.pageListModel();
+        TestLib::ModelUtils::fetchAll(model);
 
         const QModelIndex contextsIndex = model->index(2, 0);
         const QModelIndex context1Index = model->index(0, 0, contextsIndex);
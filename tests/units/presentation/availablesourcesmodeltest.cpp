@@ -32,6 +32,7 @@
 #include "presentation/querytreemodelbase.h"
 
 #include "testlib/fakejob.h"
+#include "testlib/modelutils.h"
 
 using namespace mockitopp;
 using namespace mockitopp::matcher;
@@ -96,6 +97,7 @@ private slots:
 
         // WHEN
         QAbstractItemModel *model = sources.sourceListModel();
+        TestLib::ModelUtils::fetchAll(model);
 
         // THEN
         const QModelIndex source1Index = model->index(0, 0);
@@ -207,6 +209,7 @@ private slots:
 
         // WHEN
         QAbstractItemModel *model = sources.searchListModel();
+        TestLib::ModelUtils::fetchAll(model);
 
         // THEN
         const QModelIndex source1Index = model->index(0, 0);
@@ -39,6 +39,7 @@
 #include "presentation/contextpagemodel.h"
 
 #include "testlib/fakejob.h"
+#include "testlib/modelutils.h"
 
 using namespace mockitopp;
 using namespace mockitopp::matcher;
@@ -83,6 +84,7 @@ private slots:
 
         // WHEN
         QAbstractItemModel *model = page.centralListModel();
+        TestLib::ModelUtils::fetchAll(model);
 
         // THEN
         const QModelIndex parentTaskIndex = model->index(0, 0);
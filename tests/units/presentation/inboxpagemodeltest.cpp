@@ -32,6 +32,7 @@
 #include "presentation/inboxpagemodel.h"
 
 #include "testlib/fakejob.h"
+#include "testlib/modelutils.h"
 
 using namespace mockitopp;
 using namespace mockitopp::matcher;
@@ -79,6 +80,7 @@ private slots:
 
         // WHEN
         QAbstractItemModel *model = inbox.centralListModel();
+        TestLib::ModelUtils::fetchAll(model);
 
         // THEN
         const QModelIndex rootTaskIndex = model->index(0, 0);
@@ -248,7 +250,9 @@ private slots:
                                            &noteRepositoryMock.getInstance());
 
         // WHEN
-        const QModelIndex index = inbox.centralListModel()->index(1, 0);
+        QAbstractItemModel *model = inbox.centralListModel();
+        TestLib::ModelUtils::fetchAll(model);
+        const QModelIndex index = model->index(1, 0);
         inbox.removeItem(index);
 
         // THEN
@@ -284,7 +288,9 @@ private slots:
                                            &noteRepositoryMock.getInstance());
 
         // WHEN
-        const QModelIndex index = inbox.centralListModel()->index(1, 0);
+        QAbstractItemModel *model = inbox.centralListModel();
+        TestLib::ModelUtils::fetchAll(model);
+        const QModelIndex index = model->index(1, 0);
         inbox.removeItem(index);
 
         // THEN
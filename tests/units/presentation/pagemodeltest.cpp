@@ -27,6 +27,10 @@
 
 #include "presentation/pagemodel.h"
 
+#include "utils/jobhandler.h"
+
+#include "testlib/fakejob.h"
+
 class FakePageModel : public Presentation::PageModel
 {
     Q_OBJECT
@@ -80,6 +84,28 @@ private slots:
         QCOMPARE(model.createCount, 1);
         QCOMPARE(itemModel, model.itemModel);
     }
+
+    void shouldCancelTheJobsOfTheListAndKeepIt()
+    {
+        // GIVEN
+        FakePageModel model;
+        QAbstractItemModel *itemModel = model.centralListModel();
+        QList<int> errors;
+
+        FakeJob *job = new FakeJob(this);
+        {
+            Utils::JobHandler::Scope scope(itemModel, Utils::JobHandler::VisiblePriority);
+            Utils::JobHandler::install(job, [&errors, job] { errors << job->error(); });
+        }
+
+        // WHEN
+        model.cancelJobs();
+
+        // THEN
+        QCOMPARE(errors, QList<int>() << int(KJob::KilledJobError));
+        QCOMPARE(model.centralListModel(), itemModel);
+        QCOMPARE(model.createCount, 1);
+    }
 };
 
 QTEST_MAIN(PageModelTest)
@@ -33,6 +33,7 @@
 #include "presentation/projectpagemodel.h"
 
 #include "testlib/fakejob.h"
+#include "testlib/modelutils.h"
 
 using namespace mockitopp;
 using namespace mockitopp::matcher;
@@ -84,6 +85,7 @@ private slots:
 
         // WHEN
         QAbstractItemModel *model = page.centralListModel();
+        TestLib::ModelUtils::fetchAll(model);
 
         // THEN
         const QModelIndex rootTaskIndex = model->index(0, 0);
@@ -267,7 +269,9 @@ private slots:
                                             &noteRepositoryMock.getInstance());
 
         // WHEN
-        const QModelIndex index = page.centralListModel()->index(1, 0);
+        QAbstractItemModel *model = page.centralListModel();
+        TestLib::ModelUtils::fetchAll(model);
+        const QModelIndex index = model->index(1, 0);
         page.removeItem(index);
 
         // THEN
@@ -307,7 +311,9 @@ private slots:
                                             &noteRepositoryMock.getInstance());
 
         // WHEN
-        const QModelIndex index = page.centralListModel()->index(1, 0);
+        QAbstractItemModel *model = page.centralListModel();
+        TestLib::ModelUtils::fetchAll(model);
+        const QModelIndex index = model->index(1, 0);
         page.removeItem(index);
 
         // THEN
@@ -221,6 +221,163 @@ private slots:
         QCOMPARE(model.rowCount(), 0);
     }
 
+    void shouldQueryChildrenOnlyWhenAskedFor()
+    {
+        // GIVEN
+        auto tasks = createTasks();
+        auto provider = Domain::QueryResultProvider<Domain::Task::Ptr>::Ptr::create();
+        for (auto task : tasks)
+            provider->append(task);
+
+        auto childrenTasks = createChildrenTasks();
+        auto childrenProvider = Domain::QueryResultProvider<Domain::Task::Ptr>::Ptr::create();
+        for (auto task : childrenTasks)
+            childrenProvider->append(task);
+
+        auto childrenList = Domain::QueryResult<Domain::Task::Ptr>::create(childrenProvider);
+
+        QList<Domain::Task::Ptr> queriedTasks;
+        auto queryGenerator = [&](const Domain::Task::Ptr &task) {
+            queriedTasks << task;
+            if (!task)
+                return Domain::QueryResult<Domain::Task::Ptr>::create(provider);
+            else if (task == tasks.at(0))
+                return childrenList;
+            else
+                return Domain::QueryResult<Domain::Task::Ptr>::Ptr();
+        };
+        auto flagsFunction = [](const Domain::Task::Ptr &) {
+            return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+        };
+        auto dataFunction = [](const Domain::Task::Ptr &task, int role) -> QVariant {
+            if (role != Qt::DisplayRole)
+                return QVariant();
+            return task->title();
+        };
+        auto setDataFunction = [](const Domain::Task::Ptr &, const QVariant &, int) {
+            return false;
+        };
+
+        // WHEN
+        Presentation::QueryTreeModel<Domain::Task::Ptr> model(queryGenerator, flagsFunction, dataFunction, setDataFunction, 0);
+        QSignalSpy aboutToBeInsertedSpy(&model, SIGNAL(rowsAboutToBeInserted(QModelIndex, int, int)));
+        QSignalSpy insertedSpy(&model, SIGNAL(rowsInserted(QModelIndex, int, int)));
+
+        // THEN
+        QVERIFY(queriedTasks.isEmpty());
+        QVERIFY(model.canFetchMore(QModelIndex()));
+        QCOMPARE(model.rowCount(), 0);
+        QVERIFY(!model.index(0, 0).isValid());
+        QVERIFY(queriedTasks.isEmpty());
+
+        // WHEN
+        model.fetchMore(QModelIndex());
+
+        // THEN
+        QCOMPARE(queriedTasks, QList<Domain::Task::Ptr>() << Domain::Task::Ptr());
+        QVERIFY(!model.canFetchMore(QModelIndex()));
+        QCOMPARE(model.rowCount(), 3);
+        QCOMPARE(aboutToBeInsertedSpy.size(), 1);
+        QCOMPARE(aboutToBeInsertedSpy.first().at(0).value<QModelIndex>(), QModelIndex());
+        QCOMPARE(aboutToBeInsertedSpy.first().at(1).toInt(), 0);
+        QCOMPARE(aboutToBeInsertedSpy.first().at(2).toInt(), 2);
+        QCOMPARE(insertedSpy.size(), 1);
+        QCOMPARE(insertedSpy.first().at(0).value<QModelIndex>(), QModelIndex());
+        QCOMPARE(insertedSpy.first().at(1).toInt(), 0);
+        QCOMPARE(insertedSpy.first().at(2).toInt(), 2);
+
+        // WHEN
+        const QModelIndex firstIndex = model.index(0, 0);
+        const QModelIndex secondIndex = model.index(1, 0);
+
+        // THEN
+        QCOMPARE(queriedTasks.size(), 1);
+        QVERIFY(model.hasChildren(firstIndex));
+        QVERIFY(model.hasChildren(secondIndex));
+        QVERIFY(model.canFetchMore(firstIndex));
+        QVERIFY(model.canFetchMore(secondIndex));
+        QCOMPARE(model.rowCount(firstIndex), 0);
+        QCOMPARE(model.rowCount(secondIndex), 0);
+        QCOMPARE(queriedTasks.size(), 1);
+
+        // WHEN
+        aboutToBeInsertedSpy.clear();
+        insertedSpy.clear();
+        model.fetchMore(firstIndex);
+        model.fetchMore(secondIndex);
+
+        // THEN
+        QCOMPARE(queriedTasks, QList<Domain::Task::Ptr>() << Domain::Task::Ptr() << tasks.at(0) << tasks.at(1));
+        QVERIFY(!model.canFetchMore(firstIndex));
+        QVERIFY(!model.canFetchMore(secondIndex));
+        QVERIFY(model.hasChildren(firstIndex));
+        QVERIFY(!model.hasChildren(secondIndex));
+        QCOMPARE(model.rowCount(firstIndex), 3);
+        QCOMPARE(model.rowCount(secondIndex), 0);
+        QCOMPARE(aboutToBeInsertedSpy.size(), 1);
+        QCOMPARE(aboutToBeInsertedSpy.first().at(0).value<QModelIndex>(), firstIndex);
+        QCOMPARE(aboutToBeInsertedSpy.first().at(1).toInt(), 0);
+        QCOMPARE(aboutToBeInsertedSpy.first().at(2).toInt(), 2);
+        QCOMPARE(insertedSpy.size(), 1);
+        QCOMPARE(insertedSpy.first().at(0).value<QModelIndex>(), firstIndex);
+        QCOMPARE(insertedSpy.first().at(1).toInt(), 0);
+        QCOMPARE(insertedSpy.first().at(2).toInt(), 2);
+        QCOMPARE(queriedTasks.size(), 3);
+    }
+
+    void shouldRelyOnChildrenHintBeforeQueryingChildren()
+    {
+        // GIVEN
+        auto tasks = createTasks();
+        auto provider = Domain::QueryResultProvider<Domain::Task::Ptr>::Ptr::create();
+        for (auto task : tasks)
+            provider->append(task);
+
+        QList<Domain::Task::Ptr> queriedTasks;
+        auto queryGenerator = [&](const Domain::Task::Ptr &task) {
+            queriedTasks << task;
+            if (!task)
+                return Domain::QueryResult<Domain::Task::Ptr>::create(provider);
+            else
+                return Domain::QueryResult<Domain::Task::Ptr>::Ptr();
+        };
+        auto flagsFunction = [](const Domain::Task::Ptr &) {
+            return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+        };
+        auto dataFunction = [](const Domain::Task::Ptr &task, int role) -> QVariant {
+            if (role != Qt::DisplayRole)
+                return QVariant();
+            return task->title();
+        };
+        auto setDataFunction = [](const Domain::Task::Ptr &, const QVariant &, int) {
+            return false;
+        };
+        auto childrenHintFunction = [&](const Domain::Task::Ptr &task) {
+            return task == tasks.at(0);
+        };
+
+        Presentation::QueryTreeModel<Domain::Task::Ptr> model(queryGenerator, flagsFunction, dataFunction, setDataFunction, 0);
+        model.setChildrenHintFunction(childrenHintFunction);
+        model.fetchMore(QModelIndex());
+
+        // WHEN
+        const QModelIndex firstIndex = model.index(0, 0);
+        const QModelIndex secondIndex = model.index(1, 0);
+
+        // THEN
+        QVERIFY(model.hasChildren());
+        QVERIFY(model.hasChildren(firstIndex));
+        QVERIFY(!model.hasChildren(secondIndex));
+        QCOMPARE(queriedTasks, QList<Domain::Task::Ptr>() << Domain::Task::Ptr());
+
+        // WHEN
+        model.fetchMore(firstIndex);
+
+        // THEN
+        QVERIFY(!model.hasChildren(firstIndex));
+        QCOMPARE(queriedTasks, QList<Domain::Task::Ptr>() << Domain::Task::Ptr() << tasks.at(0));
+    }
+
     void shouldReactToTaskAdd()
     {
         // GIVEN
@@ -461,6 +618,69 @@ private slots:
         }
     }
 
+    void shouldReactToRangesInsertedAndRemovedInFront()
+    {
+        // GIVEN
+        auto provider = Domain::QueryResultProvider<QString>::Ptr::create();
+        provider->appendRange(QStringList() << "3" << "4");
+
+        auto queryGenerator = [&](const QString &string) {
+            if (string.isEmpty())
+                return Domain::QueryResult<QString>::create(provider);
+
+            if (string.contains('.'))
+                return Domain::QueryResult<QString>::Ptr();
+
+            auto childProvider = Domain::QueryResultProvider<QString>::Ptr::create();
+            childProvider->append(string + ".1");
+            return Domain::QueryResult<QString>::create(childProvider);
+        };
+        auto flagsFunction = [](const QString &) {
+            return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+        };
+        auto dataFunction = [](const QString &string, int role) -> QVariant {
+            if (role != Qt::DisplayRole)
+                return QVariant();
+            return string;
+        };
+        auto setDataFunction = [](const QString &, const QVariant &, int) {
+            return false;
+        };
+        Presentation::QueryTreeModel<QString> model(queryGenerator, flagsFunction, dataFunction, setDataFunction, 0);
+        new ModelTest(&model);
+        QSignalSpy insertedSpy(&model, SIGNAL(rowsInserted(QModelIndex, int, int)));
+        QSignalSpy removedSpy(&model, SIGNAL(rowsRemoved(QModelIndex, int, int)));
+
+        // WHEN
+        provider->insertRange(0, QStringList() << "1" << "2");
+
+        // THEN
+        QCOMPARE(insertedSpy.size(), 1);
+        QCOMPARE(insertedSpy.first().at(0).value<QModelIndex>(), QModelIndex());
+        QCOMPARE(insertedSpy.first().at(1).toInt(), 0);
+        QCOMPARE(insertedSpy.first().at(2).toInt(), 1);
+        QCOMPARE(model.rowCount(), 4);
+        for (int row = 0; row < model.rowCount(); row++) {
+            const QModelIndex index = model.index(row, 0);
+            QCOMPARE(index.data().toString(), QString::number(row + 1));
+            model.fetchMore(index);
+            QCOMPARE(model.parent(model.index(0, 0, index)), index);
+        }
+
+        // WHEN
+        provider->removeRange(0, 3);
+
+        // THEN
+        QCOMPARE(removedSpy.size(), 1);
+        QCOMPARE(removedSpy.first().at(0).value<QModelIndex>(), QModelIndex());
+        QCOMPARE(removedSpy.first().at(1).toInt(), 0);
+        QCOMPARE(removedSpy.first().at(2).toInt(), 2);
+        QCOMPARE(model.rowCount(), 1);
+        const QModelIndex index = model.index(0, 0);
+        QCOMPARE(index.data().toString(), QString("4"));
+        QCOMPARE(model.parent(model.index(0, 0, index)), index);
+    }
+
     void shouldReactToTaskChange()
     {
         // GIVEN
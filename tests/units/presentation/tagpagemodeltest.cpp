@@ -34,6 +34,7 @@
 #include "presentation/tagpagemodel.h"
 
 #include "testlib/fakejob.h"
+#include "testlib/modelutils.h"
 
 using namespace mockitopp;
 using namespace mockitopp::matcher;
@@ -85,6 +86,7 @@ private slots:
 
         // WHEN
         QAbstractItemModel *model = page.centralListModel();
+        TestLib::ModelUtils::fetchAll(model);
 
         // THEN
         const QModelIndex rootTaskIndex = model->index(0, 0);
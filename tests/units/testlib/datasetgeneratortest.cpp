@@ -0,0 +1,222 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#include <QtTest>
+
+#include <KCalCore/Todo>
+#include <KMime/Message>
+
+#include "akonadi/akonadiserializerinterface.h"
+#include "testlib/datasetgenerator.h"
+
+using namespace TestLib;
+
+class DatasetGeneratorTest : public QObject
+{
+    Q_OBJECT
+private:
+    static int depthOf(const QString &uid, const QHash<QString, QString> &parents)
+    {
+        int depth = 0;
+        QString parent = parents.value(uid);
+        while (!parent.isEmpty()) {
+            depth++;
+            parent = parents.value(parent);
+        }
+        return depth;
+    }
+
+    static int depthOf(const Akonadi::Collection &collection, const Akonadi::Collection &root)
+    {
+        int depth = 0;
+        Akonadi::Collection parent = collection.parentCollection();
+        while (parent != root) {
+            depth++;
+            parent = parent.parentCollection();
+        }
+        return depth;
+    }
+
+private slots:
+    void shouldGenerateTheRequestedCounts()
+    {
+        // GIVEN
+        DatasetGenerator::Options options;
+        options.collectionCount = 4;
+        options.todoCount = 100;
+        options.noteCount = 30;
+        options.projectCount = 10;
+        options.contextCount = 3;
+        options.tagCount = 2;
+        options.otherUserCount = 2;
+
+        // WHEN
+        DatasetGenerator generator(options);
+
+        // THEN
+        // The root, four folders, "Other Users" and a task folder for each person
+        QCOMPARE(generator.collections().size(), 1 + 4 + 1 + 2 * 2);
+        QCOMPARE(generator.rootCollection().parentCollection(), Akonadi::Collection::root());
+
+        int todoCount = 0;
+        int projectCount = 0;
+        int noteCount = 0;
+        int itemsInCollections = 0;
+        foreach (const Akonadi::Item &item, generator.items()) {
+            if (item.hasPayload<KCalCore::Todo::Ptr>()) {
+                todoCount++;
+                if (!item.payload<KCalCore::Todo::Ptr>()->customProperty("Zanshin", "Project").isEmpty())
+                    projectCount++;
+            } else if (item.hasPayload<KMime::Message::Ptr>()) {
+                noteCount++;
+            }
+        }
+        foreach (const Akonadi::Collection &collection, generator.collections())
+            itemsInCollections += generator.items(collection).size();
+
+        QCOMPARE(generator.items().size(), 130);
+        QCOMPARE(itemsInCollections, 130);
+        QCOMPARE(todoCount, 100);
+        QCOMPARE(projectCount, 10);
+        QCOMPARE(noteCount, 30);
+        QCOMPARE(generator.tags().size(), 5);
+    }
+
+    void shouldMakeSubtaskChainsOfTheRequestedDepth()
+    {
+        // GIVEN
+        DatasetGenerator::Options options;
+        options.collectionCount = 1;
+        options.todoCount = 40;
+        options.noteCount = 0;
+        options.projectCount = 0;
+        options.subtaskDepth = 3;
+
+        // WHEN
+        DatasetGenerator generator(options);
+
+        // THEN
+        QHash<QString, QString> parents;
+        foreach (const Akonadi::Item &item, generator.items()) {
+            auto todo = item.payload<KCalCore::Todo::Ptr>();
+            parents.insert(todo->uid(), todo->relatedTo());
+        }
+
+        QCOMPARE(parents.size(), 40);
+        int maxDepth = 0;
+        foreach (const QString &uid, parents.keys()) {
+            const QString parent = parents.value(uid);
+            QVERIFY(parent.isEmpty() || parents.contains(parent));
+            maxDepth = qMax(maxDepth, depthOf(uid, parents));
+        }
+        QCOMPARE(maxDepth, 3);
+    }
+
+    void shouldNestFoldersUpToTheRequestedDepth()
+    {
+        // GIVEN
+        DatasetGenerator::Options options;
+        options.collectionCount = 7;
+        options.folderDepth = 3;
+        options.noteCount = 0;
+
+        // WHEN
+        DatasetGenerator generator(options);
+
+        // THEN
+        const auto root = generator.rootCollection();
+        int maxDepth = 0;
+        foreach (const Akonadi::Collection &collection, generator.collections()) {
+            if (collection == root)
+                continue;
+            maxDepth = qMax(maxDepth, depthOf(collection, root));
+        }
+        QCOMPARE(generator.collections().size(), 8);
+        QCOMPARE(maxDepth, 2);
+    }
+
+    void shouldTagItemsWithTheGeneratedContextsAndTags()
+    {
+        // GIVEN
+        DatasetGenerator::Options options;
+        options.contextCount = 3;
+        options.tagCount = 4;
+
+        // WHEN
+        DatasetGenerator generator(options);
+
+        // THEN
+        QSet<Akonadi::Tag::Id> contextIds;
+        QSet<Akonadi::Tag::Id> tagIds;
+        foreach (const Akonadi::Tag &tag, generator.tags()) {
+            if (tag.type() == Akonadi::SerializerInterface::contextTagType())
+                contextIds << tag.id();
+            else if (tag.type() == Akonadi::Tag::PLAIN)
+                tagIds << tag.id();
+        }
+        QCOMPARE(contextIds.size(), 3);
+        QCOMPARE(tagIds.size(), 4);
+
+        int taskContextCount = 0;
+        int taskTagCount = 0;
+        int noteTagCount = 0;
+        foreach (const Akonadi::Item &item, generator.items()) {
+            const bool isTask = item.hasPayload<KCalCore::Todo::Ptr>();
+            foreach (const Akonadi::Tag &tag, item.tags()) {
+                QVERIFY(contextIds.contains(tag.id()) || tagIds.contains(tag.id()));
+                if (contextIds.contains(tag.id())) {
+                    QVERIFY(isTask);
+                    taskContextCount++;
+                } else if (isTask) {
+                    taskTagCount++;
+                } else {
+                    noteTagCount++;
+                }
+            }
+        }
+        QVERIFY(taskContextCount > 0);
+        QVERIFY(taskTagCount > 0);
+        QVERIFY(noteTagCount > 0);
+    }
+
+    void shouldGiveTheSameDataForTheSameSeed()
+    {
+        // GIVEN
+        DatasetGenerator::Options options;
+        DatasetGenerator::Options otherOptions;
+        otherOptions.seed = options.seed + 1;
+
+        // WHEN
+        DatasetGenerator first(options);
+        DatasetGenerator second(options);
+        DatasetGenerator other(otherOptions);
+
+        // THEN
+        QCOMPARE(first.toKnutXml(), second.toKnutXml());
+        QVERIFY(first.toKnutXml() != other.toKnutXml());
+    }
+};
+
+QTEST_MAIN(DatasetGeneratorTest)
+
+#include "datasetgeneratortest.moc"
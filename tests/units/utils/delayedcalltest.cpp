@@ -0,0 +1,73 @@
+/* This file is part of Zanshin
+
+   Copyright 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#include <QtTest>
+
+#include "utils/delayedcall.h"
+
+using namespace Utils;
+
+class DelayedCallTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void shouldRunCallbacksOnNextEventLoopTurn()
+    {
+        // GIVEN
+        QList<int> calls;
+
+        // WHEN
+        DelayedCall::post([&calls] { calls << 1; });
+        DelayedCall::post([&calls] {
+            calls << 2;
+            DelayedCall::post([&calls] { calls << 3; });
+        });
+
+        // THEN
+        QVERIFY(calls.isEmpty());
+        QTest::qWait(10);
+        QCOMPARE(calls, QList<int>() << 1 << 2 << 3);
+    }
+
+    void shouldSkipCallbacksWhoseContextIsGone()
+    {
+        // GIVEN
+        QList<int> calls;
+        QObject kept;
+        auto destroyed = new QObject;
+
+        // WHEN
+        DelayedCall::post(&kept, [&calls] { calls << 1; });
+        DelayedCall::post(destroyed, [&calls] { calls << 2; });
+        DelayedCall::post([&calls] { calls << 3; });
+        delete destroyed;
+
+        // THEN
+        QTest::qWait(10);
+        QCOMPARE(calls, QList<int>() << 1 << 3);
+    }
+};
+
+QTEST_MAIN(DelayedCallTest)
+
+#include "delayedcalltest.moc"
@@ -107,6 +107,20 @@ private slots:
         QVERIFY(dynamic_cast<SecondImplementation*>(object2) != 0);
     }
 
+    void shouldShareUniqueInstances()
+    {
+        DependencyManager deps;
+        QVERIFY(!deps.contains<Interface>());
+
+        deps.add<Interface, FirstImplementation>(DependencyManager::UniqueInstance);
+        QVERIFY(deps.contains<Interface>());
+
+        Interface *object1 = deps.create<Interface>();
+        Interface *object2 = deps.create<Interface>();
+        QVERIFY(dynamic_cast<FirstImplementation*>(object1) != 0);
+        QCOMPARE(object1, object2);
+    }
+
     void shouldCleanupProviders()
     {
         QCOMPARE(Internal::Supplier<Interface>::providersCount(), 0);
@@ -63,6 +63,210 @@ private slots:
         QCOMPARE(callCount, 2);
         //QCOMPARE(seenJobs.toSet(), QSet<KJob*>() << job1 << job2);
     }
+
+    void shouldRunHandlersInTheScopeTheJobWasInstalledFrom()
+    {
+        // GIVEN
+        QObject owner;
+        QObject *seenOwner = 0;
+        JobHandler::Priority seenPriority = JobHandler::VisiblePriority;
+
+        FakeJob *job = new FakeJob(this);
+        {
+            JobHandler::Scope scope(&owner, JobHandler::PrefetchPriority);
+            QCOMPARE(JobHandler::currentOwner(), &owner);
+            QCOMPARE(JobHandler::currentPriority(), JobHandler::PrefetchPriority);
+
+            JobHandler::install(job, [&] {
+                seenOwner = JobHandler::currentOwner();
+                seenPriority = JobHandler::currentPriority();
+            });
+        }
+
+        // THEN
+        QVERIFY(!JobHandler::currentOwner());
+        QCOMPARE(JobHandler::currentPriority(), JobHandler::VisiblePriority);
+
+        // WHEN
+        QTest::qWait(FakeJob::DURATION + 10);
+
+        // THEN
+        QCOMPARE(seenOwner, &owner);
+        QCOMPARE(seenPriority, JobHandler::PrefetchPriority);
+        QVERIFY(!JobHandler::currentOwner());
+        QCOMPARE(JobHandler::currentPriority(), JobHandler::VisiblePriority);
+    }
+
+    void shouldCancelTheJobsOfAnOwner()
+    {
+        // GIVEN
+        QObject owner1, owner2;
+        QList<int> errors1, errors2;
+
+        for (int i = 0; i < 2; i++) {
+            JobHandler::Scope scope(&owner1, JobHandler::VisiblePriority);
+            FakeJob *job = new FakeJob(this);
+            JobHandler::install(job, [&errors1, job] { errors1 << job->error(); });
+        }
+
+        {
+            JobHandler::Scope scope(&owner2, JobHandler::VisiblePriority);
+            FakeJob *job = new FakeJob(this);
+            JobHandler::install(job, [&errors2, job] { errors2 << job->error(); });
+        }
+
+        // WHEN
+        JobHandler::cancelJobs(&owner1);
+
+        // THEN
+        QCOMPARE(errors1, QList<int>() << int(KJob::KilledJobError) << int(KJob::KilledJobError));
+        QVERIFY(errors2.isEmpty());
+
+        // WHEN
+        QTest::qWait(FakeJob::DURATION + 10);
+
+        // THEN
+        QCOMPARE(errors1.size(), 2);
+        QCOMPARE(errors2, QList<int>() << int(KJob::NoError));
+    }
+
+    void shouldCancelSharedJobsOnlyOnceNoHolderIsLeft()
+    {
+        // GIVEN
+        QObject owner1, owner2, shared;
+        QList<int> errors;
+
+        {
+            JobHandler::Scope scope(&owner1, JobHandler::VisiblePriority);
+            JobHandler::hold(&shared);
+        }
+
+        {
+            JobHandler::Scope scope(&owner2, JobHandler::VisiblePriority);
+            JobHandler::hold(&shared);
+        }
+
+        {
+            JobHandler::Scope scope(&shared, JobHandler::VisiblePriority);
+            FakeJob *job = new FakeJob(this);
+            JobHandler::install(job, [&errors, job] { errors << job->error(); });
+        }
+
+        // WHEN
+        JobHandler::cancelJobs(&owner1);
+
+        // THEN
+        QVERIFY(errors.isEmpty());
+
+        // WHEN
+        JobHandler::cancelJobs(&owner2);
+
+        // THEN
+        QCOMPARE(errors, QList<int>() << int(KJob::KilledJobError));
+    }
+
+    void shouldNotCancelSharedJobsHeldOutsideOfAnyScope()
+    {
+        // GIVEN
+        QObject owner, shared;
+        QList<int> errors;
+
+        {
+            JobHandler::Scope scope(&owner, JobHandler::VisiblePriority);
+            JobHandler::hold(&shared);
+        }
+        JobHandler::hold(&shared);
+
+        {
+            JobHandler::Scope scope(&shared, JobHandler::VisiblePriority);
+            FakeJob *job = new FakeJob(this);
+            JobHandler::install(job, [&errors, job] { errors << job->error(); });
+        }
+
+        // WHEN
+        JobHandler::cancelJobs(&owner);
+        QTest::qWait(FakeJob::DURATION + 10);
+
+        // THEN
+        QCOMPARE(errors, QList<int>() << int(KJob::NoError));
+    }
+
+    void shouldRecordStatsPerJobType()
+    {
+        // GIVEN
+        JobHandler::resetStats();
+
+        FakeJob *job1 = new FakeJob(this);
+        JobHandler::install(job1, [] {});
+        FakeJob *job2 = new FakeJob(this);
+        JobHandler::install(job2, [] {});
+        FakeJob *job3 = new FakeJob(this);
+        JobHandler::install(job3, [] {});
+
+        // WHEN
+        job3->kill(KJob::EmitResult);
+        QTest::qWait(FakeJob::DURATION + 10);
+
+        // THEN
+        const auto stats = JobHandler::stats();
+        QCOMPARE(stats.size(), 1);
+        QCOMPARE(stats.first().type, QString("FakeJob"));
+        QCOMPARE(stats.first().count, 3);
+        QCOMPARE(stats.first().errors, 1);
+        QCOMPARE(stats.first().items, qint64(0));
+        QCOMPARE(stats.first().queuedTime, qint64(0));
+        QVERIFY(stats.first().maximumRunTime >= FakeJob::DURATION / 2);
+        QVERIFY(stats.first().runTime >= stats.first().maximumRunTime);
+
+        // WHEN
+        JobHandler::resetStats();
+
+        // THEN
+        QVERIFY(JobHandler::stats().isEmpty());
+    }
+
+    void shouldSeparateQueuedTimeFromRunTime()
+    {
+        // GIVEN
+        JobHandler::resetStats();
+        FakeJob *job = new FakeJob(this);
+        JobHandler::track(job);
+
+        // WHEN
+        QTest::qWait(FakeJob::DURATION);
+        JobHandler::notifyStarted(job);
+        job->start();
+        QTest::qWait(FakeJob::DURATION + 10);
+
+        // THEN
+        const auto stats = JobHandler::stats();
+        QCOMPARE(stats.size(), 1);
+        QVERIFY(stats.first().queuedTime >= FakeJob::DURATION / 2);
+        QVERIFY(stats.first().runTime >= FakeJob::DURATION / 2);
+    }
+
+    void shouldDumpStatsToAFile()
+    {
+        // GIVEN
+        JobHandler::resetStats();
+        FakeJob *job = new FakeJob(this);
+        JobHandler::install(job, [] {});
+        QTest::qWait(FakeJob::DURATION + 10);
+
+        const QString fileName = QDir::temp().filePath("zanshin-jobhandlertest-stats");
+
+        // WHEN
+        QVERIFY(JobHandler::dumpStats(fileName));
+
+        // THEN
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+        const auto lines = QString::fromUtf8(file.readAll()).split('\n', QString::SkipEmptyParts);
+        QCOMPARE(lines.size(), 2);
+        QVERIFY(lines.first().startsWith("type\tcount\terrors\titems"));
+        QVERIFY(lines.last().startsWith("FakeJob\t1\t0\t0\t"));
+        file.remove();
+    }
 };
 
 QTEST_MAIN(JobHandlerTest)